@@ -0,0 +1,36 @@
+#include "ImageFrame.h"
+
+namespace ImageFrame {
+
+QImage normalised(const QImage &frame)
+{
+    if (frame.isNull() || frame.format() == FORMAT) {
+        return frame;
+    }
+    QImage converted = frame.convertToFormat(FORMAT);
+    converted.setDevicePixelRatio(frame.devicePixelRatio());
+    return converted;
+}
+
+QImage view(const QImage &parent, const QRect &rect)
+{
+    const QRect area = rect.intersected(parent.rect());
+    if (parent.isNull() || area.isEmpty()) {
+        return QImage();
+    }
+    if (parent.depth() < 8) {
+        // Sub-byte pixels can't start a row at an arbitrary x
+        return parent.copy(area);
+    }
+
+    const uchar *first = parent.constScanLine(area.y()) + area.x() * (parent.depth() / 8);
+    // A shallow copy of the parent owns the shared pixels until the view goes away
+    QImage *owner = new QImage(parent);
+    QImage view(first, area.width(), area.height(), parent.bytesPerLine(), parent.format(),
+                [](void *info) { delete static_cast<QImage *>(info); }, owner);
+    view.setColorTable(parent.colorTable());
+    view.setDevicePixelRatio(parent.devicePixelRatio());
+    return view;
+}
+
+} // namespace ImageFrame
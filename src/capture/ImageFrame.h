@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QImage>
+#include <QRect>
+
+/**
+ * Frames as they travel from capture to recognition
+ * Every capture path hands out a QImage in one pixel format (RGB32, device
+ * pixels, devicePixelRatio set), so nothing downstream has to guess or convert
+ * per step. Parts of a frame are views that share the parent's pixels instead
+ * of copies; QPixmap is only made where something is painted on screen.
+ */
+namespace ImageFrame {
+
+// The format every captured frame is in
+constexpr QImage::Format FORMAT = QImage::Format_RGB32;
+
+// frame in FORMAT, devicePixelRatio kept; shares frame when it already is
+QImage normalised(const QImage &frame);
+
+// Read-only view of rect (device pixels) in parent: same pixels and bytesPerLine, no copy.
+// The view keeps the parent's pixels alive; writing to it detaches as usual
+QImage view(const QImage &parent, const QRect &rect);
+
+} // namespace ImageFrame
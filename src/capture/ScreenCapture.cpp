@@ -1,6 +1,11 @@
 #include "ScreenCapture.h"
+#include "ImageFrame.h"
+#include "X11ShmCapture.h"
+#include "WaylandScreenCast.h"
 #include <QGuiApplication>
+#include <QPixmap>
 #include <QScreen>
+#include <QCursor>
 #include <QDBusConnection>
 #include <QDBusMessage>
 #include <QDBusPendingCall>
@@ -13,6 +18,33 @@
 #include <QTimer>
 #include <iostream>
 
+#ifdef Q_OS_WIN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#ifndef WDA_EXCLUDEFROMCAPTURE
+#define WDA_EXCLUDEFROMCAPTURE 0x00000011
+#endif
+#endif
+
+#ifdef Q_OS_LINUX
+namespace {
+
+// DPR from pixels per logical unit, so the frame's logical size is the screen's
+QImage withInferredDpr(QImage frame, const QSize &screenLogical)
+{
+    if (!frame.isNull() && screenLogical.width() > 0 && screenLogical.height() > 0) {
+        const qreal dprW = static_cast<qreal>(frame.width()) / screenLogical.width();
+        const qreal dprH = static_cast<qreal>(frame.height()) / screenLogical.height();
+        frame.setDevicePixelRatio(qMax<qreal>(1.0, (dprW + dprH) / 2.0));
+    }
+    return frame;
+}
+
+} // namespace
+#endif
+
 ScreenCapture::ScreenCapture(QObject *parent)
     : QObject(parent)
     , m_eventLoop(nullptr)
@@ -25,33 +57,187 @@ ScreenCapture::~ScreenCapture()
         m_eventLoop->quit();
     }
     delete m_eventLoop;
+    delete m_window;
+}
+
+QImage ScreenCapture::captureScreen()
+{
+    return captureScreen(screenUnderCursor());
 }
 
-QPixmap ScreenCapture::captureScreen()
+QScreen *ScreenCapture::screenUnderCursor()
 {
-    qDebug() << "ScreenCapture: Starting screen capture";
+    QScreen *screen = QGuiApplication::screenAt(QCursor::pos());
+    return screen ? screen : QGuiApplication::primaryScreen();
+}
+
+QImage ScreenCapture::captureScreen(QScreen *screen)
+{
+    if (!screen) {
+        qWarning() << "ScreenCapture: No screen to capture";
+        return QImage();
+    }
+
+    qDebug() << "ScreenCapture: Starting screen capture of" << screen->name() << screen->geometry();
 
 #ifdef Q_OS_LINUX
-    return captureLinux();
+    return ImageFrame::normalised(captureLinux(screen));
 #elif defined(Q_OS_WIN)
-    return captureWindows();
+    return ImageFrame::normalised(captureWindows(screen));
 #elif defined(Q_OS_MAC)
-    return captureMacOS();
+    return ImageFrame::normalised(captureMacOS(screen));
 #else
     qWarning() << "ScreenCapture: Unsupported platform";
-    return QPixmap();
+    return QImage();
 #endif
 }
 
+std::function<QImage()> ScreenCapture::backgroundGrab(QScreen *screen)
+{
+    if (!screen) {
+        return {};
+    }
+
 #ifdef Q_OS_LINUX
-QPixmap ScreenCapture::captureLinux()
+    // WaylandScreenCast is GUI-thread only; its frames are a cheap copy out of the stream anyway
+    if (QGuiApplication::platformName().contains("wayland", Qt::CaseInsensitive)) {
+        return {};
+    }
+
+    const QRect geometry = screen->geometry();
+
+    // Same rule as captureX11: the root-window origin of a scaled screen isn't known
+    const qreal dpr = screen->devicePixelRatio();
+    if (!qFuzzyCompare(dpr, 1.0) && QGuiApplication::screens().size() > 1) {
+        return {};
+    }
+    const QRect native(QPoint(qRound(geometry.x() * dpr), qRound(geometry.y() * dpr)),
+                       QSize(qRound(geometry.width() * dpr), qRound(geometry.height() * dpr)));
+    return [geometry, native]() {
+        X11ShmCapture &shm = X11ShmCapture::background();
+        const QImage frame = shm.grab(native);
+        // The frame aliases the segment; keep a copy and don't hold a desktop-sized segment between sessions
+        const QImage screenshot = frame.copy();
+        shm.releaseMemory();
+        return ImageFrame::normalised(withInferredDpr(screenshot, geometry.size()));
+    };
+#else
+    // grabWindow belongs to the GUI thread
+    return {};
+#endif
+}
+
+QImage ScreenCapture::captureRegion(QScreen *screen, const QRect &rect)
+{
+    if (!screen || rect.isEmpty()) {
+        return QImage();
+    }
+
+#ifdef Q_OS_LINUX
+    static const bool wayland = isWayland();
+    if (wayland) {
+        // Only the ScreenCast stream is cheap enough to poll; the Screenshot portal would flash every frame
+        WaylandScreenCast &screenCast = WaylandScreenCast::instance();
+        if (!screenCast.isEnabled() || !screenCast.ensureStarted()) {
+            return QImage();
+        }
+        return ImageFrame::normalised(screenCast.latestFrame(screen, 0, rect));
+    }
+
+    X11ShmCapture &shm = X11ShmCapture::instance();
+    const qreal dpr = screen->devicePixelRatio();
+    const bool nativeOriginKnown = qFuzzyCompare(dpr, 1.0) || QGuiApplication::screens().size() == 1;
+    if (nativeOriginKnown && shm.isAvailable()) {
+        const QRect logical = rect.translated(screen->geometry().topLeft());
+        const QRect native(QPoint(qRound(logical.x() * dpr), qRound(logical.y() * dpr)),
+                           QSize(qRound(logical.width() * dpr), qRound(logical.height() * dpr)));
+        const QImage frame = shm.grab(native);
+        if (!frame.isNull()) {
+            return frame;
+        }
+    }
+#endif
+
+    return ImageFrame::normalised(screen->grabWindow(0, rect.x(), rect.y(), rect.width(), rect.height()).toImage());
+}
+
+QList<WindowCapture::Info> ScreenCapture::windows()
+{
+    // XWayland would only list X clients, and none of them could be read back through the compositor
+    if (QGuiApplication::platformName().contains("wayland", Qt::CaseInsensitive)) {
+        return QList<WindowCapture::Info>();
+    }
+
+    QList<WindowCapture::Info> windows = WindowCapture::list();
+    for (WindowCapture::Info &info : windows) {
+        info.geometry = toLogical(info.geometry);
+    }
+    return windows;
+}
+
+bool ScreenCapture::selectWindow(quintptr window)
+{
+    delete m_window;
+    m_window = new WindowCapture(window);
+    if (!m_window->isValid()) {
+        qWarning() << "ScreenCapture: Window" << window << "can't be captured";
+        delete m_window;
+        m_window = nullptr;
+        return false;
+    }
+    return true;
+}
+
+QImage ScreenCapture::captureWindow()
+{
+    return m_window ? ImageFrame::normalised(m_window->grab()) : QImage();
+}
+
+QRect ScreenCapture::selectedWindowGeometry() const
+{
+    return m_window ? toLogical(m_window->geometry()) : QRect();
+}
+
+QRect ScreenCapture::toLogical(const QRect &native)
+{
+    if (native.isEmpty()) {
+        return QRect();
+    }
+
+    // Qt keeps each screen's origin in native pixels and only scales its extent
+    for (QScreen *screen : QGuiApplication::screens()) {
+        const QRect logical = screen->geometry();
+        const qreal dpr = screen->devicePixelRatio();
+        const QRect screenNative(logical.topLeft(), logical.size() * dpr);
+        if (screenNative.contains(native.center())) {
+            const QPoint offset = native.topLeft() - logical.topLeft();
+            return QRect(logical.topLeft() + QPoint(qRound(offset.x() / dpr), qRound(offset.y() / dpr)),
+                         QSize(qRound(native.width() / dpr), qRound(native.height() / dpr)));
+        }
+    }
+    return native;
+}
+
+bool ScreenCapture::excludeFromCapture(WId window)
+{
+#ifdef Q_OS_WIN
+    // Older Windows rejects the flag; the caller then has to hide the window before capturing
+    return SetWindowDisplayAffinity(reinterpret_cast<HWND>(window), WDA_EXCLUDEFROMCAPTURE);
+#else
+    Q_UNUSED(window)
+    return false;
+#endif
+}
+
+#ifdef Q_OS_LINUX
+QImage ScreenCapture::captureLinux(QScreen *screen)
 {
     if (isWayland()) {
         qDebug() << "ScreenCapture: Detected Wayland, using portal";
-        return captureWayland();
+        return captureWayland(screen);
     } else {
         qDebug() << "ScreenCapture: Detected X11, using native Qt";
-        return captureX11();
+        return captureX11(screen);
     }
 }
 
@@ -63,16 +249,28 @@ bool ScreenCapture::isWayland() const
     return platformName.contains("wayland", Qt::CaseInsensitive);
 }
 
-QPixmap ScreenCapture::captureX11()
+QImage ScreenCapture::captureX11(QScreen *screen)
 {
-    // X11 can use Qt's native screen grabbing
-    QScreen *screen = QGuiApplication::primaryScreen();
-    if (!screen) {
-        qWarning() << "ScreenCapture: No primary screen found";
-        return QPixmap();
+    // MIT-SHM straight into a persistent segment; grabWindow round-trips through XGetImage
+    QImage screenshot;
+    X11ShmCapture& shm = X11ShmCapture::instance();
+    const qreal dpr = screen->devicePixelRatio();
+    // Root-window origin of a scaled screen isn't public in Qt; only trust logical*dpr when it's exact
+    const bool nativeOriginKnown = qFuzzyCompare(dpr, 1.0) || QGuiApplication::screens().size() == 1;
+    if (nativeOriginKnown && shm.isAvailable()) {
+        const QRect logical = screen->geometry();
+        const QRect native(QPoint(qRound(logical.x() * dpr), qRound(logical.y() * dpr)),
+                           QSize(qRound(logical.width() * dpr), qRound(logical.height() * dpr)));
+        const QImage frame = shm.grab(native);
+        if (!frame.isNull()) {
+            // The frame aliases the shared segment; this is the one copy we keep
+            screenshot = frame.copy();
+        }
+    }
+    if (screenshot.isNull()) {
+        // X11 can use Qt's native screen grabbing
+        screenshot = screen->grabWindow(0).toImage();
     }
-
-    QPixmap screenshot = screen->grabWindow(0);
     // Infer DPR so logical size matches screen logical size
     {
         const QSize screenLogical = screen->geometry().size();
@@ -93,17 +291,56 @@ QPixmap ScreenCapture::captureX11()
     return screenshot;
 }
 
-QPixmap ScreenCapture::captureWayland()
+QImage ScreenCapture::captureWayland(QScreen *screen)
 {
-    qDebug() << "ScreenCapture: Using xdg-desktop-portal for Wayland";
+    // Persistent ScreenCast stream: the picker appears once, after that frames come straight from memory
+    WaylandScreenCast &screenCast = WaylandScreenCast::instance();
+    if (screenCast.isEnabled() && screenCast.ensureStarted()) {
+        const QImage frame = screenCast.latestFrame(screen);
+        if (!frame.isNull()) {
+            QImage screenshot = frame;
+            const QSize screenLogical = screen->geometry().size();
+            if (screenLogical.width() > 0 && screenLogical.height() > 0) {
+                const qreal inferredDprW = static_cast<qreal>(frame.width()) / static_cast<qreal>(screenLogical.width());
+                const qreal inferredDprH = static_cast<qreal>(frame.height()) / static_cast<qreal>(screenLogical.height());
+                screenshot.setDevicePixelRatio(qMax<qreal>(1.0, (inferredDprW + inferredDprH) / 2.0));
+            }
+            qDebug() << "ScreenCapture: ScreenCast frame for" << screen->name() << frame.size();
+            return screenshot;
+        }
+        qDebug() << "ScreenCapture: ScreenCast had no frame, falling back to Screenshot portal";
+    }
 
-    // Use xdg-desktop-portal for Wayland
-    if (!callScreenshotPortal()) {
-        qWarning() << "ScreenCapture: Portal call failed:" << m_errorMessage;
-        return QPixmap();
+    // The portal only hands out the whole desktop; fetch it once and crop each screen from it
+    if (m_desktop.isNull()) {
+        qDebug() << "ScreenCapture: Using xdg-desktop-portal for Wayland";
+
+        // Use xdg-desktop-portal for Wayland
+        if (!callScreenshotPortal()) {
+            qWarning() << "ScreenCapture: Portal call failed:" << m_errorMessage;
+            return QImage();
+        }
+        // Held once: every screen's frame is a view into it, and it goes with this session
+        m_desktop = std::move(m_screenshot);
+    }
+
+    // Portal image spans the virtual desktop; its pixel/logical ratio is the DPR
+    const QRect virtualGeometry = screen->virtualGeometry();
+    const QSize desktopPhysical = m_desktop.size();   // QImage::size() is already in device pixels
+    if (virtualGeometry.isEmpty() || desktopPhysical.isEmpty()) {
+        return m_desktop;
     }
+    const qreal scaleW = static_cast<qreal>(desktopPhysical.width()) / virtualGeometry.width();
+    const qreal scaleH = static_cast<qreal>(desktopPhysical.height()) / virtualGeometry.height();
 
-    return m_screenshot;
+    const QRect logical = screen->geometry().translated(-virtualGeometry.topLeft());
+    const QRect physical(qRound(logical.x() * scaleW), qRound(logical.y() * scaleH),
+                         qRound(logical.width() * scaleW), qRound(logical.height() * scaleH));
+
+    QImage cropped = ImageFrame::view(m_desktop, physical);
+    cropped.setDevicePixelRatio(qMax<qreal>(1.0, (scaleW + scaleH) / 2.0));
+    qDebug() << "ScreenCapture: Cropped" << screen->name() << "from portal image:" << physical;
+    return cropped;
 }
 
 bool ScreenCapture::callScreenshotPortal()
@@ -146,7 +383,7 @@ bool ScreenCapture::callScreenshotPortal()
 
     // Create event loop to wait for response
     m_eventLoop = new QEventLoop(this);
-    m_screenshot = QPixmap();
+    m_screenshot = QImage();
     m_errorMessage.clear();
 
     // Set timeout
@@ -200,7 +437,7 @@ void ScreenCapture::handlePortalResponse(uint response, const QMap<QString,QVari
     }
 }
 
-QPixmap ScreenCapture::loadScreenshotFromUri(const QString &uri)
+QImage ScreenCapture::loadScreenshotFromUri(const QString &uri)
 {
     QUrl url(uri);
     QString path = url.toLocalFile();
@@ -211,9 +448,11 @@ QPixmap ScreenCapture::loadScreenshotFromUri(const QString &uri)
 
     qDebug() << "ScreenCapture: Loading screenshot from:" << path;
 
-    QPixmap pixmap;
+    QImage pixmap;
     if (pixmap.load(path)) {
         qDebug() << "ScreenCapture: Successfully loaded screenshot, size:" << pixmap.size();
+        // Converted in place, so the decoded PNG is the only copy of the desktop
+        pixmap.convertTo(ImageFrame::FORMAT);
 
         // Preserve native pixels and infer DPR from image physical size vs screen logical geometry
         QScreen *screen = QGuiApplication::primaryScreen();
@@ -242,16 +481,10 @@ QPixmap ScreenCapture::loadScreenshotFromUri(const QString &uri)
 #endif // Q_OS_LINUX
 
 #ifdef Q_OS_WIN
-QPixmap ScreenCapture::captureWindows()
+QImage ScreenCapture::captureWindows(QScreen *screen)
 {
     // Windows implementation - uses native Qt which works on Windows
-    QScreen *screen = QGuiApplication::primaryScreen();
-    if (!screen) {
-        qWarning() << "ScreenCapture: No primary screen found";
-        return QPixmap();
-    }
-
-    QPixmap screenshot = screen->grabWindow(0);
+    QImage screenshot = screen->grabWindow(0).toImage();
     {
         const QSize screenLogical = screen->geometry().size();
         const QSize imgPhysical = screenshot.size();
@@ -269,22 +502,16 @@ QPixmap ScreenCapture::captureWindows()
 #endif // Q_OS_WIN
 
 #ifdef Q_OS_MAC
-QPixmap ScreenCapture::captureMacOS()
+QImage ScreenCapture::captureMacOS(QScreen *screen)
 {
     // macOS implementation - uses native Qt (may need permissions)
-    QScreen *screen = QGuiApplication::primaryScreen();
-    if (!screen) {
-        qWarning() << "ScreenCapture: No primary screen found";
-        return QPixmap();
-    }
-
     qDebug() << "=== macOS Screenshot Capture ===";
     qDebug() << "Screen name:" << screen->name();
     qDebug() << "Screen geometry:" << screen->geometry();
     qDebug() << "Screen logical size:" << screen->geometry().size();
     qDebug() << "Screen device pixel ratio:" << screen->devicePixelRatio();
 
-    QPixmap screenshot = screen->grabWindow(0);
+    QImage screenshot = screen->grabWindow(0).toImage();
     
     qDebug() << "Grabbed screenshot size:" << screenshot.size();
     qDebug() << "Grabbed screenshot isNull:" << screenshot.isNull();
@@ -333,15 +560,16 @@ QPixmap ScreenCapture::captureMacOS()
 #endif // Q_OS_MAC
 
 // Image preprocessing methods for better OCR accuracy
-QPixmap ScreenCapture::preprocessForOCR(const QPixmap &originalPixmap)
+QImage ScreenCapture::preprocessForOCR(const QImage &original)
 {
-    if (originalPixmap.isNull()) {
-        return originalPixmap;
+    if (original.isNull()) {
+        return original;
     }
 
-    qDebug() << "ScreenCapture: Starting OCR preprocessing for image size:" << originalPixmap.size();
+    qDebug() << "ScreenCapture: Starting OCR preprocessing for image size:" << original.size();
 
-    QPixmap processed = originalPixmap;
+    // Both steps work on the frame format directly; nothing round-trips through a pixmap
+    QImage processed = ImageFrame::normalised(original);
 
     // Step 1: Enhance contrast for better text visibility
     processed = enhanceContrast(processed);
@@ -353,21 +581,13 @@ QPixmap ScreenCapture::preprocessForOCR(const QPixmap &originalPixmap)
     return processed;
 }
 
-QPixmap ScreenCapture::enhanceContrast(const QPixmap &pixmap)
+QImage ScreenCapture::enhanceContrast(const QImage &frame)
 {
-    if (pixmap.isNull()) {
-        return pixmap;
+    if (frame.isNull()) {
+        return frame;
     }
 
-    QImage image = pixmap.toImage();
-    if (image.isNull()) {
-        return pixmap;
-    }
-
-    // Convert to RGB32 if needed for better processing
-    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32) {
-        image = image.convertToFormat(QImage::Format_RGB32);
-    }
+    QImage image = ImageFrame::normalised(frame);
 
     qDebug() << "ScreenCapture: Enhancing contrast for OCR";
 
@@ -393,24 +613,16 @@ QPixmap ScreenCapture::enhanceContrast(const QPixmap &pixmap)
         }
     }
 
-    return QPixmap::fromImage(image);
+    return image;
 }
 
-QPixmap ScreenCapture::sharpenImage(const QPixmap &pixmap)
+QImage ScreenCapture::sharpenImage(const QImage &frame)
 {
-    if (pixmap.isNull()) {
-        return pixmap;
-    }
-
-    QImage image = pixmap.toImage();
-    if (image.isNull()) {
-        return pixmap;
+    if (frame.isNull()) {
+        return frame;
     }
 
-    // Convert to RGB32 for processing
-    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32) {
-        image = image.convertToFormat(QImage::Format_RGB32);
-    }
+    const QImage image = ImageFrame::normalised(frame);
 
     qDebug() << "ScreenCapture: Applying sharpening filter for better text edges";
 
@@ -422,7 +634,7 @@ QPixmap ScreenCapture::sharpenImage(const QPixmap &pixmap)
         {-0.1, -0.2, -0.1}
     };
 
-    QImage result = image;
+    QImage result = image.copy();
 
     // Apply sharpening filter
     for (int y = 1; y < image.height() - 1; ++y) {
@@ -450,7 +662,7 @@ QPixmap ScreenCapture::sharpenImage(const QPixmap &pixmap)
         }
     }
 
-    return QPixmap::fromImage(result);
+    return result;
 }
 
 // Resolution detection and handling methods
@@ -523,19 +735,19 @@ ScreenCapture::ScreenInfo ScreenCapture::detectScreenResolution()
     return info;
 }
 
-QPixmap ScreenCapture::ensureHighestQuality(const QPixmap &pixmap, const ScreenInfo &screenInfo)
+QImage ScreenCapture::ensureHighestQuality(const QImage &frame, const ScreenInfo &screenInfo)
 {
-    if (pixmap.isNull()) {
-        qWarning() << "ScreenCapture: Cannot process null pixmap";
-        return pixmap;
+    if (frame.isNull()) {
+        qWarning() << "ScreenCapture: Cannot process null frame";
+        return frame;
     }
 
-    QSize pixmapSize = pixmap.size();
-    std::cout << "*** Using native captured resolution: " << pixmapSize.width() << "x" << pixmapSize.height() << std::endl;
+    QSize frameSize = frame.size();
+    std::cout << "*** Using native captured resolution: " << frameSize.width() << "x" << frameSize.height() << std::endl;
 
     // NO SCALING - just use whatever resolution we captured at
     // This ensures we work in native coordinates throughout
-    QPixmap result = pixmap;
+    QImage result = frame;
 
     // Reset device pixel ratio to 1.0 since we're working in native pixels
     result.setDevicePixelRatio(1.0);
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <QObject>
-#include <QPixmap>
+#include <QImage>
 #include <QDBusInterface>
 #include <QDBusReply>
 #include <QEventLoop>
 #include <QMap>
 #include <QVariant>
+#include "WindowCapture.h"
+#include <functional>
+
+class QScreen;
 
 class ScreenCapture : public QObject
 {
@@ -17,10 +21,43 @@ public:
     ~ScreenCapture();
 
     // Main capture method - automatically selects best method for platform
-    QPixmap captureScreen();
+    // Grabs the screen under the cursor; other screens are captured on demand.
+    // The frame is in ImageFrame::FORMAT, device pixels, with its devicePixelRatio set
+    QImage captureScreen();
+    QImage captureScreen(QScreen *screen);
+
+    // Grab of screen that may run on a worker thread (X11 MIT-SHM); empty where only the GUI thread
+    // can grab (Wayland, Windows, macOS). Build it on the GUI thread; the job touches no QScreen
+    static std::function<QImage()> backgroundGrab(QScreen *screen);
+
+    // Part of a screen, for repeated polling (live translation). rect is screen-local and logical;
+    // the image is in ImageFrame::FORMAT and device pixels, and may alias a capture buffer until the next call
+    QImage captureRegion(QScreen *screen, const QRect &rect);
+
+    // Screen containing the mouse cursor (primary screen as a fallback)
+    static QScreen *screenUnderCursor();
+
+    // Top-level windows that can be captured on their own; empty on Wayland and macOS
+    static QList<WindowCapture::Info> windows();
+
+    // Picks the window captureWindow() reads from; false if it can't be captured
+    bool selectWindow(quintptr window);
+
+    // Only the selected window's buffer, correct even while it is covered. Device pixels;
+    // may alias a capture buffer until the next call
+    QImage captureWindow();
+
+    // Selected window in logical desktop coordinates; empty once it is gone
+    QRect selectedWindowGeometry() const;
+
+    // Native (device pixel) desktop rect to Qt's logical coordinates, via the screen it is on
+    static QRect toLogical(const QRect &native);
+
+    // Leaves one of our windows out of every screen capture (Windows 10 2004+); false where unsupported
+    static bool excludeFromCapture(WId window);
 
 signals:
-    void captureCompleted(const QPixmap &screenshot);
+    void captureCompleted(const QImage &screenshot);
     void captureFailed(const QString &error);
 
 #ifdef Q_OS_LINUX
@@ -31,28 +68,28 @@ private slots:
 private:
     // Platform-specific implementations
 #ifdef Q_OS_LINUX
-    QPixmap captureLinux();
-    QPixmap captureWayland();
-    QPixmap captureX11();
+    QImage captureLinux(QScreen *screen);
+    QImage captureWayland(QScreen *screen);
+    QImage captureX11(QScreen *screen);
     bool isWayland() const;
 #endif
 
 #ifdef Q_OS_WIN
-    QPixmap captureWindows();
+    QImage captureWindows(QScreen *screen);
 #endif
 
 #ifdef Q_OS_MAC
-    QPixmap captureMacOS();
+    QImage captureMacOS(QScreen *screen);
 #endif
 
     // DBus portal helpers for Wayland
     bool callScreenshotPortal();
-    QPixmap loadScreenshotFromUri(const QString &uri);
+    QImage loadScreenshotFromUri(const QString &uri);
 
     // Image preprocessing for OCR optimization
-    QPixmap preprocessForOCR(const QPixmap &originalPixmap);
-    QPixmap enhanceContrast(const QPixmap &pixmap);
-    QPixmap sharpenImage(const QPixmap &pixmap);
+    QImage preprocessForOCR(const QImage &original);
+    QImage enhanceContrast(const QImage &frame);
+    QImage sharpenImage(const QImage &frame);
 
     // Resolution detection and handling
     struct ScreenInfo {
@@ -62,9 +99,11 @@ private:
         QSize nativeSize;       // Physical pixels (physicalSize * devicePixelRatio)
     };
     ScreenInfo detectScreenResolution();
-    QPixmap ensureHighestQuality(const QPixmap &pixmap, const ScreenInfo &screenInfo);
+    QImage ensureHighestQuality(const QImage &frame, const ScreenInfo &screenInfo);
 
     QEventLoop *m_eventLoop;
-    QPixmap m_screenshot;
+    QImage m_screenshot;
+    QImage m_desktop;      // Whole virtual desktop from the portal, cropped per screen
+    WindowCapture *m_window = nullptr;
     QString m_errorMessage;
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "TileHash.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TILEHASH_HAVE_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define TILEHASH_HAVE_NEON 1
+#endif
+
+namespace TileHash {
+
+namespace {
+
+alignas(16) constexpr quint32 SEED[4] = { 0x27d4eb2fu, 0xc2b2ae35u, 0x85ebca6bu, 0x9e3779b9u };
+constexpr quint64 FNV_OFFSET = 0xcbf29ce484222325ull;
+constexpr quint64 FNV_PRIME = 0x100000001b3ull;
+
+// Four 32-bit lanes of h = h * 33 ^ word. Each step is a bijection of the lane,
+// so changing any single 16-byte chunk is guaranteed to change the result.
+// Bytes that don't fill a whole chunk (odd tile widths) go through FNV-1a.
+struct Accumulator {
+#if defined(TILEHASH_HAVE_SSE2)
+    __m128i lanes = _mm_load_si128(reinterpret_cast<const __m128i*>(SEED));
+#elif defined(TILEHASH_HAVE_NEON)
+    uint32x4_t lanes = vld1q_u32(SEED);
+#else
+    quint32 lanes[4] = { SEED[0], SEED[1], SEED[2], SEED[3] };
+#endif
+    quint64 tail = FNV_OFFSET;
+
+    void feed(const uchar* data, int bytes)
+    {
+        int i = 0;
+#if defined(TILEHASH_HAVE_SSE2)
+        for (; i + 16 <= bytes; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            lanes = _mm_xor_si128(_mm_add_epi32(_mm_slli_epi32(lanes, 5), lanes), v);
+        }
+#elif defined(TILEHASH_HAVE_NEON)
+        for (; i + 16 <= bytes; i += 16) {
+            const uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(data + i));
+            lanes = veorq_u32(vaddq_u32(vshlq_n_u32(lanes, 5), lanes), v);
+        }
+#else
+        for (; i + 16 <= bytes; i += 16) {
+            quint32 words[4];
+            std::memcpy(words, data + i, sizeof(words));
+            for (int lane = 0; lane < 4; ++lane) {
+                lanes[lane] = (lanes[lane] * 33u) ^ words[lane];
+            }
+        }
+#endif
+        for (; i < bytes; ++i) {
+            tail = (tail ^ data[i]) * FNV_PRIME;
+        }
+    }
+
+    quint64 finish() const
+    {
+        alignas(16) quint32 out[4];
+#if defined(TILEHASH_HAVE_SSE2)
+        _mm_store_si128(reinterpret_cast<__m128i*>(out), lanes);
+#elif defined(TILEHASH_HAVE_NEON)
+        vst1q_u32(out, lanes);
+#else
+        std::memcpy(out, lanes, sizeof(out));
+#endif
+        const quint64 low = quint64(out[0]) | (quint64(out[1]) << 32);
+        const quint64 high = quint64(out[2]) | (quint64(out[3]) << 32);
+        return low ^ (high * 0x9e3779b97f4a7c15ull) ^ tail;
+    }
+};
+
+QImage as32Bit(const QImage& frame)
+{
+    return frame.depth() == 32 ? frame : frame.convertToFormat(QImage::Format_RGB32);
+}
+
+} // namespace
+
+Grid compute(const QImage& frame, int tileSize)
+{
+    Grid grid;
+    if (frame.isNull() || tileSize <= 0) {
+        return grid;
+    }
+
+    const QImage image = as32Bit(frame);
+    const int width = image.width();
+    const int height = image.height();
+    grid.tileSize = tileSize;
+    grid.frameSize = image.size();
+    grid.columns = (width + tileSize - 1) / tileSize;
+    grid.rows = (height + tileSize - 1) / tileSize;
+    grid.hashes.resize(grid.columns * grid.rows);
+
+    // Walk scanlines in memory order and feed each tile of the band its slice
+    std::vector<Accumulator> band(static_cast<size_t>(grid.columns));
+    for (int row = 0; row < grid.rows; ++row) {
+        std::fill(band.begin(), band.end(), Accumulator());
+        const int top = row * tileSize;
+        const int bottom = qMin(top + tileSize, height);
+        for (int y = top; y < bottom; ++y) {
+            const uchar* line = image.constScanLine(y);
+            for (int column = 0; column < grid.columns; ++column) {
+                const int x = column * tileSize;
+                band[static_cast<size_t>(column)].feed(line + x * 4, qMin(tileSize, width - x) * 4);
+            }
+        }
+        for (int column = 0; column < grid.columns; ++column) {
+            grid.hashes[row * grid.columns + column] = band[static_cast<size_t>(column)].finish();
+        }
+    }
+    return grid;
+}
+
+QVector<bool> changedRows(const Grid& previous, const Grid& current)
+{
+    QVector<bool> changed(current.rows, true);
+    if (previous.isEmpty() || !previous.sameLayout(current)) {
+        return changed;
+    }
+
+    for (int row = 0; row < current.rows; ++row) {
+        const auto first = current.hashes.constBegin() + row * current.columns;
+        changed[row] = !std::equal(first, first + current.columns,
+                                   previous.hashes.constBegin() + row * current.columns);
+    }
+    return changed;
+}
+
+quint64 hashRows(const QImage& frame, int top, int bottom)
+{
+    const QImage image = as32Bit(frame);
+    top = qMax(0, top);
+    bottom = qMin(bottom, image.height());
+
+    Accumulator accumulator;
+    for (int y = top; y < bottom; ++y) {
+        accumulator.feed(image.constScanLine(y), image.width() * 4);
+    }
+    return accumulator.finish();
+}
+
+} // namespace TileHash
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QImage>
+#include <QSize>
+#include <QVector>
+
+/**
+ * Tile hashing for live-region change detection
+ * A frame is cut into square tiles and each tile gets a 64-bit hash of its
+ * pixels, 16 bytes per step with SSE2 or NEON. Comparing two grids tells which
+ * tiles (and therefore which pixel rows) changed without keeping the previous
+ * frame around, so polling a static region costs one pass over its pixels.
+ */
+namespace TileHash {
+
+struct Grid {
+    int tileSize = 0;
+    int columns = 0;
+    int rows = 0;
+    QSize frameSize;
+    QVector<quint64> hashes; // row-major, columns * rows
+
+    bool isEmpty() const { return hashes.isEmpty(); }
+    bool sameLayout(const Grid& other) const { return tileSize == other.tileSize && frameSize == other.frameSize; }
+    bool operator==(const Grid& other) const { return sameLayout(other) && hashes == other.hashes; }
+    bool operator!=(const Grid& other) const { return !(*this == other); }
+};
+
+// 32-bit frames are hashed in place; other formats are converted first
+Grid compute(const QImage& frame, int tileSize = 32);
+
+// One flag per tile row of current: set when any tile in it differs (all set when the layouts differ)
+QVector<bool> changedRows(const Grid& previous, const Grid& current);
+
+// Hash of the full-width pixel rows [top, bottom), to recognise a text line that moved
+quint64 hashRows(const QImage& frame, int top, int bottom);
+
+} // namespace TileHash
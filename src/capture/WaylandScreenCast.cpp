@@ -0,0 +1,618 @@
+#include "WaylandScreenCast.h"
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QSettings>
+#include <QEventLoop>
+#include <QTimer>
+#include <QUuid>
+#include <QDebug>
+
+#if defined(Q_OS_LINUX) && defined(HAVE_PIPEWIRE)
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusArgument>
+#include <QDBusObjectPath>
+#include <QDBusPendingCallWatcher>
+#include <QDBusReply>
+#include <QDBusUnixFileDescriptor>
+
+#include <pipewire/pipewire.h>
+#include <spa/param/video/format-utils.h>
+#include <spa/pod/builder.h>
+#include <spa/buffer/buffer.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/dma-buf.h>
+#include <ctime>
+#endif
+
+#if defined(Q_OS_LINUX) && defined(HAVE_PIPEWIRE)
+
+struct WaylandScreenCast::Connection {
+    pw_thread_loop *loop = nullptr;
+    pw_context *context = nullptr;
+    pw_core *core = nullptr;
+};
+
+struct WaylandScreenCast::Stream {
+    Connection *connection = nullptr;
+    quint32 nodeId = 0;
+    QRect geometry;               // Logical desktop area from the portal; empty = the whole desktop
+    pw_stream *stream = nullptr;
+    spa_hook listener {};
+    spa_video_info_raw format {};
+    bool hasFormat = false;
+    bool failed = false;
+    pw_buffer *held = nullptr;    // Newest frame; handed back to PipeWire when a newer one arrives
+};
+
+namespace {
+
+const QString PORTAL_SERVICE = QStringLiteral("org.freedesktop.portal.Desktop");
+const QString PORTAL_PATH = QStringLiteral("/org/freedesktop/portal/desktop");
+const QString SCREENCAST_INTERFACE = QStringLiteral("org.freedesktop.portal.ScreenCast");
+
+constexpr uint SOURCE_MONITOR = 1;
+constexpr uint CURSOR_HIDDEN = 1;
+constexpr uint PERSIST_UNTIL_REVOKED = 2;
+
+QString newToken()
+{
+    return "ohao_" + QUuid::createUuid().toString(QUuid::Id128);
+}
+
+QImage::Format imageFormatFor(spa_video_format format)
+{
+    // Byte order in memory on little-endian hosts
+    switch (format) {
+    case SPA_VIDEO_FORMAT_BGRx: return QImage::Format_RGB32;
+    case SPA_VIDEO_FORMAT_BGRA: return QImage::Format_ARGB32;
+    case SPA_VIDEO_FORMAT_RGBx: return QImage::Format_RGBX8888;
+    case SPA_VIDEO_FORMAT_RGBA: return QImage::Format_RGBA8888;
+    default: return QImage::Format_Invalid;
+    }
+}
+
+QRect readRect(const QVariantMap &properties)
+{
+    if (!properties.contains("position") || !properties.contains("size")) {
+        return QRect();
+    }
+    int x = 0, y = 0, width = 0, height = 0;
+    const QDBusArgument position = properties.value("position").value<QDBusArgument>();
+    position.beginStructure();
+    position >> x >> y;
+    position.endStructure();
+    const QDBusArgument size = properties.value("size").value<QDBusArgument>();
+    size.beginStructure();
+    size >> width >> height;
+    size.endStructure();
+    return QRect(x, y, width, height);
+}
+
+} // namespace
+
+const pw_stream_events &WaylandScreenCast::streamEvents()
+{
+    static const pw_stream_events events = [] {
+        pw_stream_events table {};
+        table.version = PW_VERSION_STREAM_EVENTS;
+        table.state_changed = [](void *data, pw_stream_state, pw_stream_state state, const char *error) {
+            auto *stream = static_cast<Stream*>(data);
+            qDebug() << "WaylandScreenCast: node" << stream->nodeId << "is" << pw_stream_state_as_string(state)
+                     << (error ? error : "");
+            if (state == PW_STREAM_STATE_ERROR || state == PW_STREAM_STATE_UNCONNECTED) {
+                stream->failed = true;
+                pw_thread_loop_signal(stream->connection->loop, false);
+            }
+        };
+
+        table.param_changed = [](void *data, uint32_t id, const spa_pod *param) {
+            auto *stream = static_cast<Stream*>(data);
+            if (!param || id != SPA_PARAM_Format) {
+                return;
+            }
+
+            uint32_t mediaType = 0;
+            uint32_t mediaSubtype = 0;
+            if (spa_format_parse(param, &mediaType, &mediaSubtype) < 0
+                || mediaType != SPA_MEDIA_TYPE_video || mediaSubtype != SPA_MEDIA_SUBTYPE_raw
+                || spa_format_video_raw_parse(param, &stream->format) < 0) {
+                return;
+            }
+            stream->hasFormat = true;
+            qDebug() << "WaylandScreenCast: node" << stream->nodeId << "negotiated"
+                     << stream->format.size.width << "x" << stream->format.size.height
+                     << "format" << stream->format.format;
+
+            // Plain memory or dmabuf; we map whichever the compositor hands us
+            uint8_t buffer[256];
+            spa_pod_builder builder = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+            const spa_pod *params[1];
+            params[0] = static_cast<const spa_pod*>(spa_pod_builder_add_object(&builder,
+                SPA_TYPE_OBJECT_ParamBuffers, SPA_PARAM_Buffers,
+                SPA_PARAM_BUFFERS_dataType, SPA_POD_CHOICE_FLAGS_Int(
+                    (1 << SPA_DATA_MemPtr) | (1 << SPA_DATA_MemFd) | (1 << SPA_DATA_DmaBuf))));
+            pw_stream_update_params(stream->stream, params, 1);
+        };
+
+        table.process = [](void *data) {
+            auto *stream = static_cast<Stream*>(data);
+
+            // Drain the queue and keep only the newest buffer
+            pw_buffer *newest = nullptr;
+            while (pw_buffer *buffer = pw_stream_dequeue_buffer(stream->stream)) {
+                if (newest) {
+                    pw_stream_queue_buffer(stream->stream, newest);
+                }
+                newest = buffer;
+            }
+            if (!newest) {
+                return;
+            }
+
+            const spa_data &plane = newest->buffer->datas[0];
+            if (!plane.chunk || plane.chunk->size == 0 || (plane.chunk->flags & SPA_CHUNK_FLAG_CORRUPTED)) {
+                pw_stream_queue_buffer(stream->stream, newest);
+                return;
+            }
+
+            if (stream->held) {
+                pw_stream_queue_buffer(stream->stream, stream->held);
+            }
+            stream->held = newest;
+            pw_thread_loop_signal(stream->connection->loop, false);
+        };
+        return table;
+    }();
+    return events;
+}
+
+WaylandScreenCast& WaylandScreenCast::instance()
+{
+    static WaylandScreenCast screenCast;
+    return screenCast;
+}
+
+WaylandScreenCast::WaylandScreenCast() = default;
+
+WaylandScreenCast::~WaylandScreenCast()
+{
+    // stop() must already have run; DBus is gone by static destruction time
+}
+
+bool WaylandScreenCast::isEnabled() const
+{
+    QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+    return !m_unavailable && settings.value("capture/waylandScreenCast", true).toBool();
+}
+
+bool WaylandScreenCast::isStreaming() const
+{
+    if (!m_connection || m_streams.empty()) {
+        return false;
+    }
+    pw_thread_loop_lock(m_connection->loop);
+    bool alive = false;
+    for (const auto &stream : m_streams) {
+        alive = alive || !stream->failed;
+    }
+    pw_thread_loop_unlock(m_connection->loop);
+    return alive;
+}
+
+bool WaylandScreenCast::ensureStarted(int timeoutMs)
+{
+    if (isStreaming()) {
+        return true;
+    }
+    if (!isEnabled()) {
+        return false;
+    }
+
+    // Compositor ended the session (e.g. user revoked it) - start over
+    stop();
+
+    int fd = -1;
+    const QByteArray testNode = qgetenv("OHAO_PIPEWIRE_NODE");
+    if (!testNode.isEmpty()) {
+        // Stand-in producer on the local daemon; no portal involved
+        auto stream = std::make_unique<Stream>();
+        stream->nodeId = testNode.toUInt();
+        m_streams.push_back(std::move(stream));
+        qDebug() << "WaylandScreenCast: Using test node" << testNode;
+    } else if (!startPortalSession(timeoutMs, fd)) {
+        m_unavailable = true;
+        stop();
+        return false;
+    }
+
+    if (!connectPipeWire(fd)) {
+        m_unavailable = true;
+        stop();
+        return false;
+    }
+    return true;
+}
+
+bool WaylandScreenCast::startPortalSession(int timeoutMs, int &pipeWireFd)
+{
+    QVariantMap results;
+
+    QString token = newToken();
+    QVariantMap createOptions;
+    createOptions.insert("handle_token", token);
+    createOptions.insert("session_handle_token", newToken());
+    if (!portalRequest("CreateSession", {createOptions}, token, results, 5000)) {
+        qWarning() << "WaylandScreenCast: CreateSession failed";
+        return false;
+    }
+    m_sessionHandle = results.value("session_handle").toString();
+    const QDBusObjectPath session(m_sessionHandle);
+
+    // A stored restore_token lets the portal skip the monitor picker
+    QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+    token = newToken();
+    QVariantMap selectOptions;
+    selectOptions.insert("handle_token", token);
+    selectOptions.insert("types", SOURCE_MONITOR);
+    selectOptions.insert("multiple", true);
+    selectOptions.insert("cursor_mode", CURSOR_HIDDEN);
+    selectOptions.insert("persist_mode", PERSIST_UNTIL_REVOKED);
+    const QString restoreToken = settings.value("capture/screenCastRestoreToken").toString();
+    if (!restoreToken.isEmpty()) {
+        selectOptions.insert("restore_token", restoreToken);
+    }
+    if (!portalRequest("SelectSources", {QVariant::fromValue(session), selectOptions}, token, results, 5000)) {
+        qWarning() << "WaylandScreenCast: SelectSources failed";
+        return false;
+    }
+
+    // May show the picker - give the user time to choose
+    token = newToken();
+    QVariantMap startOptions;
+    startOptions.insert("handle_token", token);
+    if (!portalRequest("Start", {QVariant::fromValue(session), QString(), startOptions}, token, results, timeoutMs)) {
+        qWarning() << "WaylandScreenCast: Start was cancelled or failed";
+        return false;
+    }
+
+    // Tokens are single-use; the portal hands out a fresh one every time
+    if (results.contains("restore_token")) {
+        settings.setValue("capture/screenCastRestoreToken", results.value("restore_token").toString());
+    }
+
+    const QDBusArgument streams = results.value("streams").value<QDBusArgument>();
+    streams.beginArray();
+    while (!streams.atEnd()) {
+        quint32 nodeId = 0;
+        QVariantMap properties;
+        streams.beginStructure();
+        streams >> nodeId >> properties;
+        streams.endStructure();
+
+        auto stream = std::make_unique<Stream>();
+        stream->nodeId = nodeId;
+        stream->geometry = readRect(properties);
+        qDebug() << "WaylandScreenCast: Portal stream node" << nodeId << "covers" << stream->geometry;
+        m_streams.push_back(std::move(stream));
+    }
+    streams.endArray();
+    if (m_streams.empty()) {
+        return false;
+    }
+
+    QDBusMessage message = QDBusMessage::createMethodCall(PORTAL_SERVICE, PORTAL_PATH, SCREENCAST_INTERFACE, "OpenPipeWireRemote");
+    message << QVariant::fromValue(session) << QVariantMap();
+    QDBusReply<QDBusUnixFileDescriptor> reply = QDBusConnection::sessionBus().call(message, QDBus::Block, 5000);
+    if (!reply.isValid() || !reply.value().isValid()) {
+        qWarning() << "WaylandScreenCast: OpenPipeWireRemote failed:" << reply.error().message();
+        return false;
+    }
+    // QDBusUnixFileDescriptor closes its own copy; PipeWire takes ownership of this one
+    pipeWireFd = fcntl(reply.value().fileDescriptor(), F_DUPFD_CLOEXEC, 3);
+    return pipeWireFd >= 0;
+}
+
+bool WaylandScreenCast::portalRequest(const QString &method, const QList<QVariant> &arguments,
+                                      const QString &handleToken, QVariantMap &results, int timeoutMs)
+{
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    const QString sender = bus.baseService().mid(1).replace('.', '_');
+    const QString requestPath = QString("/org/freedesktop/portal/desktop/request/%1/%2").arg(sender, handleToken);
+
+    // Subscribe before calling so the Response can't slip past us
+    bus.connect(PORTAL_SERVICE, requestPath, "org.freedesktop.portal.Request", "Response",
+                this, SLOT(onPortalResponse(uint,QVariantMap)));
+
+    QDBusMessage message = QDBusMessage::createMethodCall(PORTAL_SERVICE, PORTAL_PATH, SCREENCAST_INTERFACE, method);
+    message.setArguments(arguments);
+
+    QEventLoop loop;
+    m_eventLoop = &loop;
+    m_portalResponse = 2;
+    m_portalResults.clear();
+
+    QDBusPendingCallWatcher watcher(bus.asyncCall(message));
+    connect(&watcher, &QDBusPendingCallWatcher::finished, &loop, [&loop, &watcher, method]() {
+        if (watcher.isError()) {
+            qWarning() << "WaylandScreenCast:" << method << "DBus error:" << watcher.error().message();
+            loop.quit();
+        }
+    });
+    QTimer::singleShot(timeoutMs, &loop, &QEventLoop::quit);
+    loop.exec();
+    m_eventLoop = nullptr;
+
+    bus.disconnect(PORTAL_SERVICE, requestPath, "org.freedesktop.portal.Request", "Response",
+                   this, SLOT(onPortalResponse(uint,QVariantMap)));
+
+    results = m_portalResults;
+    return m_portalResponse == 0;
+}
+
+void WaylandScreenCast::onPortalResponse(uint response, const QVariantMap &results)
+{
+    m_portalResponse = response;
+    m_portalResults = results;
+    if (m_eventLoop) {
+        m_eventLoop->quit();
+    }
+}
+
+bool WaylandScreenCast::connectPipeWire(int fd)
+{
+    static const bool initialised = (pw_init(nullptr, nullptr), true);
+    Q_UNUSED(initialised)
+
+    m_connection = std::make_unique<Connection>();
+    Connection *connection = m_connection.get();
+    connection->loop = pw_thread_loop_new("ohao-screencast", nullptr);
+    if (!connection->loop) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+    connection->context = pw_context_new(pw_thread_loop_get_loop(connection->loop), nullptr, 0);
+    if (!connection->context || pw_thread_loop_start(connection->loop) < 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+
+    pw_thread_loop_lock(connection->loop);
+    connection->core = fd >= 0
+        ? pw_context_connect_fd(connection->context, fd, nullptr, 0)
+        : pw_context_connect(connection->context, nullptr, 0);
+    if (!connection->core) {
+        pw_thread_loop_unlock(connection->loop);
+        qWarning() << "WaylandScreenCast: Could not connect to PipeWire";
+        return false;
+    }
+
+    // Only 32-bit RGB layouts that map straight onto a QImage
+    spa_rectangle defaultSize = SPA_RECTANGLE(1920, 1080);
+    spa_rectangle minSize = SPA_RECTANGLE(1, 1);
+    spa_rectangle maxSize = SPA_RECTANGLE(16384, 16384);
+    spa_fraction defaultRate = SPA_FRACTION(0, 1);
+    spa_fraction minRate = SPA_FRACTION(0, 1);
+    spa_fraction maxRate = SPA_FRACTION(240, 1);
+
+    bool connected = false;
+    for (const auto &stream : m_streams) {
+        stream->connection = connection;
+        stream->stream = pw_stream_new(connection->core, "ohao-screencast",
+            pw_properties_new(PW_KEY_MEDIA_TYPE, "Video",
+                              PW_KEY_MEDIA_CATEGORY, "Capture",
+                              PW_KEY_MEDIA_ROLE, "Screen",
+                              nullptr));
+        if (!stream->stream) {
+            continue;
+        }
+        pw_stream_add_listener(stream->stream, &stream->listener, &streamEvents(), stream.get());
+
+        uint8_t buffer[1024];
+        spa_pod_builder builder = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+        const spa_pod *params[1];
+        params[0] = static_cast<const spa_pod*>(spa_pod_builder_add_object(&builder,
+            SPA_TYPE_OBJECT_Format, SPA_PARAM_EnumFormat,
+            SPA_FORMAT_mediaType, SPA_POD_Id(SPA_MEDIA_TYPE_video),
+            SPA_FORMAT_mediaSubtype, SPA_POD_Id(SPA_MEDIA_SUBTYPE_raw),
+            SPA_FORMAT_VIDEO_format, SPA_POD_CHOICE_ENUM_Id(5,
+                SPA_VIDEO_FORMAT_BGRx, SPA_VIDEO_FORMAT_BGRx, SPA_VIDEO_FORMAT_BGRA,
+                SPA_VIDEO_FORMAT_RGBx, SPA_VIDEO_FORMAT_RGBA),
+            SPA_FORMAT_VIDEO_size, SPA_POD_CHOICE_RANGE_Rectangle(&defaultSize, &minSize, &maxSize),
+            SPA_FORMAT_VIDEO_framerate, SPA_POD_CHOICE_RANGE_Fraction(&defaultRate, &minRate, &maxRate)));
+
+        const int result = pw_stream_connect(stream->stream, PW_DIRECTION_INPUT, stream->nodeId,
+            static_cast<pw_stream_flags>(PW_STREAM_FLAG_AUTOCONNECT | PW_STREAM_FLAG_MAP_BUFFERS),
+            params, 1);
+        if (result < 0) {
+            qWarning() << "WaylandScreenCast: pw_stream_connect failed for node" << stream->nodeId;
+            stream->failed = true;
+            continue;
+        }
+        connected = true;
+    }
+    pw_thread_loop_unlock(connection->loop);
+    return connected;
+}
+
+QImage WaylandScreenCast::latestFrame(QScreen *screen, int waitMs, const QRect &region)
+{
+    if (!m_connection || m_streams.empty() || !screen) {
+        return QImage();
+    }
+
+    // Stream whose monitor contains this screen; a geometry-less stream covers the whole desktop
+    Stream *match = nullptr;
+    for (const auto &stream : m_streams) {
+        if (stream->geometry.contains(screen->geometry().center())) {
+            match = stream.get();
+            break;
+        }
+        if (!match && stream->geometry.isEmpty()) {
+            match = stream.get();
+        }
+    }
+    if (!match) {
+        match = m_streams.front().get();
+    }
+
+    pw_thread_loop *loop = m_connection->loop;
+    pw_thread_loop_lock(loop);
+
+    // The first frame can trail the stream start by a few milliseconds
+    if (!match->held && !match->failed) {
+        timespec deadline {};
+        pw_thread_loop_get_time(loop, &deadline, static_cast<int64_t>(waitMs) * SPA_NSEC_PER_MSEC);
+        while (!match->held && !match->failed) {
+            if (pw_thread_loop_timed_wait_full(loop, &deadline) != 0) {
+                break;
+            }
+        }
+    }
+
+    QImage frame;
+    const QImage::Format format = match->hasFormat ? imageFormatFor(match->format.format) : QImage::Format_Invalid;
+    if (match->held && format != QImage::Format_Invalid) {
+        const spa_data &plane = match->held->buffer->datas[0];
+        const int width = static_cast<int>(match->format.size.width);
+        const int height = static_cast<int>(match->format.size.height);
+        const int stride = plane.chunk->stride > 0 ? plane.chunk->stride : width * 4;
+
+        const uchar *base = static_cast<const uchar*>(plane.data);
+        void *mapped = nullptr;
+        size_t mappedSize = 0;
+        if (plane.type == SPA_DATA_DmaBuf) {
+            // Linear dmabuf (we never offered modifiers) can be read through a plain mapping
+            mappedSize = plane.maxsize + plane.mapoffset;
+            mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, static_cast<int>(plane.fd), 0);
+            if (mapped == MAP_FAILED) {
+                mapped = nullptr;
+            } else {
+                dma_buf_sync sync { DMA_BUF_SYNC_START | DMA_BUF_SYNC_READ };
+                ioctl(static_cast<int>(plane.fd), DMA_BUF_IOCTL_SYNC, &sync);
+                base = static_cast<const uchar*>(mapped) + plane.mapoffset;
+            }
+        }
+
+        if (base) {
+            const QImage view(base + plane.chunk->offset, width, height, stride, format);
+
+            // Crop this screen (or the region of it) out of the stream; stream pixels per logical unit gives the DPR
+            const QRect area = match->geometry.isEmpty() ? screen->virtualGeometry() : match->geometry;
+            const qreal scaleW = area.width() > 0 ? static_cast<qreal>(width) / area.width() : 1.0;
+            const qreal scaleH = area.height() > 0 ? static_cast<qreal>(height) / area.height() : 1.0;
+            const QRect target = region.isEmpty()
+                ? screen->geometry()
+                : region.translated(screen->geometry().topLeft()).intersected(screen->geometry());
+            const QRect logical = target.translated(-area.topLeft());
+            const QRect physical(qRound(logical.x() * scaleW), qRound(logical.y() * scaleH),
+                                 qRound(logical.width() * scaleW), qRound(logical.height() * scaleH));
+            frame = view.copy(physical.intersected(view.rect()));
+        }
+
+        if (mapped) {
+            dma_buf_sync sync { DMA_BUF_SYNC_END | DMA_BUF_SYNC_READ };
+            ioctl(static_cast<int>(plane.fd), DMA_BUF_IOCTL_SYNC, &sync);
+            munmap(mapped, mappedSize);
+        }
+    }
+
+    pw_thread_loop_unlock(loop);
+    return frame;
+}
+
+void WaylandScreenCast::stop()
+{
+    if (m_connection) {
+        Connection *connection = m_connection.get();
+        if (connection->loop) {
+            pw_thread_loop_lock(connection->loop);
+            for (const auto &stream : m_streams) {
+                if (!stream->stream) {
+                    continue;
+                }
+                if (stream->held) {
+                    pw_stream_queue_buffer(stream->stream, stream->held);
+                    stream->held = nullptr;
+                }
+                spa_hook_remove(&stream->listener);
+                pw_stream_disconnect(stream->stream);
+                pw_stream_destroy(stream->stream);
+                stream->stream = nullptr;
+            }
+            if (connection->core) {
+                pw_core_disconnect(connection->core);
+            }
+            pw_thread_loop_unlock(connection->loop);
+            pw_thread_loop_stop(connection->loop);
+        }
+        if (connection->context) {
+            pw_context_destroy(connection->context);
+        }
+        if (connection->loop) {
+            pw_thread_loop_destroy(connection->loop);
+        }
+        m_connection.reset();
+    }
+    m_streams.clear();
+
+    if (!m_sessionHandle.isEmpty()) {
+        QDBusMessage close = QDBusMessage::createMethodCall(PORTAL_SERVICE, m_sessionHandle,
+                                                            "org.freedesktop.portal.Session", "Close");
+        QDBusConnection::sessionBus().call(close, QDBus::NoBlock);
+        m_sessionHandle.clear();
+    }
+}
+
+#else
+
+struct WaylandScreenCast::Connection {};
+struct WaylandScreenCast::Stream {};
+
+WaylandScreenCast& WaylandScreenCast::instance()
+{
+    static WaylandScreenCast screenCast;
+    return screenCast;
+}
+
+WaylandScreenCast::WaylandScreenCast() = default;
+WaylandScreenCast::~WaylandScreenCast() = default;
+
+bool WaylandScreenCast::isEnabled() const
+{
+    return false;
+}
+
+bool WaylandScreenCast::ensureStarted(int)
+{
+    return false;
+}
+
+bool WaylandScreenCast::isStreaming() const
+{
+    return false;
+}
+
+QImage WaylandScreenCast::latestFrame(QScreen *, int, const QRect &)
+{
+    return QImage();
+}
+
+void WaylandScreenCast::stop()
+{
+}
+
+void WaylandScreenCast::onPortalResponse(uint, const QVariantMap &)
+{
+}
+
+#endif
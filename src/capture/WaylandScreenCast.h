@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QObject>
+#include <QImage>
+#include <QMap>
+#include <QRect>
+#include <QString>
+#include <QVariant>
+#include <memory>
+#include <vector>
+
+class QScreen;
+class QEventLoop;
+struct pw_stream_events;
+
+/**
+ * Persistent Wayland capture through the ScreenCast portal and PipeWire
+ * The portal session is negotiated once (the monitor picker only appears the
+ * first time - its restore_token is kept in settings) and the PipeWire stream
+ * stays open. The newest buffer is held on the PipeWire thread and only copied
+ * out when latestFrame() is called, so an idle stream costs no copies.
+ *
+ * For testing without a portal set OHAO_PIPEWIRE_NODE to the id of any video
+ * source on the local PipeWire daemon (e.g. gst-launch-1.0 videotestsrc !
+ * pipewiresink); that node is treated as covering the whole desktop.
+ *
+ * Without HAVE_PIPEWIRE every call fails and ScreenCapture keeps using the
+ * one-shot Screenshot portal.
+ *
+ * GUI thread only, every method: stop() tears down the streams latestFrame()
+ * reads, and only the frame hand-over itself is under PipeWire's loop lock.
+ */
+class WaylandScreenCast : public QObject
+{
+    Q_OBJECT
+
+public:
+    static WaylandScreenCast& instance();
+
+    // Compiled with PipeWire and not disabled via capture/waylandScreenCast
+    bool isEnabled() const;
+
+    // Runs the portal handshake if needed (may show the monitor picker once) and opens the streams
+    bool ensureStarted(int timeoutMs = 60000);
+    bool isStreaming() const;
+
+    // Copy of the newest frame covering screen, cropped to it; null if none arrived within waitMs
+    // region (screen-local logical coordinates) narrows the copy to part of the screen
+    QImage latestFrame(QScreen *screen, int waitMs = 500, const QRect &region = QRect());
+
+    // Close the portal session and the PipeWire connection (call before QApplication goes away)
+    void stop();
+
+private slots:
+    void onPortalResponse(uint response, const QVariantMap &results);
+
+private:
+    // PipeWire state lives in the .cpp so this header stays free of PipeWire includes
+    struct Stream;
+    struct Connection;
+
+    // Stream callbacks, built in a member so they can reach Stream
+    static const pw_stream_events &streamEvents();
+
+    WaylandScreenCast();
+    ~WaylandScreenCast();
+
+    bool portalRequest(const QString &method, const QList<QVariant> &arguments,
+                       const QString &handleToken, QVariantMap &results, int timeoutMs);
+    bool startPortalSession(int timeoutMs, int &pipeWireFd);
+    bool connectPipeWire(int fd);
+
+    QString m_sessionHandle;
+    bool m_unavailable = false;   // portal refused or the user cancelled; don't ask again this run
+    std::vector<std::unique_ptr<Stream>> m_streams;
+    std::unique_ptr<Connection> m_connection;
+
+    // Portal request in flight
+    QEventLoop *m_eventLoop = nullptr;
+    uint m_portalResponse = 2;
+    QVariantMap m_portalResults;
+};
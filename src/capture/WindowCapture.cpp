@@ -0,0 +1,476 @@
+#include "WindowCapture.h"
+#include "X11ShmCapture.h"
+#include "X11ErrorTrap.h"
+#include <QCoreApplication>
+#include <QVector>
+#include <QDebug>
+
+#if defined(Q_OS_LINUX) && defined(HAVE_XCOMPOSITE)
+#include <X11/Xlib.h>
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/Xcomposite.h>
+#elif defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#ifndef PW_RENDERFULLCONTENT
+#define PW_RENDERFULLCONTENT 0x00000002
+#endif
+#endif
+
+#if defined(Q_OS_LINUX) && defined(HAVE_XCOMPOSITE)
+
+struct WindowCapture::Native {
+    Display* display = nullptr;
+    Pixmap pixmap = 0;      // Named composite pixmap; survives unmapping, renamed on resize
+    QSize size;
+    int depth = 0;
+    bool redirected = false;
+    bool gone = false;
+};
+
+namespace {
+
+QVector<unsigned long> cardinals(Display* display, Window window, Atom property, Atom type)
+{
+    QVector<unsigned long> values;
+    Atom actualType = None;
+    int actualFormat = 0;
+    unsigned long count = 0, remaining = 0;
+    unsigned char* data = nullptr;
+    if (XGetWindowProperty(display, window, property, 0, 4096, False, type,
+                           &actualType, &actualFormat, &count, &remaining, &data) == Success && data) {
+        // Format 32 items come back as longs
+        if (actualType == type && actualFormat == 32) {
+            const unsigned long* items = reinterpret_cast<const unsigned long*>(data);
+            values = QVector<unsigned long>(items, items + count);
+        }
+        XFree(data);
+    }
+    return values;
+}
+
+QString windowTitle(Display* display, Window window)
+{
+    static const Atom netName = XInternAtom(display, "_NET_WM_NAME", False);
+    static const Atom utf8 = XInternAtom(display, "UTF8_STRING", False);
+
+    QString title;
+    Atom actualType = None;
+    int actualFormat = 0;
+    unsigned long count = 0, remaining = 0;
+    unsigned char* data = nullptr;
+    if (XGetWindowProperty(display, window, netName, 0, 1024, False, utf8,
+                           &actualType, &actualFormat, &count, &remaining, &data) == Success && data) {
+        if (actualFormat == 8) {
+            title = QString::fromUtf8(reinterpret_cast<const char*>(data), static_cast<int>(count));
+        }
+        XFree(data);
+    }
+    if (title.isEmpty()) {
+        char* name = nullptr;
+        if (XFetchName(display, window, &name) && name) {
+            title = QString::fromLocal8Bit(name);
+            XFree(name);
+        }
+    }
+    return title;
+}
+
+QRect windowGeometry(Display* display, Window window)
+{
+    XWindowAttributes attributes;
+    if (!XGetWindowAttributes(display, window, &attributes)) {
+        return QRect();
+    }
+    int x = 0, y = 0;
+    Window child = 0;
+    XTranslateCoordinates(display, window, attributes.root, 0, 0, &x, &y, &child);
+    return QRect(x, y, attributes.width, attributes.height);
+}
+
+} // namespace
+
+QList<WindowCapture::Info> WindowCapture::list()
+{
+    QList<Info> windows;
+    Display* display = XOpenDisplay(nullptr);
+    if (!display) {
+        return windows;
+    }
+
+    {
+        X11ErrorTrap trap(display);
+        const Atom clientList = XInternAtom(display, "_NET_CLIENT_LIST", False);
+        const Atom pidAtom = XInternAtom(display, "_NET_WM_PID", False);
+        const unsigned long ownPid = static_cast<unsigned long>(QCoreApplication::applicationPid());
+
+        for (const unsigned long client : cardinals(display, DefaultRootWindow(display), clientList, XA_WINDOW)) {
+            const QVector<unsigned long> pid = cardinals(display, client, pidAtom, XA_CARDINAL);
+            if (!pid.isEmpty() && pid.first() == ownPid) {
+                continue;
+            }
+            Info info;
+            info.id = client;
+            info.title = windowTitle(display, client);
+            info.geometry = windowGeometry(display, client);
+            info.pid = pid.isEmpty() ? 0 : static_cast<qint64>(pid.first());
+            if (!info.title.isEmpty() && !info.geometry.isEmpty()) {
+                windows.append(info);
+            }
+        }
+    }
+
+    XCloseDisplay(display);
+    return windows;
+}
+
+WindowCapture::Info WindowCapture::windowAt(const QPoint &point)
+{
+    Info info;
+    Display* display = XOpenDisplay(nullptr);
+    if (!display) {
+        return info;
+    }
+
+    {
+        X11ErrorTrap trap(display);
+        const Atom stackingList = XInternAtom(display, "_NET_CLIENT_LIST_STACKING", False);
+        const Atom pidAtom = XInternAtom(display, "_NET_WM_PID", False);
+        const unsigned long ownPid = static_cast<unsigned long>(QCoreApplication::applicationPid());
+
+        // Bottom to top; the first viewable hit from the end is what is on screen there
+        const QVector<unsigned long> stacking = cardinals(display, DefaultRootWindow(display), stackingList, XA_WINDOW);
+        for (auto it = stacking.crbegin(); it != stacking.crend(); ++it) {
+            XWindowAttributes attributes;
+            if (!XGetWindowAttributes(display, *it, &attributes) || attributes.map_state != IsViewable) {
+                continue;
+            }
+            const QRect geometry = windowGeometry(display, *it);
+            if (!geometry.contains(point)) {
+                continue;
+            }
+            const QVector<unsigned long> pid = cardinals(display, *it, pidAtom, XA_CARDINAL);
+            if (!pid.isEmpty() && pid.first() == ownPid) {
+                continue;
+            }
+            info.id = *it;
+            info.title = windowTitle(display, *it);
+            info.geometry = geometry;
+            info.pid = pid.isEmpty() ? 0 : static_cast<qint64>(pid.first());
+            break;
+        }
+    }
+
+    XCloseDisplay(display);
+    return info;
+}
+
+WindowCapture::WindowCapture(quintptr window)
+    : m_native(new Native)
+    , m_window(window)
+{
+    // Own connection, like X11ShmCapture: the redirection and the pixmap live exactly as long as it does
+    Display* display = XOpenDisplay(nullptr);
+    m_native->display = display;
+    m_native->gone = true;
+    if (!display) {
+        return;
+    }
+
+    // Named window pixmaps need Composite 0.2
+    int eventBase = 0, errorBase = 0, major = 0, minor = 2;
+    if (!XCompositeQueryExtension(display, &eventBase, &errorBase)
+        || !XCompositeQueryVersion(display, &major, &minor) || (major == 0 && minor < 2)) {
+        qDebug() << "WindowCapture: XComposite 0.2 not available";
+        return;
+    }
+
+    // Automatic redirection keeps the window's contents off-screen and still lets it be drawn normally
+    X11ErrorTrap trap(display);
+    XCompositeRedirectWindow(display, static_cast<Window>(window), CompositeRedirectAutomatic);
+    m_native->redirected = !trap.failed();
+    m_native->gone = !m_native->redirected;
+    if (m_native->gone) {
+        qDebug() << "WindowCapture: Could not redirect window" << Qt::hex << window;
+    }
+}
+
+WindowCapture::~WindowCapture()
+{
+    if (Display* display = m_native->display) {
+        {
+            X11ErrorTrap trap(display);
+            if (m_native->pixmap) {
+                XFreePixmap(display, m_native->pixmap);
+            }
+            if (m_native->redirected) {
+                XCompositeUnredirectWindow(display, static_cast<Window>(m_window), CompositeRedirectAutomatic);
+            }
+        }
+        XCloseDisplay(display);
+    }
+    delete m_native;
+}
+
+bool WindowCapture::isValid() const
+{
+    return m_native->display && !m_native->gone;
+}
+
+QImage WindowCapture::grab()
+{
+    if (!isValid()) {
+        return QImage();
+    }
+
+    Display* display = m_native->display;
+    const Window window = static_cast<Window>(m_window);
+
+    {
+        X11ErrorTrap trap(display);
+        XWindowAttributes attributes;
+        if (!XGetWindowAttributes(display, window, &attributes) || trap.failed()) {
+            qDebug() << "WindowCapture: Window" << Qt::hex << m_window << "is gone";
+            m_native->gone = true;
+            return QImage();
+        }
+
+        // A pixmap can only be named while the window is viewable; otherwise the last one is kept
+        const QSize size(attributes.width, attributes.height);
+        if (attributes.map_state == IsViewable && (!m_native->pixmap || size != m_native->size)) {
+            if (m_native->pixmap) {
+                XFreePixmap(display, m_native->pixmap);
+            }
+            m_native->pixmap = XCompositeNameWindowPixmap(display, window);
+            if (trap.failed()) {
+                m_native->pixmap = 0;
+            } else {
+                m_native->size = size;
+                m_native->depth = attributes.depth;
+            }
+        }
+    }
+    if (!m_native->pixmap) {
+        return QImage();  // Not shown once since it was picked (e.g. minimised)
+    }
+
+    // The trap synced, so the shared-memory connection already sees the pixmap
+    QImage frame = X11ShmCapture::instance().grabDrawable(m_native->pixmap, m_native->size, m_native->depth);
+    if (frame.isNull()) {
+        // ARGB visual or no MIT-SHM: one XGetImage of the same size
+        X11ErrorTrap trap(display);
+        XImage* image = XGetImage(display, m_native->pixmap, 0, 0,
+                                  static_cast<unsigned int>(m_native->size.width()),
+                                  static_cast<unsigned int>(m_native->size.height()), AllPlanes, ZPixmap);
+        if (image && !trap.failed() && image->bits_per_pixel == 32) {
+            const QImage::Format format = m_native->depth == 32 ? QImage::Format_ARGB32_Premultiplied
+                                                                 : QImage::Format_RGB32;
+            frame = QImage(reinterpret_cast<const uchar*>(image->data), image->width, image->height,
+                           image->bytes_per_line, format).copy();
+        }
+        if (image) {
+            XDestroyImage(image);
+        }
+    }
+    return frame;
+}
+
+QRect WindowCapture::geometry() const
+{
+    if (!isValid()) {
+        return QRect();
+    }
+    X11ErrorTrap trap(m_native->display);
+    const QRect rect = windowGeometry(m_native->display, static_cast<Window>(m_window));
+    return trap.failed() ? QRect() : rect;
+}
+
+#elif defined(Q_OS_WIN)
+
+struct WindowCapture::Native {
+    HDC dc = nullptr;
+    HBITMAP bitmap = nullptr;
+    HGDIOBJ previous = nullptr;
+    void* bits = nullptr;
+    QSize size;
+};
+
+namespace {
+
+BOOL CALLBACK addWindow(HWND hwnd, LPARAM lParam)
+{
+    auto* windows = reinterpret_cast<QList<WindowCapture::Info>*>(lParam);
+    if (!IsWindowVisible(hwnd) || GetWindow(hwnd, GW_OWNER)
+        || (GetWindowLongPtrW(hwnd, GWL_EXSTYLE) & WS_EX_TOOLWINDOW)) {
+        return TRUE;
+    }
+
+    DWORD pid = 0;
+    GetWindowThreadProcessId(hwnd, &pid);
+    const int length = GetWindowTextLengthW(hwnd);
+    if (pid == GetCurrentProcessId() || length == 0) {
+        return TRUE;
+    }
+
+    QVector<wchar_t> title(length + 1);
+    GetWindowTextW(hwnd, title.data(), length + 1);
+    RECT rect;
+    GetWindowRect(hwnd, &rect);
+
+    WindowCapture::Info info;
+    info.id = reinterpret_cast<quintptr>(hwnd);
+    info.title = QString::fromWCharArray(title.constData());
+    info.geometry = QRect(rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top);
+    info.pid = static_cast<qint64>(pid);
+    if (!info.geometry.isEmpty()) {
+        windows->append(info);
+    }
+    return TRUE;
+}
+
+} // namespace
+
+QList<WindowCapture::Info> WindowCapture::list()
+{
+    QList<Info> windows;
+    EnumWindows(addWindow, reinterpret_cast<LPARAM>(&windows));
+    return windows;
+}
+
+WindowCapture::Info WindowCapture::windowAt(const QPoint &point)
+{
+    // EnumWindows goes top to bottom in z-order
+    for (const Info &info : list()) {
+        if (info.geometry.contains(point)) {
+            return info;
+        }
+    }
+    return Info();
+}
+
+WindowCapture::WindowCapture(quintptr window)
+    : m_native(new Native)
+    , m_window(window)
+{
+    m_native->dc = CreateCompatibleDC(nullptr);
+}
+
+WindowCapture::~WindowCapture()
+{
+    if (m_native->bitmap) {
+        SelectObject(m_native->dc, m_native->previous);
+        DeleteObject(m_native->bitmap);
+    }
+    if (m_native->dc) {
+        DeleteDC(m_native->dc);
+    }
+    delete m_native;
+}
+
+bool WindowCapture::isValid() const
+{
+    return m_native->dc && IsWindow(reinterpret_cast<HWND>(m_window));
+}
+
+QImage WindowCapture::grab()
+{
+    HWND hwnd = reinterpret_cast<HWND>(m_window);
+    // Minimised windows have nothing to render
+    if (!isValid() || IsIconic(hwnd)) {
+        return QImage();
+    }
+
+    RECT rect;
+    GetWindowRect(hwnd, &rect);
+    const QSize size(rect.right - rect.left, rect.bottom - rect.top);
+    if (size.isEmpty()) {
+        return QImage();
+    }
+
+    // The DIB section is only rebuilt when the window is resized
+    if (size != m_native->size) {
+        if (m_native->bitmap) {
+            SelectObject(m_native->dc, m_native->previous);
+            DeleteObject(m_native->bitmap);
+            m_native->bitmap = nullptr;
+        }
+        BITMAPINFO info {};
+        info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        info.bmiHeader.biWidth = size.width();
+        info.bmiHeader.biHeight = -size.height();  // Top-down, like QImage
+        info.bmiHeader.biPlanes = 1;
+        info.bmiHeader.biBitCount = 32;
+        info.bmiHeader.biCompression = BI_RGB;
+        m_native->bitmap = CreateDIBSection(m_native->dc, &info, DIB_RGB_COLORS, &m_native->bits, nullptr, 0);
+        if (!m_native->bitmap) {
+            m_native->size = QSize();
+            return QImage();
+        }
+        m_native->previous = SelectObject(m_native->dc, m_native->bitmap);
+        m_native->size = size;
+    }
+
+    // PW_RENDERFULLCONTENT also gets DirectX/DWM-composed content, and works while the window is covered
+    if (!PrintWindow(hwnd, m_native->dc, PW_RENDERFULLCONTENT)) {
+        qDebug() << "WindowCapture: PrintWindow failed";
+        return QImage();
+    }
+    GdiFlush();
+
+    return QImage(static_cast<const uchar*>(m_native->bits), size.width(), size.height(),
+                  size.width() * 4, QImage::Format_RGB32);
+}
+
+QRect WindowCapture::geometry() const
+{
+    RECT rect;
+    if (!isValid() || !GetWindowRect(reinterpret_cast<HWND>(m_window), &rect)) {
+        return QRect();
+    }
+    return QRect(rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top);
+}
+
+#else
+
+struct WindowCapture::Native {};
+
+QList<WindowCapture::Info> WindowCapture::list()
+{
+    return QList<Info>();
+}
+
+WindowCapture::Info WindowCapture::windowAt(const QPoint &)
+{
+    return Info();
+}
+
+WindowCapture::WindowCapture(quintptr window)
+    : m_native(new Native)
+    , m_window(window)
+{
+}
+
+WindowCapture::~WindowCapture()
+{
+    delete m_native;
+}
+
+bool WindowCapture::isValid() const
+{
+    return false;
+}
+
+QImage WindowCapture::grab()
+{
+    return QImage();
+}
+
+QRect WindowCapture::geometry() const
+{
+    return QRect();
+}
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QImage>
+#include <QList>
+#include <QPoint>
+#include <QRect>
+#include <QString>
+
+/**
+ * Capture of one top-level window's own buffer, even while it is covered
+ * X11: the window is redirected with XComposite and its named pixmap is read
+ * through the MIT-SHM segment (X11ShmCapture), so a grab costs the window's
+ * size and never picks up whatever overlaps it. The pixmap is only renamed
+ * when the window is resized; an unmapped window (minimised, other workspace)
+ * keeps returning its last contents.
+ * Windows: PrintWindow(PW_RENDERFULLCONTENT) into a persistent DIB section.
+ *
+ * Geometry and images are in device pixels. The returned image may alias a
+ * capture buffer until the next grab(). GUI thread only.
+ */
+class WindowCapture
+{
+public:
+    struct Info {
+        quintptr id = 0;
+        QString title;
+        QRect geometry;     // Device pixels, desktop coordinates
+        qint64 pid = 0;     // Owning process; 0 if it doesn't say
+    };
+
+    // Top-level application windows other than ours; empty where window capture isn't supported
+    static QList<Info> list();
+
+    // Topmost application window other than ours at point (device pixels, desktop coordinates);
+    // id 0 if there is none or stacking order isn't known
+    static Info windowAt(const QPoint &point);
+
+    explicit WindowCapture(quintptr window);
+    ~WindowCapture();
+
+    quintptr window() const { return m_window; }
+
+    // False once the window is gone (or if it could never be captured)
+    bool isValid() const;
+
+    QImage grab();
+
+    // Where the window is now (device pixels); empty if it is gone
+    QRect geometry() const;
+
+private:
+    WindowCapture(const WindowCapture&) = delete;
+    WindowCapture& operator=(const WindowCapture&) = delete;
+
+    // Platform connection, named pixmap or DIB section
+    struct Native;
+    Native* m_native = nullptr;
+    quintptr m_window = 0;
+};
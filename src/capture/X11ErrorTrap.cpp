@@ -0,0 +1,60 @@
+#include "X11ErrorTrap.h"
+#include <QtGlobal>
+
+#ifdef Q_OS_LINUX
+
+#include <X11/Xlib.h>
+#include <mutex>
+
+namespace {
+
+thread_local X11ErrorTrap* t_innermost = nullptr;
+XErrorHandler s_previous = nullptr;
+
+} // namespace
+
+X11ErrorTrap::X11ErrorTrap(_XDisplay* display)
+    : m_display(display)
+    , m_outer(t_innermost)
+{
+    install();
+    t_innermost = this;
+}
+
+X11ErrorTrap::~X11ErrorTrap()
+{
+    // Errors of the requests made under the trap arrive before it goes
+    XSync(m_display, False);
+    t_innermost = m_outer;
+}
+
+bool X11ErrorTrap::failed()
+{
+    XSync(m_display, False);
+    return m_failed;
+}
+
+void X11ErrorTrap::initThreads()
+{
+    static std::once_flag once;
+    std::call_once(once, []() { XInitThreads(); });
+}
+
+void X11ErrorTrap::install()
+{
+    static std::once_flag once;
+    std::call_once(once, []() {
+        // Xlib calls the handler on the thread that read the error, i.e. the one using that Display
+        s_previous = XSetErrorHandler([](Display* display, XErrorEvent* event) -> int {
+            for (X11ErrorTrap* trap = t_innermost; trap; trap = trap->m_outer) {
+                if (trap->m_display == display) {
+                    trap->m_failed = true;
+                    return 0;
+                }
+            }
+            return s_previous ? s_previous(display, event) : 0;
+        });
+    });
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,35 @@
+#pragma once
+
+struct _XDisplay;
+
+/**
+ * Collects the X errors of one Display's requests instead of letting Xlib abort
+ * Any request on our own connections can fail asynchronously (a window or
+ * pixmap freed meanwhile, XShmAttach on a remote display). One process-wide
+ * handler is installed once and never swapped back and forth; each trap
+ * registers itself for the current thread, so traps on different threads and
+ * Displays only ever see their own errors. Errors for a Display no trap on the
+ * thread is watching go to the handler that was installed before ours.
+ */
+class X11ErrorTrap
+{
+public:
+    explicit X11ErrorTrap(_XDisplay* display);
+    ~X11ErrorTrap();
+
+    // Whether a request made since the trap was set failed; syncs with the server first
+    bool failed();
+
+    // Xlib's own locking; call before opening a Display that may be used off the GUI thread
+    static void initThreads();
+
+private:
+    X11ErrorTrap(const X11ErrorTrap&) = delete;
+    X11ErrorTrap& operator=(const X11ErrorTrap&) = delete;
+
+    static void install();
+
+    _XDisplay* m_display;
+    X11ErrorTrap* m_outer;   // Trap set before this one on the same thread
+    bool m_failed = false;
+};
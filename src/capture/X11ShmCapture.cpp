@@ -0,0 +1,290 @@
+#include "X11ShmCapture.h"
+#include "X11ErrorTrap.h"
+#include <QDebug>
+
+#ifdef Q_OS_LINUX
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
+
+#ifdef Q_OS_LINUX
+
+struct X11ShmCapture::Segment {
+    XShmSegmentInfo info {};
+    qsizetype bytes = 0;
+};
+
+X11ShmCapture& X11ShmCapture::instance()
+{
+    static X11ShmCapture capture;
+    return capture;
+}
+
+X11ShmCapture& X11ShmCapture::background()
+{
+    static X11ShmCapture capture;
+    return capture;
+}
+
+X11ShmCapture::~X11ShmCapture()
+{
+    releaseImage();
+    releaseSegment();
+    delete m_segment;
+    if (m_display) {
+        XCloseDisplay(m_display);
+    }
+}
+
+bool X11ShmCapture::isAvailable()
+{
+    if (!m_initialized) {
+        m_initialized = true;
+        m_available = initialize();
+    }
+    return m_available;
+}
+
+bool X11ShmCapture::initialize()
+{
+    // Own connection: keeps our requests off Qt's xcb queue and away from its error handling.
+    // background() uses its connection from a worker thread
+    X11ErrorTrap::initThreads();
+    m_display = XOpenDisplay(nullptr);
+    if (!m_display) {
+        qDebug() << "X11ShmCapture: No X display";
+        return false;
+    }
+
+    if (!XShmQueryExtension(m_display)) {
+        qDebug() << "X11ShmCapture: MIT-SHM not supported by this display";
+        return false;
+    }
+
+    const int screen = DefaultScreen(m_display);
+    m_root = RootWindow(m_display, screen);
+    Visual* visual = DefaultVisual(m_display, screen);
+    m_visual = visual;
+    m_depth = DefaultDepth(m_display, screen);
+
+    // Only the common 24/32-bit xRGB layout maps onto a QImage without conversion
+    const bool xrgb = visual->red_mask == 0xff0000 && visual->green_mask == 0x00ff00 && visual->blue_mask == 0x0000ff;
+    if (!xrgb || (m_depth != 24 && m_depth != 32)) {
+        qDebug() << "X11ShmCapture: Unsupported visual, depth" << m_depth;
+        return false;
+    }
+    m_format = QImage::Format_RGB32;
+
+    m_segment = new Segment;
+
+    // Probe with a 1x1 grab so the first real capture doesn't discover a broken setup
+    const int width = DisplayWidth(m_display, screen);
+    const int height = DisplayHeight(m_display, screen);
+    if (!ensureSegment(static_cast<qsizetype>(width) * height * 4) || !ensureImage(QSize(1, 1))) {
+        return false;
+    }
+    if (m_image->bits_per_pixel != 32
+        || (m_image->byte_order == LSBFirst) != (Q_BYTE_ORDER == Q_LITTLE_ENDIAN)) {
+        qDebug() << "X11ShmCapture: Unsupported pixel layout";
+        return false;
+    }
+
+    qDebug() << "X11ShmCapture: MIT-SHM capture ready for" << width << "x" << height;
+    return true;
+}
+
+bool X11ShmCapture::ensureSegment(qsizetype bytes)
+{
+    if (m_segment->bytes >= bytes && m_segment->info.shmaddr) {
+        return true;
+    }
+
+    // Screen grew (monitor hot-plugged) - the image header points at the old segment
+    releaseImage();
+    releaseSegment();
+
+    XShmSegmentInfo& info = m_segment->info;
+    info.shmid = shmget(IPC_PRIVATE, static_cast<size_t>(bytes), IPC_CREAT | 0600);
+    if (info.shmid < 0) {
+        qWarning() << "X11ShmCapture: shmget failed for" << bytes << "bytes";
+        return false;
+    }
+
+    info.shmaddr = static_cast<char*>(shmat(info.shmid, nullptr, 0));
+    if (info.shmaddr == reinterpret_cast<char*>(-1)) {
+        info.shmaddr = nullptr;
+        shmctl(info.shmid, IPC_RMID, nullptr);
+        info.shmid = -1;
+        return false;
+    }
+    info.readOnly = False;
+
+    // Fails asynchronously on a remote display
+    bool attached = false;
+    {
+        X11ErrorTrap trap(m_display);
+        attached = XShmAttach(m_display, &info) && !trap.failed();
+    }
+
+    // Marked for removal now; the kernel frees it once both we and the server detach
+    shmctl(info.shmid, IPC_RMID, nullptr);
+
+    if (!attached) {
+        qDebug() << "X11ShmCapture: XShmAttach failed (remote display?)";
+        shmdt(info.shmaddr);
+        info.shmaddr = nullptr;
+        info.shmid = -1;
+        return false;
+    }
+
+    m_segment->bytes = bytes;
+    return true;
+}
+
+bool X11ShmCapture::ensureImage(const QSize& size)
+{
+    if (m_image && m_imageSize == size) {
+        return true;
+    }
+    releaseImage();
+
+    // Header only - the pixel data is the shared segment
+    m_image = XShmCreateImage(m_display, static_cast<Visual*>(m_visual), static_cast<unsigned int>(m_depth),
+                              ZPixmap, nullptr, &m_segment->info,
+                              static_cast<unsigned int>(size.width()), static_cast<unsigned int>(size.height()));
+    if (!m_image) {
+        return false;
+    }
+    m_image->data = m_segment->info.shmaddr;
+    m_imageSize = size;
+    return true;
+}
+
+void X11ShmCapture::releaseImage()
+{
+    if (m_image) {
+        // Detach the shared data first so XDestroyImage doesn't free() it
+        m_image->data = nullptr;
+        XDestroyImage(m_image);
+        m_image = nullptr;
+        m_imageSize = QSize();
+    }
+}
+
+void X11ShmCapture::releaseSegment()
+{
+    if (!m_segment || !m_segment->info.shmaddr) {
+        return;
+    }
+    XShmDetach(m_display, &m_segment->info);
+    XSync(m_display, False);
+    shmdt(m_segment->info.shmaddr);
+    m_segment->info.shmaddr = nullptr;
+    m_segment->info.shmid = -1;
+    m_segment->bytes = 0;
+}
+
+void X11ShmCapture::releaseMemory()
+{
+    releaseImage();
+    releaseSegment();
+}
+
+QImage X11ShmCapture::grab(const QRect& rect)
+{
+    if (!isAvailable()) {
+        return QImage();
+    }
+
+    // Root geometry can change at runtime (RandR), so ask rather than trusting DisplayWidth
+    Window rootReturn;
+    int rootX = 0, rootY = 0;
+    unsigned int rootWidth = 0, rootHeight = 0, border = 0, depth = 0;
+    if (!XGetGeometry(m_display, m_root, &rootReturn, &rootX, &rootY, &rootWidth, &rootHeight, &border, &depth)) {
+        return QImage();
+    }
+
+    const QRect area = rect.intersected(QRect(0, 0, static_cast<int>(rootWidth), static_cast<int>(rootHeight)));
+    if (area.isEmpty()) {
+        return QImage();
+    }
+
+    if (!ensureSegment(static_cast<qsizetype>(rootWidth) * rootHeight * 4)) {
+        return QImage();
+    }
+
+    return read(m_root, area);
+}
+
+QImage X11ShmCapture::grabDrawable(unsigned long drawable, const QSize& size, int depth)
+{
+    if (!isAvailable() || size.isEmpty() || depth != m_depth) {
+        return QImage();
+    }
+
+    // Only grows: a window smaller than the root reuses the root-sized segment
+    if (!ensureSegment(static_cast<qsizetype>(size.width()) * size.height() * 4)) {
+        return QImage();
+    }
+
+    // The drawable belongs to another connection and may be freed at any time
+    X11ErrorTrap trap(m_display);
+    const QImage frame = read(drawable, QRect(QPoint(0, 0), size));
+    return trap.failed() ? QImage() : frame;
+}
+
+QImage X11ShmCapture::read(unsigned long drawable, const QRect& area)
+{
+    if (!ensureImage(area.size())) {
+        return QImage();
+    }
+
+    if (!XShmGetImage(m_display, drawable, m_image, area.x(), area.y(), AllPlanes)) {
+        qWarning() << "X11ShmCapture: XShmGetImage failed for" << area;
+        return QImage();
+    }
+
+    // Wraps the segment directly; the caller copies if it needs the frame past the next grab
+    return QImage(reinterpret_cast<const uchar*>(m_image->data),
+                  area.width(), area.height(), m_image->bytes_per_line, m_format);
+}
+
+#else
+
+X11ShmCapture& X11ShmCapture::instance()
+{
+    static X11ShmCapture capture;
+    return capture;
+}
+
+X11ShmCapture& X11ShmCapture::background()
+{
+    static X11ShmCapture capture;
+    return capture;
+}
+
+X11ShmCapture::~X11ShmCapture() = default;
+
+bool X11ShmCapture::isAvailable()
+{
+    return false;
+}
+
+QImage X11ShmCapture::grab(const QRect&)
+{
+    return QImage();
+}
+
+QImage X11ShmCapture::grabDrawable(unsigned long, const QSize&, int)
+{
+    return QImage();
+}
+
+void X11ShmCapture::releaseMemory()
+{
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QImage>
+#include <QRect>
+
+struct _XDisplay;
+struct _XImage;
+
+/**
+ * Zero-copy X11 screen grabber built on MIT-SHM
+ * XShmGetImage writes straight into a SysV shared memory segment that lives as
+ * long as the process; grab() hands that memory back as a QImage without
+ * copying. The segment is sized for the whole root window, so any
+ * sub-rectangle fits and repeated grabs of the same size allocate nothing.
+ *
+ * The returned image aliases the segment and is only valid until the next
+ * grab() - copy it (or convert it to a QPixmap) to keep it. instance() is for
+ * the GUI thread; background() has its own connection and segment and is for
+ * one worker thread at a time.
+ */
+class X11ShmCapture
+{
+public:
+    static X11ShmCapture& instance();
+    static X11ShmCapture& background();
+
+    // False on Wayland, remote displays without MIT-SHM, or unsupported visuals
+    bool isAvailable();
+
+    // rect is in root-window (device pixel) coordinates and is clipped to the screen
+    QImage grab(const QRect& rect);
+
+    // Whole of another drawable (e.g. a composite window pixmap) through the same segment;
+    // null if its depth isn't the root depth or the drawable is gone
+    QImage grabDrawable(unsigned long drawable, const QSize& size, int depth);
+
+    // Give the segment back until the next grab (the connection stays open)
+    void releaseMemory();
+
+private:
+    X11ShmCapture() = default;
+    ~X11ShmCapture();
+    X11ShmCapture(const X11ShmCapture&) = delete;
+    X11ShmCapture& operator=(const X11ShmCapture&) = delete;
+
+    bool initialize();
+    bool ensureSegment(qsizetype bytes);
+    bool ensureImage(const QSize& size);
+    QImage read(unsigned long drawable, const QRect& area);
+    void releaseSegment();
+    void releaseImage();
+
+    bool m_initialized = false;
+    bool m_available = false;
+
+    _XDisplay* m_display = nullptr;
+    unsigned long m_root = 0;
+    void* m_visual = nullptr;    // Visual*
+    int m_depth = 0;
+    QImage::Format m_format = QImage::Format_Invalid;
+
+    // Persistent SysV segment attached to the X server (wraps XShmSegmentInfo)
+    struct Segment;
+    Segment* m_segment = nullptr;
+
+    // XImage header over the segment; only rebuilt when the requested size changes
+    _XImage* m_image = nullptr;
+    QSize m_imageSize;
+};
@@ -11,6 +11,13 @@
 #include "ui/core/FloatingWidget.h"
 #include "system/SystemTray.h"
 #include "ui/core/ThemeManager.h"
+#include "system/CapabilityRegistry.h"
+#include "ocr/worker/OCRWorkerMain.h"
+#include "ocr/worker/OCRWorkerPool.h"
+#include "capture/WaylandScreenCast.h"
+#include "capture/X11ErrorTrap.h"
+#include "ui/overlays/LiveRegionTranslator.h"
+#include "ui/overlays/SavedRegionReader.h"
 
 #ifdef Q_OS_MACOS
 #include "system/PermissionsDialog.h"
@@ -25,6 +32,16 @@
 
 int main(int argc, char *argv[])
 {
+    // OCR worker processes reuse this binary headlessly: no QApplication, no single-instance lock
+    if (OCRWorkerMain::isWorkerInvocation(argc, argv)) {
+        return OCRWorkerMain::run(argc, argv);
+    }
+
+#ifdef Q_OS_LINUX
+    // Before Qt or anything else opens a Display: screen grabs use their own connection off the GUI thread
+    X11ErrorTrap::initThreads();
+#endif
+
     QApplication app(argc, argv);
 
 #ifdef _WIN32
@@ -57,6 +74,9 @@ int main(int argc, char *argv[])
     QCommandLineOption toggleOption("toggle", "Toggle widget visibility");
     parser.addOption(toggleOption);
 
+    QCommandLineOption regionOption("region", "Read saved region <n> (1-based)", "n");
+    parser.addOption(regionOption);
+
     parser.process(app);
 
     // Single instance check using shared memory
@@ -81,6 +101,9 @@ int main(int argc, char *argv[])
             } else if (parser.isSet(toggleOption)) {
                 qDebug() << "Sending toggle command to existing instance";
                 socket.write("toggle");
+            } else if (parser.isSet(regionOption)) {
+                qDebug() << "Sending saved region command to existing instance";
+                socket.write("region:" + parser.value(regionOption).toUtf8());
             } else {
                 qDebug() << "Activating existing instance";
                 socket.write("activate");
@@ -125,6 +148,9 @@ int main(int argc, char *argv[])
         qDebug() << "Successfully created shared memory lock";
     }
 
+    // Find tesseract/ImageMagick/edge-tts in the background while the UI comes up
+    CapabilityRegistry::instance().probeAsync();
+
     // Apply theme early so all widgets inherit styles
     ThemeManager::instance().applyFromSettings();
 
@@ -165,7 +191,17 @@ int main(int argc, char *argv[])
         QTimer::singleShot(100, widget, &FloatingWidget::takeScreenshot);
     } else if (parser.isSet(toggleOption)) {
         QTimer::singleShot(100, widget, &FloatingWidget::toggleVisibility);
+    } else if (parser.isSet(regionOption)) {
+        const int index = parser.value(regionOption).toInt() - 1;
+        QTimer::singleShot(100, widget, [index]() { SavedRegionReader::read(index); });
     }
 
-    return app.exec();
+    const int exitCode = app.exec();
+    // A live region's line jobs still use the worker pool; finish them before it goes
+    LiveRegionTranslator::stopActive();
+    SavedRegionReader::shutdown();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    OCRWorkerPool::instance().shutdown();
+    WaylandScreenCast::instance().stop();
+    return exitCode;
 }
\ No newline at end of file
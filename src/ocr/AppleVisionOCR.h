@@ -1,7 +1,7 @@
 #pragma once
 
 #include <QString>
-#include <QPixmap>
+#include <QImage>
 #include <QStringList>
 #include "OCREngine.h"
 
@@ -37,12 +37,12 @@ public:
     /**
      * Perform OCR on an image using Apple Vision framework
      * 
-     * @param image The image to process
+     * @param image The frame to process; read in place, so a view (ImageFrame) costs no copy
      * @param language Language hint (e.g., "en-US", "zh-CN") - optional, auto-detect if empty
      * @param level Recognition quality level
      * @return OCRResult with extracted text and token positions
      */
-    static OCRResult performOCR(const QPixmap& image, 
+    static OCRResult performOCR(const QImage& image, 
                                  const QString& language = QString(),
                                  RecognitionLevel level = Accurate);
 
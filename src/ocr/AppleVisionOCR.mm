@@ -9,32 +9,55 @@
 #include <QBuffer>
 #include <QDebug>
 
-// Helper function to convert QPixmap to CGImage
-static CGImageRef QPixmapToCGImage(const QPixmap& pixmap) {
-    QImage image = pixmap.toImage();
+// Releases the QImage a CGImage's data provider was reading from
+static void releaseImageData(void* info, const void*, size_t) {
+    delete static_cast<QImage*>(info);
+}
 
-    // Convert to ARGB32 format if needed
-    if (image.format() != QImage::Format_ARGB32) {
-        image = image.convertToFormat(QImage::Format_ARGB32);
+// Helper function to wrap a QImage in a CGImage without copying its pixels
+static CGImageRef QImageToCGImage(const QImage& frame) {
+    if (frame.isNull()) {
+        return NULL;
     }
 
-    // Create CGImage from QImage data
-    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGBitmapInfo alphaInfo;
+    QImage image = frame;
+    switch (image.format()) {
+    case QImage::Format_RGB32:
+        alphaInfo = kCGImageAlphaNoneSkipFirst;
+        break;
+    case QImage::Format_ARGB32:
+        alphaInfo = kCGImageAlphaFirst;
+        break;
+    case QImage::Format_ARGB32_Premultiplied:
+        alphaInfo = kCGImageAlphaPremultipliedFirst;
+        break;
+    default:
+        image = image.convertToFormat(QImage::Format_RGB32);
+        alphaInfo = kCGImageAlphaNoneSkipFirst;
+        break;
+    }
+
+    // The provider holds a shallow copy, so the pixels stay valid for as long as Vision keeps
+    // the CGImage. Its length stops at the last pixel: a view (ImageFrame) may share a larger frame
+    QImage* owner = new QImage(image);
+    const size_t length = size_t(owner->bytesPerLine()) * (owner->height() - 1) + size_t(owner->width()) * 4;
     CGDataProviderRef provider = CGDataProviderCreateWithData(
-        NULL,
-        image.constBits(),
-        image.sizeInBytes(),
-        NULL
+        owner,
+        owner->constBits(),
+        length,
+        releaseImageData
     );
 
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
     CGImageRef cgImage = CGImageCreate(
-        image.width(),
-        image.height(),
+        owner->width(),
+        owner->height(),
         8,
         32,
-        image.bytesPerLine(),
+        owner->bytesPerLine(),
         colorSpace,
-        kCGBitmapByteOrder32Host | kCGImageAlphaFirst,
+        kCGBitmapByteOrder32Host | alphaInfo,
         provider,
         NULL,
         false,
@@ -55,7 +78,7 @@ bool AppleVisionOCR::isAvailable() {
     return false;
 }
 
-OCRResult AppleVisionOCR::performOCR(const QPixmap& image, const QString& language, RecognitionLevel level) {
+OCRResult AppleVisionOCR::performOCR(const QImage& image, const QString& language, RecognitionLevel level) {
     OCRResult result;
     result.success = false;
 
@@ -66,11 +89,11 @@ OCRResult AppleVisionOCR::performOCR(const QPixmap& image, const QString& langua
     }
 
     @autoreleasepool {
-        // Convert QPixmap to CGImage
-        CGImageRef cgImage = QPixmapToCGImage(image);
+        // Wrap the QImage in a CGImage
+        CGImageRef cgImage = QImageToCGImage(image);
         if (!cgImage) {
             result.errorMessage = "Failed to convert image";
-            qWarning() << "AppleVisionOCR: Failed to convert QPixmap to CGImage";
+            qWarning() << "AppleVisionOCR: Failed to wrap QImage in a CGImage";
             return result;
         }
 
@@ -230,7 +253,7 @@ bool AppleVisionOCR::isAvailable() {
     return false;
 }
 
-OCRResult AppleVisionOCR::performOCR(const QPixmap& image, const QString& language, RecognitionLevel level) {
+OCRResult AppleVisionOCR::performOCR(const QImage& image, const QString& language, RecognitionLevel level) {
     OCRResult result;
     result.success = false;
     result.errorMessage = "Apple Vision OCR is only available on macOS";
@@ -1,9 +1,12 @@
 #include "OCREngine.h"
 #include "AppleVisionOCR.h"
 #include "engines/tesseract/TesseractEngine.h"
+#include "table/TableRecognizer.h"
 #include "TranslationEngine.h"
 #include "../common/Platform.h"
 #include "../ui/core/LanguageManager.h"
+#include "../system/CapabilityRegistry.h"
+#include "../system/TextAcquisition.h"
 #include <QDebug>
 #include <QBuffer>
 #include <QImageWriter>
@@ -13,11 +16,10 @@
 #include <QUrlQuery>
 #include <QRegularExpression>
 #include <QtMath>
-#include <functional>
+#include <utility>
 
 OCREngine::OCREngine(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
     , m_settings(new QSettings(QCoreApplication::organizationName(), QCoreApplication::applicationName(), this))
 {
     m_tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/ohao-lang-ocr";
@@ -64,13 +66,23 @@ OCREngine::~OCREngine()
     }
 }
 
-void OCREngine::cancel()
+void OCREngine::abort()
 {
     stopRunningProcess();
     if (!m_currentImagePath.isEmpty()) {
         QFile::remove(m_currentImagePath);
         m_currentImagePath.clear();
     }
+    if (m_translationEngineInstance) {
+        m_translationEngineInstance->cancel();
+    }
+    m_currentOCRResult = OCRResult();
+    m_candidateText.clear();
+}
+
+void OCREngine::cancel()
+{
+    abort();
     OCRResult cancelled;
     cancelled.success = false;
     cancelled.errorMessage = "OCR cancelled";
@@ -102,6 +114,11 @@ void OCREngine::setAutoDetectOrientation(bool enabled)
     m_autoDetectOrientation = enabled;
 }
 
+void OCREngine::setTableMode(bool enabled)
+{
+    m_tableMode = enabled;
+}
+
 void OCREngine::setAutoTranslate(bool enabled)
 {
     m_autoTranslate = enabled;
@@ -122,7 +139,7 @@ void OCREngine::setTranslationTargetLanguage(const QString &language)
     m_translationTargetLanguage = language;
 }
 
-void OCREngine::performOCR(const QPixmap &image)
+void OCREngine::performOCR(const QImage &image)
 {
     if (image.isNull()) {
         emit ocrError("Invalid image provided for OCR");
@@ -144,7 +161,40 @@ void OCREngine::performOCR(const QPixmap &image)
     }
 }
 
-void OCREngine::performAppleVisionOCR(const QPixmap &image)
+void OCREngine::setCandidateText(const QString &text)
+{
+    m_candidateText = text;
+}
+
+void OCREngine::applyCandidateText()
+{
+    const QString candidate = std::exchange(m_candidateText, QString());
+    if (candidate.isEmpty() || !m_currentOCRResult.success) {
+        return;
+    }
+    if (!TextAcquisition::agrees(candidate, m_currentOCRResult.text)) {
+        qDebug() << "OCREngine: PRIMARY selection doesn't match the OCR text, keeping the OCR text";
+        return;
+    }
+    // The application's exact characters; tokens keep the OCR boxes for layout
+    qDebug() << "OCREngine: PRIMARY selection matches the OCR text, using it";
+    m_currentOCRResult.text = candidate;
+}
+
+void OCREngine::useRecognised(const OCRResult &result)
+{
+    stopRunningProcess();
+
+    m_currentOCRResult = result;
+    applyCandidateText();
+    if (m_autoTranslate && !m_currentOCRResult.text.isEmpty()) {
+        startTranslation(m_currentOCRResult.text);
+    } else {
+        emit ocrFinished(m_currentOCRResult);
+    }
+}
+
+void OCREngine::performAppleVisionOCR(const QImage &image)
 {
 #ifdef Q_OS_MACOS
     if (!AppleVisionOCR::isAvailable()) {
@@ -175,14 +225,15 @@ void OCREngine::performAppleVisionOCR(const QPixmap &image)
 
     // Store the OCR result and start translation if auto-translate is enabled
     m_currentOCRResult = result;
+    applyCandidateText();
 
     // Ensure tokens exist before emitting or starting translation
     if (result.success) {
         ensureTokensExist(m_currentOCRResult, image.size());
     }
 
-    if (result.success && m_autoTranslate && !result.text.isEmpty()) {
-        startTranslation(result.text);
+    if (result.success && m_autoTranslate && !m_currentOCRResult.text.isEmpty()) {
+        startTranslation(m_currentOCRResult.text);
     } else {
         emit ocrFinished(m_currentOCRResult);
     }
@@ -191,7 +242,7 @@ void OCREngine::performAppleVisionOCR(const QPixmap &image)
 #endif
 }
 
-void OCREngine::performTesseractOCR(const QPixmap &image)
+void OCREngine::performTesseractOCR(const QImage &image)
 {
     // ========== MODULAR DELEGATION - Clean and Simple ==========
     // All Tesseract logic lives in engines/tesseract/ module
@@ -199,14 +250,32 @@ void OCREngine::performTesseractOCR(const QPixmap &image)
 
     emit ocrProgress("Starting Tesseract OCR...");
 
+    // Table mode: recognise cells in parallel; fall back to paragraph OCR when no grid is found
+    m_currentOCRResult = OCRResult();
+    if (m_tableMode) {
+        emit ocrProgress("Detecting table structure...");
+        m_currentOCRResult = TableRecognizer::recognize(
+            image,
+            m_language,
+            m_qualityLevel,
+            m_preprocessing,
+            m_autoDetectOrientation
+        );
+        if (!m_currentOCRResult.success) {
+            qDebug() << "OCREngine: Table mode found no grid, using regular OCR:" << m_currentOCRResult.errorMessage;
+        }
+    }
+
     // Delegate to TesseractEngine module
-    m_currentOCRResult = TesseractEngine::performOCR(
-        image,
-        m_language,
-        m_qualityLevel,
-        m_preprocessing,
-        m_autoDetectOrientation
-    );
+    if (!m_currentOCRResult.success) {
+        m_currentOCRResult = TesseractEngine::performOCR(
+            image,
+            m_language,
+            m_qualityLevel,
+            m_preprocessing,
+            m_autoDetectOrientation
+        );
+    }
 
     // Handle result
     if (!m_currentOCRResult.success || m_currentOCRResult.text.isEmpty()) {
@@ -214,9 +283,11 @@ void OCREngine::performTesseractOCR(const QPixmap &image)
         if (errorMsg.isEmpty()) {
             errorMsg = "OCR failed to extract text";
         }
+        m_candidateText.clear();
         emit ocrError(errorMsg);
         return;
     }
+    applyCandidateText();
 
     // TEMPORARILY DISABLED: Apply Hunspell spellcheck correction (testing if it causes issues)
     // auto spellChecker = getSpellChecker(m_language);
@@ -238,6 +309,11 @@ QString OCREngine::preprocessImage(const QString &imagePath)
     // Simple preprocessing using ImageMagick (if available) or fallback
     QString outputPath = m_tempDir + "/preprocessed_" + QFileInfo(imagePath).fileName();
 
+    const QString imageMagick = CapabilityRegistry::instance().imageMagickPath();
+    if (imageMagick.isEmpty()) {
+        return imagePath;
+    }
+
     QProcess process;
     QStringList arguments;
 
@@ -248,7 +324,7 @@ QString OCREngine::preprocessImage(const QString &imagePath)
     arguments << "-sharpen" << "0x1.0";
     arguments << outputPath;
 
-    process.start("convert", arguments);
+    process.start(imageMagick, arguments);
     if (process.waitForFinished(10000) && process.exitCode() == 0) {
         return outputPath;
     }
@@ -452,66 +528,8 @@ bool OCREngine::isAppleVisionAvailable()
 
 QString OCREngine::findTesseractExecutable()
 {
-    // Helper function to recursively search for tesseract executable
-    // Returns empty string if not found
-
-#ifdef Q_OS_WIN
-    QString exeName = "tesseract.exe";
-#else
-    QString exeName = "tesseract";
-#endif
-
-    // Helper lambda for recursive directory search with depth limit
-    std::function<QString(const QString&, int)> searchDirectory = [&](const QString& dirPath, int maxDepth) -> QString {
-        if (maxDepth <= 0) return QString();
-
-        QDir dir(dirPath);
-        if (!dir.exists()) return QString();
-
-        // Check current directory for tesseract executable
-        QString candidatePath = dir.filePath(exeName);
-        if (QFile::exists(candidatePath)) {
-            // Verify it's a valid executable by running --version
-            QProcess process;
-            process.start(candidatePath, QStringList() << "--version");
-            if (process.waitForFinished(3000) && process.exitCode() == 0) {
-                qDebug() << "Found Tesseract at:" << candidatePath;
-                return candidatePath;
-            }
-        }
-
-        // Recursively search subdirectories
-        QStringList subdirs = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-        for (const QString& subdir : subdirs) {
-            QString found = searchDirectory(dir.filePath(subdir), maxDepth - 1);
-            if (!found.isEmpty()) {
-                return found;
-            }
-        }
-
-        return QString();
-    };
-
-    // Search order as requested by user:
-    // 1. Current directory (applicationDirPath)
-    // 2. Current subdirectories recursively (depth 3)
-    QString appDir = QCoreApplication::applicationDirPath();
-    qDebug() << "Searching for Tesseract in application directory:" << appDir;
-    QString found = searchDirectory(appDir, 3);
-    if (!found.isEmpty()) {
-        return found;
-    }
-
-    // 3. System PATH - check if "tesseract" command works
-    QProcess process;
-    process.start("tesseract", QStringList() << "--version");
-    if (process.waitForFinished(3000) && process.exitCode() == 0) {
-        qDebug() << "Found Tesseract in system PATH";
-        return "tesseract"; // Return command name for PATH-based execution
-    }
-
-    qDebug() << "Tesseract not found in application directory, subdirectories, or system PATH";
-    return QString(); // Not found
+    // Bundled copy, app subdirectories, then PATH - resolved once by the capability registry
+    return CapabilityRegistry::instance().tesseractPath();
 }
 
 bool OCREngine::isTesseractAvailable()
@@ -530,10 +548,8 @@ void OCREngine::startTranslation(const QString &text)
                 this, &OCREngine::onTranslationError);
         connect(m_translationEngineInstance, &TranslationEngine::translationProgress,
                 this, &OCREngine::ocrProgress);
-
-        // Only Google Translate is supported (free, no API key needed)
-        m_translationEngineInstance->setEngine(TranslationEngine::GoogleTranslate);
     }
+    m_translationEngineInstance->setEngine(TranslationEngine::engineForName(m_translationEngine));
 
     // FIX: Always use Auto-Detect for best translation results
     // Google Translate's auto-detection is more reliable than OCR language detection
@@ -551,6 +567,19 @@ void OCREngine::startTranslation(const QString &text)
              << "Target:" << m_translationTargetLanguage;
 
     emit ocrProgress("Starting translation...");
+
+    // Table mode: one segment per cell so each translation maps back onto its cell
+    if (!m_currentOCRResult.table.isEmpty()) {
+        QStringList cells;
+        for (const QStringList &row : m_currentOCRResult.table) {
+            for (const QString &cell : row) {
+                if (!cell.isEmpty()) cells << cell;
+            }
+        }
+        m_translationEngineInstance->translateSegments(cells);
+        return;
+    }
+
     m_translationEngineInstance->translate(text);
 }
 
@@ -562,7 +591,11 @@ void OCREngine::onTranslationFinished(const TranslationResult &translationResult
         m_currentOCRResult.translatedText = translationResult.translatedText;
         m_currentOCRResult.sourceLanguage = translationResult.sourceLanguage;
         m_currentOCRResult.targetLanguage = translationResult.targetLanguage;
-        emit ocrProgress("Translation completed successfully!");
+        if (!m_currentOCRResult.table.isEmpty() && !applyTableTranslation(translationResult.segments)) {
+            emit ocrProgress("Translation doesn't match the table cells - showing it as plain text");
+        } else {
+            emit ocrProgress("Translation completed successfully!");
+        }
     } else {
         m_currentOCRResult.translatedText = "Translation failed: " + translationResult.errorMessage;
         emit ocrProgress("Translation failed: " + translationResult.errorMessage);
@@ -576,6 +609,35 @@ void OCREngine::onTranslationFinished(const TranslationResult &translationResult
     emit ocrFinished(m_currentOCRResult);
 }
 
+bool OCREngine::applyTableTranslation(const QStringList &translatedCells)
+{
+    int cellCount = 0;
+    for (const QStringList &row : m_currentOCRResult.table) {
+        for (const QString &cell : row) {
+            if (!cell.isEmpty()) ++cellCount;
+        }
+    }
+
+    // One segment per cell makes this a safety net; without a match only the flat text can be shown
+    if (translatedCells.size() != cellCount) {
+        qDebug() << "OCREngine: Table translation returned" << translatedCells.size()
+                 << "segments for" << cellCount << "cells";
+        return false;
+    }
+
+    int next = 0;
+    m_currentOCRResult.translatedTable.clear();
+    for (const QStringList &row : m_currentOCRResult.table) {
+        QStringList translatedRow;
+        for (const QString &cell : row) {
+            translatedRow << (cell.isEmpty() ? QString() : translatedCells[next++].trimmed());
+        }
+        m_currentOCRResult.translatedTable.append(translatedRow);
+    }
+    m_currentOCRResult.translatedText = TableRecognizer::toTsv(m_currentOCRResult.translatedTable);
+    return true;
+}
+
 void OCREngine::onTranslationError(const QString &error)
 {
     m_currentOCRResult.hasTranslation = false;
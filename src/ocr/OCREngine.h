@@ -2,7 +2,8 @@
 
 #include <QObject>
 #include <QString>
-#include <QPixmap>
+#include <QStringList>
+#include <QImage>
 #include <QProcess>
 #include <QSettings>
 #include <QTemporaryFile>
@@ -40,6 +41,8 @@ struct OCRResult {
         int      lineId = -1;
     };
     QVector<OCRToken> tokens; // populated when engine returns positional data
+    QVector<QStringList> table;           // table mode: rows of cell text (text holds the TSV)
+    QVector<QStringList> translatedTable; // table mode: per-cell translation, same shape as table
 };
 
 class OCREngine : public QObject
@@ -60,12 +63,19 @@ public:
     void setQualityLevel(int level); // 1-5 scale
     void setPreprocessing(bool enabled);
     void setAutoDetectOrientation(bool enabled);
+    void setTableMode(bool enabled);
 
     Engine currentEngine() const { return m_engine; }
     QString currentLanguage() const { return m_language; }
 
-    // Main OCR function
-    void performOCR(const QPixmap &image);
+    // Main OCR function; image is a captured frame or a view into one (ImageFrame)
+    void performOCR(const QImage &image);
+    // Takes a result recognised ahead of time (SpeculativeAnalyzer) as if performOCR had
+    // produced it: only translation and the usual signals are left
+    void useRecognised(const OCRResult &result);
+    // Text another application reported for the next image (the PRIMARY selection). It stands
+    // in for the recognised text only if TextAcquisition::agrees() with it; used once
+    void setCandidateText(const QString &text);
 
     // Translation settings
     void setAutoTranslate(bool enabled);
@@ -79,6 +89,9 @@ public:
 
     // Concurrency helpers
     bool isBusy() const { return m_process && m_process->state() != QProcess::NotRunning; }
+    // Stops OCR and translation in flight without emitting anything; the requester has gone away
+    void abort();
+
 public slots:
     void cancel();
 
@@ -93,12 +106,15 @@ private slots:
     void onTranslationError(const QString &error);
 
 private:
-    void performAppleVisionOCR(const QPixmap &image);
-    void performTesseractOCR(const QPixmap &image);
+    void performAppleVisionOCR(const QImage &image);
+    void performTesseractOCR(const QImage &image);
 
     QString preprocessImage(const QString &imagePath);
     // REMOVED: getTesseractLanguageCode - use LanguageManager::instance().getTesseractCode() instead
     void startTranslation(const QString &text);
+    void applyCandidateText();
+    // false when the translations don't match the cells one to one
+    bool applyTableTranslation(const QStringList &translatedCells);
     QString mergeParagraphLines(const QStringList &lines, const QVector<OCRResult::OCRToken> &tokens);
 
     // Helper to ensure tokens are always provided
@@ -119,6 +135,7 @@ private:
     int m_qualityLevel = 3;
     bool m_preprocessing = true;
     bool m_autoDetectOrientation = true;
+    bool m_tableMode = false;
 
     // Translation settings - no hardcoded defaults, loaded from user settings
     bool m_autoTranslate = false;
@@ -128,9 +145,9 @@ private:
 
     OCRResult m_currentOCRResult;
     TranslationEngine *m_translationEngineInstance = nullptr;
+    QString m_candidateText;
 
     QProcess *m_process = nullptr;
-    QNetworkAccessManager *m_networkManager = nullptr;
     // Replace QTemporaryFile* with persistent image path we manage manually
     QString m_currentImagePath;
     QString m_tempDir;
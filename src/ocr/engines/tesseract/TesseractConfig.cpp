@@ -11,14 +11,14 @@ QString getLanguageCode(const QString& displayName)
 
 // Character whitelist removed; plain text path relies on full language model
 
-int getPSMForQualityLevel(int qualityLevel)
+int getPSMForQualityLevel(int qualityLevel, bool nativeOrientation)
 {
     switch (qualityLevel) {
     case 1: return 8;  // Single word
     case 2: return 7;  // Single text line
     case 3: return 6;  // Uniform block of text
     case 4: return 3;  // Fully automatic page segmentation
-    case 5: return 1;  // Automatic with OSD
+    case 5: return nativeOrientation ? 3 : 1;  // Automatic with OSD, unless Deskew already handled it
     default: return 6;
     }
 }
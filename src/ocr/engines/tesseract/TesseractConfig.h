@@ -5,6 +5,7 @@
 
 namespace TesseractConfig {
     QString getLanguageCode(const QString& displayName);
-    int getPSMForQualityLevel(int qualityLevel);
+    // nativeOrientation: the crop was already rotated upright, so skip OSD (PSM 1)
+    int getPSMForQualityLevel(int qualityLevel, bool nativeOrientation = false);
     bool shouldUseLSTM(const QString& language, int qualityLevel, bool autoDetectOrientation);
 }
@@ -1,5 +1,9 @@
 #include "TesseractEngine.h"
 #include "TesseractConfig.h"
+#include "../../preprocessing/Deskew.h"
+#include "../../preprocessing/TextLayerSeparator.h"
+#include "../../worker/OCRWorkerPool.h"
+#include "../../../system/CapabilityRegistry.h"
 #include <QProcess>
 #include <QStandardPaths>
 #include <QDir>
@@ -8,62 +12,113 @@
 #include <QDateTime>
 #include <QFile>
 #include <QMessageBox>
+#include <QThread>
+#include <QUuid>
+#include <QDebug>
 
 bool TesseractEngine::isAvailable()
 {
-    QString tesseractPath = findTesseractExecutable();
-    return !tesseractPath.isEmpty();
+    // Answered from the startup probe - no process spawn per request
+    return CapabilityRegistry::instance().hasTesseract();
 }
 
 OCRResult TesseractEngine::performOCR(
-    const QPixmap& image,
+    const QImage& image,
+    const QString& language,
+    int qualityLevel,
+    bool preprocessing,
+    bool autoDetectOrientation,
+    int psmOverride,
+    const std::atomic_bool* cancelled)
+{
+    OCRWorkerPool& pool = OCRWorkerPool::instance();
+    if (pool.isEnabled()) {
+        OCRResult pooled;
+        if (pool.recognize(image, language, qualityLevel, preprocessing, autoDetectOrientation, psmOverride,
+                           pooled, cancelled)) {
+            return pooled;
+        }
+        if (cancelled && cancelled->load()) {
+            pooled.success = false;
+            pooled.errorMessage = "OCR cancelled";
+            return pooled;
+        }
+        qDebug() << "TesseractEngine: worker pool unavailable, running in-process";
+    }
+    return performOCRInProcess(image, language, qualityLevel, preprocessing, autoDetectOrientation, psmOverride);
+}
+
+QImage TesseractEngine::prepareImage(
+    const QImage& image,
+    bool preprocessing,
+    bool autoDetectOrientation,
+    bool* nativeOrientation)
+{
+    // Pull the text layer out as dark-on-light so themed/coloured UIs recognise first time.
+    // Either way the frame goes to Grayscale8 here, once; Deskew and Tesseract keep it that way
+    QImage prepared = preprocessing
+        ? TextLayerSeparator::separate(image)
+        : image.convertToFormat(QImage::Format_Grayscale8);
+
+    // Rotate the crop upright ourselves instead of paying for Tesseract OSD
+    bool handled = false;
+    if (autoDetectOrientation) {
+        Deskew::Estimate estimate = Deskew::estimate(prepared);
+        if (estimate.confident) {
+            handled = true;
+            prepared = Deskew::correct(prepared, estimate);
+        }
+    }
+
+    if (nativeOrientation) {
+        *nativeOrientation = handled;
+    }
+    return prepared;
+}
+
+OCRResult TesseractEngine::performOCRInProcess(
+    const QImage& image,
     const QString& language,
     int qualityLevel,
     bool preprocessing,
-    bool autoDetectOrientation)
+    bool autoDetectOrientation,
+    int psmOverride)
 {
     OCRResult result;
     result.success = false;
 
     if (!isAvailable()) {
+        CapabilityRegistry& registry = CapabilityRegistry::instance();
+        if (!registry.isReady()) {
+            result.errorMessage = "Still looking for Tesseract, try again in a moment";
+            return result;
+        }
         result.errorMessage = "Bundled Tesseract not found";
-        QMessageBox::critical(nullptr, "OCR Error", "Bundled Tesseract not found at: " + QCoreApplication::applicationDirPath() + "/tesseract/tesseract.exe");
+        reportError("Bundled Tesseract not found at: " + QCoreApplication::applicationDirPath() + "/tesseract/tesseract.exe");
+        // The user may install it after reading this; the next request looks again
+        registry.refresh();
         return result;
     }
 
     // Save image to temp file
     QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/ohao-ocr";
     QDir().mkpath(tempDir);
-    QString imagePath = tempDir + "/img_" + QString::number(QDateTime::currentMSecsSinceEpoch()) + ".png";
+    // UUID keeps names unique when several cells are recognised in the same millisecond
+    // PGM is the grayscale bytes plus a header: no compression pass for a file read once
+    QString imagePath = tempDir + "/img_" + QUuid::createUuid().toString(QUuid::WithoutBraces) + ".pgm";
+
+    bool nativeOrientation = false;
+    QImage ocrImage = prepareImage(image, preprocessing, autoDetectOrientation, &nativeOrientation);
 
-    if (!image.save(imagePath, "PNG")) {
+    if (!ocrImage.save(imagePath, "PGM")) {
         result.errorMessage = "Failed to save image";
         return result;
     }
 
-    // Preprocess image if enabled (grayscale, sharpen, contrast)
-    QString processedImagePath = imagePath;
-    if (preprocessing) {
-        QProcess convertProcess;
-        QString preprocessedPath = imagePath;
-        preprocessedPath.replace(".png", "_preprocessed.png");
-
-        QStringList convertArgs;
-        convertArgs << imagePath;
-        convertArgs << "-colorspace" << "Gray";       // Grayscale
-        convertArgs << "-sharpen" << "0x1";           // Sharpen edges
-        convertArgs << "-contrast-stretch" << "0";    // Auto contrast
-        convertArgs << preprocessedPath;
-
-        convertProcess.start("convert", convertArgs);
-        if (convertProcess.waitForFinished(10000) && convertProcess.exitCode() == 0) {
-            processedImagePath = preprocessedPath;
-        }
-    }
-
     // Build Tesseract arguments (plain text output for maximal compatibility)
+    // No ImageMagick pass: prepareImage() already made the crop dark-on-light grayscale
     QStringList arguments;
-    arguments << processedImagePath;  // Use preprocessed image
+    arguments << imagePath;
     arguments << "stdout";  // Output to stdout (plain text)
 
     // Tessdata directory
@@ -76,10 +131,15 @@ OCRResult TesseractEngine::performOCR(
     QString langCode = TesseractConfig::getLanguageCode(language);
     if (!langCode.isEmpty()) {
         arguments << "-l" << langCode;
+        if (!CapabilityRegistry::instance().hasTessdataLanguage(langCode)) {
+            qWarning() << "TesseractEngine: traineddata for" << langCode << "is not installed";
+        }
     }
 
     // PSM (Page Segmentation Mode)
-    int psm = TesseractConfig::getPSMForQualityLevel(qualityLevel);
+    int psm = psmOverride > 0
+        ? psmOverride
+        : TesseractConfig::getPSMForQualityLevel(qualityLevel, nativeOrientation);
     arguments << "--psm" << QString::number(psm);
 
     // OCR Engine Mode (OEM)
@@ -115,65 +175,18 @@ OCRResult TesseractEngine::performOCR(
 
     // Cleanup temp files
     QFile::remove(imagePath);
-    if (processedImagePath != imagePath) {
-        QFile::remove(processedImagePath);
-    }
 
     return result;
 }
 
 QString TesseractEngine::findTesseractExecutable()
 {
-    QString appDir = QCoreApplication::applicationDirPath();
-#ifdef Q_OS_WIN
-    QString path = appDir + "/tesseract/tesseract.exe";
-#else
-    QString path = appDir + "/tesseract/tesseract";
-#endif
-
-    QProcess process;
-    process.start(path, QStringList() << "--version");
-    if (process.waitForFinished(3000) && process.exitCode() == 0) {
-        return path;
-    }
-    return QString();
+    return CapabilityRegistry::instance().tesseractPath();
 }
 
 QString TesseractEngine::findTessdataDirectory()
 {
-    QString appDir = QCoreApplication::applicationDirPath();
-
-    // 1) Bundled tessdata next to the app (preferred per request)
-    QString bundled = appDir + "/tesseract/tessdata";
-    if (QFile::exists(bundled + "/eng.traineddata")) {
-        qDebug() << "Using bundled tessdata:" << bundled;
-        return bundled;
-    }
-
-    // 2) Allow TESSDATA_PREFIX override
-    if (!qEnvironmentVariableIsEmpty("TESSDATA_PREFIX")) {
-        QString prefix = QString::fromUtf8(qgetenv("TESSDATA_PREFIX"));
-        QString candidate = prefix.endsWith("/tessdata") || prefix.endsWith("\\tessdata")
-            ? prefix
-            : (prefix + "/tessdata");
-        if (QFile::exists(candidate + "/eng.traineddata")) {
-            qDebug() << "Using tessdata from TESSDATA_PREFIX:" << candidate;
-            return candidate;
-        }
-    }
-
-    // 3) Fall back to system installation (Scoop path)
-#ifdef Q_OS_WIN
-    QString home = QDir::homePath();
-    QString scoopTessdata = home + "/scoop/persist/tesseract/tessdata";
-    if (QFile::exists(scoopTessdata + "/eng.traineddata")) {
-        qDebug() << "Using Scoop tessdata:" << scoopTessdata;
-        return scoopTessdata;
-    }
-#endif
-
-    qDebug() << "WARNING: No tessdata directory found!";
-    return QString();
+    return CapabilityRegistry::instance().tessdataDirectory();
 }
 
 QString TesseractEngine::runTesseractProcess(const QStringList& arguments)
@@ -188,13 +201,13 @@ QString TesseractEngine::runTesseractProcess(const QStringList& arguments)
     process.start(tesseractPath, arguments);
 
     if (!process.waitForStarted(5000)) {
-        QMessageBox::critical(nullptr, "OCR Error", "Failed to start Tesseract process");
+        reportError("Failed to start Tesseract process");
         return QString();
     }
 
     if (!process.waitForFinished(60000)) {
         process.kill();
-        QMessageBox::critical(nullptr, "OCR Error", "Tesseract process timed out");
+        reportError("Tesseract process timed out");
         return QString();
     }
 
@@ -211,8 +224,7 @@ QString TesseractEngine::runTesseractProcess(const QStringList& arguments)
     qDebug() << "Tesseract UTF-8 decoded (first 200 chars):" << output.left(200);
 
     if (process.exitCode() != 0) {
-        QMessageBox::critical(nullptr, "OCR Error",
-            "Tesseract failed with exit code " + QString::number(process.exitCode()) +
+        reportError("Tesseract failed with exit code " + QString::number(process.exitCode()) +
             "\nError: " + errorOutput);
         return QString();
     }
@@ -220,4 +232,15 @@ QString TesseractEngine::runTesseractProcess(const QStringList& arguments)
     return output;
 }
 
+void TesseractEngine::reportError(const QString& message)
+{
+    // Message boxes need a QApplication and the GUI thread; worker threads/processes just log
+    QCoreApplication* app = QCoreApplication::instance();
+    if (app && app->inherits("QApplication") && QThread::currentThread() == app->thread()) {
+        QMessageBox::critical(nullptr, "OCR Error", message);
+    } else {
+        qWarning() << "OCR Error:" << message;
+    }
+}
+
 // TSV parsing removed; plain text mode only
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <QString>
-#include <QPixmap>
+#include <QImage>
+#include <atomic>
 #include "../../OCREngine.h"
 
 /**
@@ -12,16 +13,45 @@ class TesseractEngine
 {
 public:
     static bool isAvailable();
+
+    // Thread-safe; also used for concurrent cell recognition.
+    // psmOverride > 0 replaces the quality-level PSM (e.g. 7 for single-line cells).
+    // Routed through the OCR worker pool when enabled, in-process otherwise.
+    // Setting *cancelled abandons a pooled request (success == false); an in-process run finishes.
     static OCRResult performOCR(
-        const QPixmap& image,
+        const QImage& image,
+        const QString& language,
+        int qualityLevel,
+        bool preprocessing,
+        bool autoDetectOrientation,
+        int psmOverride = 0,
+        const std::atomic_bool* cancelled = nullptr
+    );
+
+    // Always runs in this process (used by the worker processes themselves)
+    static OCRResult performOCRInProcess(
+        const QImage& image,
         const QString& language,
         int qualityLevel,
         bool preprocessing,
-        bool autoDetectOrientation
+        bool autoDetectOrientation,
+        int psmOverride = 0
     );
 
+    // Native preprocessing shared by the CLI and libtesseract paths; always returns Grayscale8,
+    // the only grayscale conversion a frame goes through.
+    // nativeOrientation is set when Deskew handled orientation (PSM can skip OSD).
+    static QImage prepareImage(
+        const QImage& image,
+        bool preprocessing,
+        bool autoDetectOrientation,
+        bool* nativeOrientation = nullptr
+    );
+
+    static QString findTessdataDirectory();
+
 private:
     static QString findTesseractExecutable();
-    static QString findTessdataDirectory();
     static QString runTesseractProcess(const QStringList& arguments);
+    static void reportError(const QString& message);
 };
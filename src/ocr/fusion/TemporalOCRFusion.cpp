@@ -0,0 +1,217 @@
+#include "TemporalOCRFusion.h"
+#include <QHash>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+constexpr float MIN_WEIGHT = 0.05f;           // Even a zero-confidence word keeps a small say
+constexpr float CONFIDENT_WEIGHT = 0.85f;     // A single reading this confident is shown right away
+constexpr double NEW_TEXT_DISTANCE = 0.5;     // Edit distance (fraction of length) that means a new line
+
+// Levenshtein distance over UTF-16 units, two rows
+int editDistance(const QString &a, const QString &b)
+{
+    QVector<int> previous(b.size() + 1);
+    QVector<int> current(b.size() + 1);
+    std::iota(previous.begin(), previous.end(), 0);
+    for (int i = 1; i <= a.size(); ++i) {
+        current[0] = i;
+        for (int j = 1; j <= b.size(); ++j) {
+            const int substitution = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+            current[j] = std::min({ substitution, previous[j] + 1, current[j - 1] + 1 });
+        }
+        std::swap(previous, current);
+    }
+    return previous[b.size()];
+}
+
+// One reading laid onto the reference: the character (or nothing) at each reference
+// position, and whatever the reading has in the gaps before each position and at the end
+struct Alignment {
+    QVector<QString> aligned;          // reference size
+    QVector<float> alignedWeight;
+    QVector<QString> inserted;         // reference size + 1
+    QVector<float> insertedWeight;     // Sum over the inserted characters
+};
+
+Alignment align(const QString &reference, const QString &text, const QVector<float> &weights)
+{
+    const int n = reference.size();
+    const int m = text.size();
+    QVector<int> table((n + 1) * (m + 1));
+    auto at = [&table, m](int i, int j) -> int & { return table[i * (m + 1) + j]; };
+    for (int i = 0; i <= n; ++i) at(i, 0) = i;
+    for (int j = 0; j <= m; ++j) at(0, j) = j;
+    for (int i = 1; i <= n; ++i) {
+        for (int j = 1; j <= m; ++j) {
+            const int substitution = at(i - 1, j - 1) + (reference[i - 1] == text[j - 1] ? 0 : 1);
+            at(i, j) = std::min({ substitution, at(i - 1, j) + 1, at(i, j - 1) + 1 });
+        }
+    }
+
+    Alignment alignment;
+    alignment.aligned.resize(n);
+    alignment.alignedWeight.fill(0.f, n);
+    alignment.inserted.resize(n + 1);
+    alignment.insertedWeight.fill(0.f, n + 1);
+
+    int i = n;
+    int j = m;
+    while (i > 0 || j > 0) {
+        if (i > 0 && j > 0 && at(i, j) == at(i - 1, j - 1) + (reference[i - 1] == text[j - 1] ? 0 : 1)) {
+            alignment.aligned[i - 1] = text[j - 1];
+            alignment.alignedWeight[i - 1] = weights[j - 1];
+            --i;
+            --j;
+        } else if (i > 0 && at(i, j) == at(i - 1, j) + 1) {
+            --i; // Reading dropped this reference character
+        } else {
+            alignment.inserted[i].prepend(text[j - 1]);
+            alignment.insertedWeight[i] += weights[j - 1];
+            --j;
+        }
+    }
+    return alignment;
+}
+
+// Highest vote wins; ties keep the reference's choice so the output doesn't flip between equals
+QString winner(const QHash<QString, float> &votes, const QString &referenceChoice)
+{
+    QString best = referenceChoice;
+    float bestWeight = votes.value(referenceChoice, 0.f);
+    for (auto it = votes.cbegin(); it != votes.cend(); ++it) {
+        if (it.value() > bestWeight) {
+            best = it.key();
+            bestWeight = it.value();
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+TemporalOCRFusion::TemporalOCRFusion(int windowSize)
+    : m_windowSize(qMax(1, windowSize))
+{
+}
+
+QVector<float> TemporalOCRFusion::characterWeights(const QString &text, const QVector<OCRResult::OCRToken> &tokens,
+                                                   float fullScale)
+{
+    QVector<float> weights(text.size(), 1.f);
+    int position = 0;
+    for (const OCRResult::OCRToken &token : tokens) {
+        const QString word = token.text.simplified();
+        if (word.isEmpty() || token.confidence < 0.f) {
+            continue;
+        }
+        const int start = text.indexOf(word, position);
+        if (start < 0) {
+            continue;
+        }
+        const float weight = qBound(MIN_WEIGHT, token.confidence / fullScale, 1.f);
+        // The word plus the space after it
+        const int end = qMin(static_cast<int>(text.size()), start + static_cast<int>(word.size()) + 1);
+        std::fill(weights.begin() + start, weights.begin() + end, weight);
+        position = start + static_cast<int>(word.size());
+    }
+    return weights;
+}
+
+QString TemporalOCRFusion::add(const QString &text, const QVector<float> &weights)
+{
+    const QString reading = text.simplified();
+    if (reading.isEmpty()) {
+        reset();
+        return QString();
+    }
+
+    // Too different from what the window agreed on: the line now shows something else
+    if (!m_fused.isEmpty()) {
+        const int longest = qMax(reading.size(), m_fused.size());
+        if (editDistance(reading, m_fused) > NEW_TEXT_DISTANCE * longest) {
+            m_window.clear();
+        }
+    }
+
+    Reading entry;
+    entry.text = reading;
+    entry.weights = weights.size() == reading.size() ? weights : QVector<float>(reading.size(), 1.f);
+    entry.meanWeight = std::accumulate(entry.weights.cbegin(), entry.weights.cend(), 0.f) / entry.weights.size();
+    m_window.append(entry);
+    while (m_window.size() > m_windowSize) {
+        m_window.removeFirst();
+    }
+
+    m_fused = fuse();
+    return m_fused;
+}
+
+bool TemporalOCRFusion::isConfirmed() const
+{
+    return m_window.size() >= 2 || (m_window.size() == 1 && m_window.first().meanWeight >= CONFIDENT_WEIGHT);
+}
+
+void TemporalOCRFusion::reset()
+{
+    m_window.clear();
+    m_fused.clear();
+}
+
+QString TemporalOCRFusion::fuse() const
+{
+    if (m_window.size() == 1) {
+        return m_window.first().text;
+    }
+
+    // The medoid (closest to every other reading) is the alignment reference
+    int referenceIndex = 0;
+    int bestTotal = std::numeric_limits<int>::max();
+    for (int i = 0; i < m_window.size(); ++i) {
+        int total = 0;
+        for (int j = 0; j < m_window.size(); ++j) {
+            if (i != j) total += editDistance(m_window[i].text, m_window[j].text);
+        }
+        if (total < bestTotal) {
+            bestTotal = total;
+            referenceIndex = i;
+        }
+    }
+    const QString &reference = m_window[referenceIndex].text;
+    const int n = reference.size();
+
+    QVector<Alignment> alignments;
+    for (const Reading &reading : m_window) {
+        alignments.append(align(reference, reading.text, reading.weights));
+    }
+
+    QString fused;
+    for (int position = 0; position <= n; ++position) {
+        // Extra characters in the gap before this position; not inserting counts at the reading's mean weight
+        QHash<QString, float> insertionVotes;
+        for (int r = 0; r < m_window.size(); ++r) {
+            const QString &inserted = alignments[r].inserted[position];
+            insertionVotes[inserted] += inserted.isEmpty()
+                ? m_window[r].meanWeight
+                : alignments[r].insertedWeight[position] / inserted.size();
+        }
+        fused += winner(insertionVotes, QString());
+
+        if (position == n) {
+            break;
+        }
+
+        // The character itself; a reading that dropped it votes for nothing at its mean weight
+        QHash<QString, float> characterVotes;
+        for (int r = 0; r < m_window.size(); ++r) {
+            const QString &character = alignments[r].aligned[position];
+            characterVotes[character] += character.isEmpty()
+                ? m_window[r].meanWeight
+                : alignments[r].alignedWeight[position];
+        }
+        fused += winner(characterVotes, QString(reference[position]));
+    }
+    return fused.simplified();
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <QVector>
+#include "../OCREngine.h"
+
+/**
+ * Temporal OCR fusion for one text line read over several frames
+ * Subtitles over video and animated UI come out of OCR with different errors
+ * on every frame. Readings of the same line are kept in a short sliding
+ * window; each is aligned (edit distance) against the window's medoid and
+ * every character position is decided by a vote weighted by the OCR word
+ * confidence. A reading that no longer resembles the window - the subtitle
+ * changed - starts a new window, and the fused text only moves when the vote
+ * does, so a subtitle held on screen is emitted (and translated) once.
+ */
+class TemporalOCRFusion
+{
+public:
+    explicit TemporalOCRFusion(int windowSize = 6);
+
+    // Per-character weights for text from its tokens' confidences (fullScale: 100 for Tesseract,
+    // 1 for Vision); characters no token covers, or all of them without tokens, weigh 1
+    static QVector<float> characterWeights(const QString &text, const QVector<OCRResult::OCRToken> &tokens,
+                                           float fullScale = 100.f);
+
+    // Adds one frame's reading and returns the fused line; an empty reading clears the window
+    QString add(const QString &text, const QVector<float> &weights = QVector<float>());
+
+    QString text() const { return m_fused; }
+    int readings() const { return m_window.size(); }
+
+    // Two readings, or one read with high confidence - enough to show without flicker
+    bool isConfirmed() const;
+
+    void reset();
+
+private:
+    struct Reading {
+        QString text;
+        QVector<float> weights;  // One per QChar
+        float meanWeight = 1.f;
+    };
+
+    QString fuse() const;
+
+    int m_windowSize;
+    QList<Reading> m_window;
+    QString m_fused;
+};
@@ -0,0 +1,233 @@
+#include "TextLayout.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace TextLayout {
+
+namespace {
+
+constexpr int CELL = 4;                 // Edge density is counted per CELL x CELL pixels
+constexpr int EDGE_CONTRAST = 40;       // Luma step between neighbours that counts as a stroke edge
+constexpr int MIN_CELL_EDGES = 3;       // Fewer edges in a cell is background texture
+constexpr int WORD_GAP_CELLS = 3;       // Horizontal gaps bridged inside one line (word spacing)
+constexpr int MIN_ROW_EDGES = 2;        // Edge pixels a row needs to belong to a line
+constexpr int LINE_MERGE_GAP = 2;       // Blank rows bridged inside one line (i-dots, accents)
+constexpr int MIN_LINE_HEIGHT = 6;      // Shorter bands are rules and noise
+constexpr int MAX_LINE_HEIGHT = 120;    // Taller bands are pictures, not text
+constexpr double BLOCK_GAP = 1.0;       // Lines closer than this many line heights share a block
+
+inline bool isCancelled(const std::atomic_bool* cancelled)
+{
+    return cancelled && cancelled->load(std::memory_order_relaxed);
+}
+
+inline int luma(QRgb pixel)
+{
+    return (qRed(pixel) * 77 + qGreen(pixel) * 150 + qBlue(pixel) * 29) >> 8;
+}
+
+struct EdgeMap {
+    int width = 0;
+    int height = 0;
+    QVector<quint8> pixels;     // 1 where the luma steps from the left neighbour
+    int columns = 0;
+    int rows = 0;
+    QVector<quint8> cells;      // Edge count per cell, saturating
+
+    const quint8* row(int y) const { return pixels.constData() + y * width; }
+};
+
+// Text lines inside one smeared region, from its row edge profile
+QVector<QRect> splitLines(const EdgeMap& map, const QRect& region)
+{
+    QVector<QRect> lines;
+    int top = -1;
+    int bottom = -1; // exclusive
+    auto flush = [&]() {
+        if (top < 0 || bottom - top < MIN_LINE_HEIGHT || bottom - top > MAX_LINE_HEIGHT) {
+            return;
+        }
+        // Trim to the columns that actually hold strokes
+        int left = region.right();
+        int right = region.left();
+        for (int y = top; y < bottom; ++y) {
+            const quint8* row = map.row(y);
+            for (int x = region.left(); x < left; ++x) {
+                if (row[x]) { left = x; break; }
+            }
+            for (int x = region.right(); x > right; --x) {
+                if (row[x]) { right = x; break; }
+            }
+        }
+        if (right - left + 1 >= MIN_LINE_HEIGHT) {
+            lines.append(QRect(QPoint(left, top), QPoint(right, bottom - 1)));
+        }
+    };
+
+    for (int y = region.top(); y <= region.bottom(); ++y) {
+        const quint8* row = map.row(y);
+        int count = 0;
+        for (int x = region.left(); x <= region.right() && count < MIN_ROW_EDGES; ++x) {
+            count += row[x];
+        }
+        if (count < MIN_ROW_EDGES) {
+            continue;
+        }
+        if (top >= 0 && y - bottom <= LINE_MERGE_GAP) {
+            bottom = y + 1;
+        } else {
+            flush();
+            top = y;
+            bottom = y + 1;
+        }
+    }
+    flush();
+    return lines;
+}
+
+// Stacked lines that overlap horizontally and sit within a line height of each other
+bool belongTogether(const Block& upper, const Block& lower)
+{
+    const QRect& above = upper.lines.last();
+    const QRect& below = lower.lines.first();
+    if (below.top() < above.top()) {
+        return false;
+    }
+    const int gap = below.top() - above.bottom() - 1;
+    const int lineHeight = qMin(above.height(), below.height());
+    const bool overlap = upper.rect.left() <= lower.rect.right() && lower.rect.left() <= upper.rect.right();
+    return overlap && gap <= BLOCK_GAP * lineHeight;
+}
+
+} // namespace
+
+QVector<Block> analyse(const QImage& frame, const std::atomic_bool* cancelled)
+{
+    QVector<Block> blocks;
+    if (frame.isNull()) {
+        return blocks;
+    }
+
+    const QImage image = frame.depth() == 32 ? frame : frame.convertToFormat(QImage::Format_RGB32);
+    EdgeMap map;
+    map.width = image.width();
+    map.height = image.height();
+    map.pixels.fill(0, map.width * map.height);
+    map.columns = (map.width + CELL - 1) / CELL;
+    map.rows = (map.height + CELL - 1) / CELL;
+    map.cells.fill(0, map.columns * map.rows);
+
+    for (int y = 0; y < map.height; ++y) {
+        if (isCancelled(cancelled)) {
+            return QVector<Block>();
+        }
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        quint8* edges = map.pixels.data() + y * map.width;
+        quint8* cells = map.cells.data() + (y / CELL) * map.columns;
+        int previous = luma(line[0]);
+        for (int x = 1; x < map.width; ++x) {
+            const int current = luma(line[x]);
+            if (std::abs(current - previous) >= EDGE_CONTRAST) {
+                edges[x] = 1;
+                quint8& count = cells[x / CELL];
+                if (count < 255) ++count;
+            }
+            previous = current;
+        }
+    }
+
+    // Dense cells, smeared across word gaps so a line becomes one run
+    QVector<quint8> text(map.columns * map.rows, 0);
+    for (int r = 0; r < map.rows; ++r) {
+        const quint8* cells = map.cells.constData() + r * map.columns;
+        quint8* row = text.data() + r * map.columns;
+        int lastDense = -1;
+        for (int c = 0; c < map.columns; ++c) {
+            if (cells[c] < MIN_CELL_EDGES) {
+                continue;
+            }
+            if (lastDense >= 0 && c - lastDense - 1 <= WORD_GAP_CELLS) {
+                std::fill(row + lastDense + 1, row + c, quint8(1));
+            }
+            row[c] = 1;
+            lastDense = c;
+        }
+    }
+
+    // Connected runs of text cells; each is split into lines at pixel resolution
+    QVector<int> stack;
+    for (int start = 0; start < text.size(); ++start) {
+        if (!text[start]) {
+            continue;
+        }
+        if (isCancelled(cancelled)) {
+            return QVector<Block>();
+        }
+        int left = map.columns, right = -1, top = map.rows, bottom = -1;
+        text[start] = 0;
+        stack.append(start);
+        while (!stack.isEmpty()) {
+            const int index = stack.takeLast();
+            const int c = index % map.columns;
+            const int r = index / map.columns;
+            left = qMin(left, c);
+            right = qMax(right, c);
+            top = qMin(top, r);
+            bottom = qMax(bottom, r);
+            auto visit = [&](int neighbour) {
+                if (text[neighbour]) {
+                    text[neighbour] = 0;
+                    stack.append(neighbour);
+                }
+            };
+            if (c > 0) visit(index - 1);
+            if (c + 1 < map.columns) visit(index + 1);
+            if (r > 0) visit(index - map.columns);
+            if (r + 1 < map.rows) visit(index + map.columns);
+        }
+
+        const QRect region = QRect(left * CELL, top * CELL, (right - left + 1) * CELL, (bottom - top + 1) * CELL)
+            .intersected(image.rect());
+        if (region.height() < MIN_LINE_HEIGHT) {
+            continue;
+        }
+        const QVector<QRect> lines = splitLines(map, region);
+        if (lines.isEmpty()) {
+            continue;
+        }
+        Block block;
+        block.lines = lines;
+        for (const QRect& line : lines) {
+            block.rect |= line;
+        }
+        blocks.append(block);
+    }
+
+    // Paragraph lines usually come out as separate runs; stack them back into blocks
+    auto byTop = [](const Block& a, const Block& b) { return a.rect.top() < b.rect.top(); };
+    std::sort(blocks.begin(), blocks.end(), byTop);
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < blocks.size(); ++i) {
+            for (int j = i + 1; j < blocks.size(); ++j) {
+                if (!belongTogether(blocks[i], blocks[j])) {
+                    continue;
+                }
+                blocks[i].lines += blocks[j].lines;
+                std::sort(blocks[i].lines.begin(), blocks[i].lines.end(),
+                          [](const QRect& a, const QRect& b) { return a.top() < b.top(); });
+                blocks[i].rect |= blocks[j].rect;
+                blocks.removeAt(j);
+                merged = true;
+                j = i; // The block grew; look at the rest again
+            }
+        }
+    }
+    std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) {
+        return a.rect.top() != b.rect.top() ? a.rect.top() < b.rect.top() : a.rect.left() < b.rect.left();
+    });
+    return blocks;
+}
+
+} // namespace TextLayout
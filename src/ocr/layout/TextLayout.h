@@ -0,0 +1,28 @@
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <QVector>
+#include <atomic>
+
+/**
+ * Text region detection over a whole screenshot
+ * Cheap enough to run while the user is still selecting: stroke edges (large
+ * luma steps between neighbours) are counted per 4x4 cell, dense cells are
+ * smeared across word gaps, and each connected run is split into text lines
+ * by its row edge profile. Lines stacked closer than a line height form a
+ * block (paragraph, label, menu). Pictures produce bands too tall to be text
+ * and are dropped. Coordinates are in the frame's device pixels.
+ */
+namespace TextLayout {
+
+struct Block {
+    QRect rect;             // Union of the lines
+    QVector<QRect> lines;   // Top to bottom
+};
+
+// Blocks in reading order (top to bottom, then left to right). Returns nothing once
+// *cancelled is set; it is polled once per pixel row
+QVector<Block> analyse(const QImage& frame, const std::atomic_bool* cancelled = nullptr);
+
+} // namespace TextLayout
@@ -0,0 +1,74 @@
+#include "Binarize.h"
+
+namespace Binarize {
+
+BinaryImage otsu(const QImage& image, int maxDimension)
+{
+    BinaryImage bin;
+    if (image.isNull()) {
+        return bin;
+    }
+
+    QImage gray = image;
+    if (maxDimension > 0 && qMax(image.width(), image.height()) > maxDimension) {
+        gray = gray.scaled(maxDimension, maxDimension, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    gray = gray.convertToFormat(QImage::Format_Grayscale8);
+
+    bin.width = gray.width();
+    bin.height = gray.height();
+    bin.bits.resize(bin.width * bin.height);
+
+    int histogram[256] = {0};
+    for (int y = 0; y < gray.height(); ++y) {
+        const uchar* line = gray.constScanLine(y);
+        for (int x = 0; x < gray.width(); ++x) {
+            ++histogram[line[x]];
+        }
+    }
+
+    const int total = bin.width * bin.height;
+    double sumAll = 0.0;
+    for (int i = 0; i < 256; ++i) {
+        sumAll += double(i) * histogram[i];
+    }
+
+    double sumBackground = 0.0;
+    int weightBackground = 0;
+    double bestVariance = -1.0;
+    int threshold = 127;
+    for (int t = 0; t < 256; ++t) {
+        weightBackground += histogram[t];
+        if (weightBackground == 0) continue;
+        const int weightForeground = total - weightBackground;
+        if (weightForeground == 0) break;
+
+        sumBackground += double(t) * histogram[t];
+        const double meanBackground = sumBackground / weightBackground;
+        const double meanForeground = (sumAll - sumBackground) / weightForeground;
+        const double between = double(weightBackground) * weightForeground
+                             * (meanBackground - meanForeground) * (meanBackground - meanForeground);
+        if (between > bestVariance) {
+            bestVariance = between;
+            threshold = t;
+        }
+    }
+
+    int darkCount = 0;
+    for (int t = 0; t <= threshold; ++t) {
+        darkCount += histogram[t];
+    }
+    const bool darkInk = darkCount <= total - darkCount;
+
+    for (int y = 0; y < gray.height(); ++y) {
+        const uchar* line = gray.constScanLine(y);
+        quint8* out = bin.bits.data() + y * bin.width;
+        for (int x = 0; x < gray.width(); ++x) {
+            const bool dark = line[x] <= threshold;
+            out[x] = (dark == darkInk) ? 1 : 0;
+        }
+    }
+    return bin;
+}
+
+} // namespace Binarize
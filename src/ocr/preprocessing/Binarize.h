@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QImage>
+#include <QVector>
+
+/**
+ * Otsu binarisation shared by the layout analysers (deskew, table detection)
+ * Ink is whichever side of the threshold covers fewer pixels, so light-on-dark
+ * crops binarise the same way as dark-on-light ones.
+ */
+namespace Binarize {
+
+// One byte per pixel (1 = ink, 0 = background) so rows can be summed with SAD
+struct BinaryImage {
+    int width = 0;
+    int height = 0;
+    QVector<quint8> bits;
+
+    bool isEmpty() const { return width <= 0 || height <= 0; }
+    const quint8* row(int y) const { return bits.constData() + y * width; }
+    quint8 at(int x, int y) const { return bits[y * width + x]; }
+};
+
+// maxDimension > 0 downsamples the longest side first (analysis only needs layout)
+BinaryImage otsu(const QImage& image, int maxDimension = 0);
+
+} // namespace Binarize
@@ -0,0 +1,326 @@
+#include "Deskew.h"
+#include "Binarize.h"
+#include <QPainter>
+#include <QPair>
+#include <QTransform>
+#include <QVector>
+#include <QtMath>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DESKEW_HAVE_SSE2 1
+#endif
+
+namespace Deskew {
+
+namespace {
+
+constexpr int MAX_ANALYSIS_SIZE = 800;      // Longest side of the analysis image
+constexpr int STRIP_WIDTH = 16;             // Columns summed per profile strip (one SSE2 load)
+constexpr double COARSE_RANGE = 15.0;       // Degrees searched either side of level
+constexpr double COARSE_STEP = 1.0;
+constexpr double FINE_STEP = 0.1;
+constexpr double AXIS_MARGIN = 1.3;         // Winning axis profile must beat the other by this to be trusted
+constexpr double UPSIDE_DOWN_RATIO = 1.5;   // Descender ink must beat ascender ink by this to call 180
+constexpr int MIN_FOREGROUND_PIXELS = 200;  // Below this there is not enough text to judge
+constexpr int MIN_TEXT_LINES = 3;           // One or two lines score the column profile as spiky as the rows
+constexpr int MIN_LINE_HEIGHT = 4;          // Thinner ink bands are rules or noise, not text lines
+
+using Binarize::BinaryImage;
+
+// Per-strip row sums: sums[strip * rows + y] = ink pixels in that strip of row y
+struct StripProfile {
+    int strips = 0;
+    int rows = 0;
+    QVector<int> sums;
+    QVector<double> centers;
+};
+
+struct AngleFit {
+    double degrees = 0.0;
+    double score = -1.0;
+};
+
+int sumBytes(const quint8* data, int count)
+{
+    int total = 0;
+    int i = 0;
+#ifdef DESKEW_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+    }
+    total += _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+#endif
+    for (; i < count; ++i) {
+        total += data[i];
+    }
+    return total;
+}
+
+// Same convention as QTransform().rotate(degrees): positive is clockwise on screen
+BinaryImage rotateClockwise(const BinaryImage& src, int degrees)
+{
+    if (degrees == 0) {
+        return src;
+    }
+
+    BinaryImage dst;
+    const bool swapAxes = (degrees == 90 || degrees == 270);
+    dst.width = swapAxes ? src.height : src.width;
+    dst.height = swapAxes ? src.width : src.height;
+    dst.bits.resize(src.bits.size());
+
+    for (int y = 0; y < dst.height; ++y) {
+        quint8* out = dst.bits.data() + y * dst.width;
+        for (int x = 0; x < dst.width; ++x) {
+            int sx = 0;
+            int sy = 0;
+            switch (degrees) {
+            case 90:  sx = y;                  sy = src.height - 1 - x; break;
+            case 180: sx = src.width - 1 - x;  sy = src.height - 1 - y; break;
+            default:  sx = src.width - 1 - y;  sy = x;                  break; // 270
+            }
+            out[x] = src.bits[sy * src.width + sx];
+        }
+    }
+    return dst;
+}
+
+StripProfile buildStrips(const BinaryImage& bin)
+{
+    StripProfile profile;
+    profile.rows = bin.height;
+    profile.strips = (bin.width + STRIP_WIDTH - 1) / STRIP_WIDTH;
+    profile.sums.resize(profile.strips * profile.rows);
+    profile.centers.resize(profile.strips);
+
+    for (int s = 0; s < profile.strips; ++s) {
+        const int x0 = s * STRIP_WIDTH;
+        const int count = qMin(STRIP_WIDTH, bin.width - x0);
+        profile.centers[s] = x0 + count / 2.0;
+
+        int* out = profile.sums.data() + s * profile.rows;
+        for (int y = 0; y < profile.rows; ++y) {
+            out[y] = sumBytes(bin.row(y) + x0, count);
+        }
+    }
+    return profile;
+}
+
+// Shears the strips by the given angle and returns the sum of squared row totals.
+// Level text lines concentrate ink into few rows, which maximises this score.
+double profileScore(const StripProfile& strips, double degrees, QVector<int>* profileOut = nullptr)
+{
+    const double slope = std::tan(qDegreesToRadians(degrees));
+    const int maxShift = static_cast<int>(std::ceil(qAbs(slope) * strips.strips * STRIP_WIDTH)) + 1;
+
+    QVector<int> profile(strips.rows + 2 * maxShift, 0);
+    for (int s = 0; s < strips.strips; ++s) {
+        const int shift = maxShift - qRound(strips.centers[s] * slope);
+        const int* in = strips.sums.constData() + s * strips.rows;
+        int* out = profile.data() + shift;
+        for (int y = 0; y < strips.rows; ++y) {
+            out[y] += in[y];
+        }
+    }
+
+    double score = 0.0;
+    for (int value : profile) {
+        score += double(value) * value;
+    }
+    if (profileOut) {
+        *profileOut = profile;
+    }
+    return score;
+}
+
+AngleFit bestAngle(const StripProfile& strips)
+{
+    AngleFit best;
+    for (double angle = -COARSE_RANGE; angle <= COARSE_RANGE + 1e-9; angle += COARSE_STEP) {
+        const double score = profileScore(strips, angle);
+        if (score > best.score) {
+            best.score = score;
+            best.degrees = angle;
+        }
+    }
+
+    const double coarse = best.degrees;
+    for (double angle = coarse - COARSE_STEP; angle <= coarse + COARSE_STEP + 1e-9; angle += FINE_STEP) {
+        const double score = profileScore(strips, angle);
+        if (score > best.score) {
+            best.score = score;
+            best.degrees = angle;
+        }
+    }
+    return best;
+}
+
+// Ink bands of a levelled profile, as [top, bottom) pairs
+QVector<QPair<int, int>> textLines(const QVector<int>& profile)
+{
+    QVector<QPair<int, int>> lines;
+    int peak = 0;
+    for (int value : profile) {
+        peak = qMax(peak, value);
+    }
+    if (peak == 0) {
+        return lines;
+    }
+
+    const int lineThreshold = peak / 10;
+    const int n = profile.size();
+    int y = 0;
+    while (y < n) {
+        while (y < n && profile[y] <= lineThreshold) ++y;
+        const int top = y;
+        while (y < n && profile[y] > lineThreshold) ++y;
+        if (y - top >= MIN_LINE_HEIGHT) {
+            lines.append(qMakePair(top, y));
+        }
+    }
+    return lines;
+}
+
+// Latin-style scripts carry more ink above the x-height band (ascenders, capitals)
+// than below it (descenders). A clearly inverted balance means the text is upside down.
+bool looksUpsideDown(const QVector<int>& profile, const QVector<QPair<int, int>>& lines)
+{
+    qint64 above = 0;
+    qint64 below = 0;
+    for (const auto& [top, bottom] : lines) {
+        int linePeak = 0;
+        for (int i = top; i < bottom; ++i) {
+            linePeak = qMax(linePeak, profile[i]);
+        }
+        const int coreThreshold = linePeak / 2;
+
+        int coreTop = top;
+        while (coreTop < bottom && profile[coreTop] < coreThreshold) ++coreTop;
+        int coreBottom = bottom - 1;
+        while (coreBottom > coreTop && profile[coreBottom] < coreThreshold) --coreBottom;
+
+        for (int i = top; i < coreTop; ++i) above += profile[i];
+        for (int i = coreBottom + 1; i < bottom; ++i) below += profile[i];
+    }
+
+    if (above + below == 0) {
+        return false;
+    }
+    return below > above * UPSIDE_DOWN_RATIO;
+}
+
+QColor borderColor(const QImage& image)
+{
+    // Average the top and bottom rows - corners revealed by rotation should match the page
+    qint64 r = 0, g = 0, b = 0, count = 0;
+    const int step = qMax(1, image.width() / 64);
+    for (int x = 0; x < image.width(); x += step) {
+        for (int y : {0, image.height() - 1}) {
+            const QRgb pixel = image.pixel(x, y);
+            r += qRed(pixel);
+            g += qGreen(pixel);
+            b += qBlue(pixel);
+            ++count;
+        }
+    }
+    if (count == 0) {
+        return Qt::white;
+    }
+    return QColor(int(r / count), int(g / count), int(b / count));
+}
+
+} // namespace
+
+bool Estimate::needsCorrection() const
+{
+    return confident && (orientation != 0 || qAbs(skewDegrees) >= MIN_CORRECTION_DEGREES);
+}
+
+Estimate estimate(const QImage& image)
+{
+    Estimate result;
+    if (image.isNull() || image.width() < 16 || image.height() < 16) {
+        return result;
+    }
+
+    const BinaryImage bin = Binarize::otsu(image, MAX_ANALYSIS_SIZE);
+    const int foreground = sumBytes(bin.bits.constData(), bin.bits.size());
+    if (foreground < MIN_FOREGROUND_PIXELS) {
+        return result;
+    }
+
+    // Score both axes: horizontal text has a far spikier row profile than column profile
+    const StripProfile rowStrips = buildStrips(bin);
+    const AngleFit rowFit = bestAngle(rowStrips);
+    const StripProfile columnStrips = buildStrips(rotateClockwise(bin, 90));
+    const AngleFit columnFit = bestAngle(columnStrips);
+
+    const double inkSquared = double(foreground) * foreground;
+    const double rowDispersion = rowFit.score * rowStrips.rows / inkSquared;
+    const double columnDispersion = columnFit.score * columnStrips.rows / inkSquared;
+
+    const bool rotated = columnDispersion > rowDispersion * AXIS_MARGIN;
+    const AngleFit& fit = rotated ? columnFit : rowFit;
+    const StripProfile& strips = rotated ? columnStrips : rowStrips;
+
+    QVector<int> profile;
+    profileScore(strips, fit.degrees, &profile);
+    const QVector<QPair<int, int>> lines = textLines(profile);
+
+    // A near tie between the axes, or too few lines to tell them apart, is left to Tesseract OSD
+    const double weaker = qMin(rowDispersion, columnDispersion);
+    const double stronger = qMax(rowDispersion, columnDispersion);
+    if (lines.size() < MIN_TEXT_LINES || weaker <= 0.0 || stronger < weaker * AXIS_MARGIN) {
+        return result;
+    }
+
+    result.orientation = rotated ? 90 : 0;
+    if (looksUpsideDown(profile, lines)) {
+        result.orientation = (result.orientation + 180) % 360;
+    }
+    result.skewDegrees = fit.degrees;
+    result.confident = true;
+    return result;
+}
+
+QImage correct(const QImage& image, const Estimate& estimate)
+{
+    if (image.isNull() || !estimate.needsCorrection()) {
+        return image;
+    }
+
+    QImage result = image;
+    if (estimate.orientation != 0) {
+        // Quarter turns are lossless and take Qt's fast path
+        result = result.transformed(QTransform().rotate(estimate.orientation));
+    }
+
+    if (qAbs(estimate.skewDegrees) >= MIN_CORRECTION_DEGREES) {
+        QTransform rotation;
+        rotation.rotate(-estimate.skewDegrees);
+        const QRect bounds = rotation.mapRect(QRectF(result.rect())).toAlignedRect();
+
+        // Paint straight onto the source format so a grayscale page isn't converted a second time
+        const bool gray = result.format() == QImage::Format_Grayscale8;
+        QImage canvas(bounds.size(), gray ? QImage::Format_Grayscale8 : QImage::Format_RGB32);
+        canvas.fill(borderColor(result));
+
+        QPainter painter(&canvas);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.translate(canvas.width() / 2.0, canvas.height() / 2.0);
+        painter.rotate(-estimate.skewDegrees);
+        painter.translate(-result.width() / 2.0, -result.height() / 2.0);
+        painter.drawImage(0, 0, result);
+        painter.end();
+
+        result = canvas;
+    }
+    return result;
+}
+
+} // namespace Deskew
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QImage>
+
+/**
+ * Native orientation and skew estimation
+ * Replaces Tesseract OSD (PSM 1 + osd.traineddata) for rotated photos and
+ * slanted screenshots. Works on a downsampled, binarised copy of the crop and
+ * scores projection-profile variance over a small set of angles.
+ */
+namespace Deskew {
+
+struct Estimate {
+    int orientation = 0;       // Clockwise rotation to apply first: 0, 90, 180 or 270
+    double skewDegrees = 0.0;  // Residual text slant (clockwise positive) after orientation
+    bool confident = false;    // false for too little ink, too few lines or an axis near-tie
+
+    bool needsCorrection() const;
+};
+
+// Skew below this is left alone - resampling would only blur glyph edges
+constexpr double MIN_CORRECTION_DEGREES = 0.3;
+
+Estimate estimate(const QImage& image);
+QImage correct(const QImage& image, const Estimate& estimate);
+
+} // namespace Deskew
@@ -0,0 +1,240 @@
+#include "TextLayerSeparator.h"
+#include <QVector>
+#include <QColor>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace TextLayerSeparator {
+
+namespace {
+
+constexpr int CLUSTERS = 3;                 // Background, text, and one slot for fringes/clutter
+constexpr int LEVELS = 32;                  // 5 bits per channel
+constexpr int BIN_COUNT = LEVELS * LEVELS * LEVELS;
+constexpr int MAX_SAMPLES = 40000;          // Pixels sampled for the histogram
+constexpr int ITERATIONS = 8;
+constexpr double MIN_TEXT_SHARE = 0.01;     // Text cluster must cover at least 1% of samples
+constexpr double MIN_CONTRAST = 40.0;       // RGB distance between text and background centroids
+constexpr double CLUTTER_DISTANCE = 0.35;   // Off-axis distance (fraction of text contrast) that marks clutter
+
+struct Color {
+    double r = 0.0;
+    double g = 0.0;
+    double b = 0.0;
+};
+
+struct Bin {
+    Color color;
+    int count = 0;
+};
+
+inline int binIndex(QRgb pixel)
+{
+    return ((qRed(pixel) >> 3) << 10) | ((qGreen(pixel) >> 3) << 5) | (qBlue(pixel) >> 3);
+}
+
+inline Color binColor(int index)
+{
+    return { ((index >> 10) & 31) * 8 + 4.0, ((index >> 5) & 31) * 8 + 4.0, (index & 31) * 8 + 4.0 };
+}
+
+inline double distanceSquared(const Color& a, const Color& b)
+{
+    const double dr = a.r - b.r;
+    const double dg = a.g - b.g;
+    const double db = a.b - b.b;
+    return dr * dr + dg * dg + db * db;
+}
+
+int nearestCluster(const Color& color, const Color* centers, int k)
+{
+    int nearest = 0;
+    double best = distanceSquared(color, centers[0]);
+    for (int c = 1; c < k; ++c) {
+        const double d = distanceSquared(color, centers[c]);
+        if (d < best) {
+            best = d;
+            nearest = c;
+        }
+    }
+    return nearest;
+}
+
+// Distance from a colour to the background->text segment
+double distanceToAxis(const Color& color, const Color& background, const Color& text)
+{
+    const Color axis { text.r - background.r, text.g - background.g, text.b - background.b };
+    const double lengthSquared = axis.r * axis.r + axis.g * axis.g + axis.b * axis.b;
+    if (lengthSquared <= 0.0) {
+        return std::sqrt(distanceSquared(color, background));
+    }
+    double t = ((color.r - background.r) * axis.r + (color.g - background.g) * axis.g
+              + (color.b - background.b) * axis.b) / lengthSquared;
+    t = std::clamp(t, 0.0, 1.0);
+    const Color projected { background.r + t * axis.r, background.g + t * axis.g, background.b + t * axis.b };
+    return std::sqrt(distanceSquared(color, projected));
+}
+
+// Fallback: plain grayscale, inverted when the page (border) is dark
+QImage normalisedGray(const QImage& image)
+{
+    QImage gray = image.convertToFormat(QImage::Format_Grayscale8);
+    if (gray.isNull() || gray.height() == 0) {
+        return gray;
+    }
+
+    qint64 sum = 0;
+    int count = 0;
+    for (int y : {0, gray.height() - 1}) {
+        const uchar* line = gray.constScanLine(y);
+        for (int x = 0; x < gray.width(); ++x) {
+            sum += line[x];
+            ++count;
+        }
+    }
+    if (count > 0 && sum / count < 128) {
+        gray.invertPixels();
+    }
+    return gray;
+}
+
+} // namespace
+
+QImage separate(const QImage& image)
+{
+    if (image.isNull()) {
+        return image;
+    }
+
+    const QImage rgb = image.convertToFormat(QImage::Format_RGB32);
+    const int width = rgb.width();
+    const int height = rgb.height();
+    const int step = qMax(1, static_cast<int>(std::sqrt(double(width) * height / MAX_SAMPLES)));
+
+    // Quantised colour histogram of a subsampled grid
+    QVector<int> histogram(BIN_COUNT, 0);
+    int samples = 0;
+    for (int y = 0; y < height; y += step) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(rgb.constScanLine(y));
+        for (int x = 0; x < width; x += step) {
+            ++histogram[binIndex(line[x])];
+            ++samples;
+        }
+    }
+
+    QVector<Bin> bins;
+    for (int i = 0; i < BIN_COUNT; ++i) {
+        if (histogram[i] > 0) {
+            bins.append({ binColor(i), histogram[i] });
+        }
+    }
+    if (bins.size() < 2) {
+        return normalisedGray(image);
+    }
+
+    // Seed with the most common colour, then farthest-point seeding damped by population
+    const int k = qMin(CLUSTERS, static_cast<int>(bins.size()));
+    Color centers[CLUSTERS];
+    double weights[CLUSTERS] = {};
+    centers[0] = std::max_element(bins.cbegin(), bins.cend(),
+        [](const Bin& a, const Bin& b) { return a.count < b.count; })->color;
+    for (int c = 1; c < k; ++c) {
+        double best = -1.0;
+        for (const Bin& bin : bins) {
+            double nearest = distanceSquared(bin.color, centers[0]);
+            for (int j = 1; j < c; ++j) {
+                nearest = qMin(nearest, distanceSquared(bin.color, centers[j]));
+            }
+            const double score = nearest * std::sqrt(double(bin.count));
+            if (score > best) {
+                best = score;
+                centers[c] = bin.color;
+            }
+        }
+    }
+
+    // Weighted k-means over the histogram bins
+    for (int iteration = 0; iteration < ITERATIONS; ++iteration) {
+        Color sums[CLUSTERS];
+        double counts[CLUSTERS] = {};
+        for (const Bin& bin : bins) {
+            const int c = nearestCluster(bin.color, centers, k);
+            sums[c].r += bin.color.r * bin.count;
+            sums[c].g += bin.color.g * bin.count;
+            sums[c].b += bin.color.b * bin.count;
+            counts[c] += bin.count;
+        }
+
+        bool moved = false;
+        for (int c = 0; c < k; ++c) {
+            weights[c] = counts[c];
+            if (counts[c] <= 0.0) continue;
+            const Color updated { sums[c].r / counts[c], sums[c].g / counts[c], sums[c].b / counts[c] };
+            if (distanceSquared(updated, centers[c]) > 0.25) {
+                moved = true;
+            }
+            centers[c] = updated;
+        }
+        if (!moved) break;
+    }
+
+    // Background is the dominant colour; text is the most distinct cluster that isn't noise
+    int background = 0;
+    for (int c = 1; c < k; ++c) {
+        if (weights[c] > weights[background]) {
+            background = c;
+        }
+    }
+
+    int text = -1;
+    double farthest = 0.0;
+    for (int c = 0; c < k; ++c) {
+        if (c == background || weights[c] < MIN_TEXT_SHARE * samples) continue;
+        const double d = distanceSquared(centers[c], centers[background]);
+        if (d > farthest) {
+            farthest = d;
+            text = c;
+        }
+    }
+
+    const double contrast = std::sqrt(farthest);
+    if (text < 0 || contrast < MIN_CONTRAST) {
+        qDebug() << "TextLayerSeparator: no distinct text layer, using grayscale";
+        return normalisedGray(image);
+    }
+
+    // Clusters lying off the background->text axis are clutter (icons, highlights, selection bars)
+    bool dropCluster[CLUSTERS] = {};
+    for (int c = 0; c < k; ++c) {
+        if (c == background || c == text) continue;
+        dropCluster[c] = distanceToAxis(centers[c], centers[background], centers[text]) > contrast * CLUTTER_DISTANCE;
+    }
+
+    // Per-bin lookup: soft ink value keeps anti-aliased glyph edges intact
+    QVector<uchar> lut(BIN_COUNT);
+    for (int i = 0; i < BIN_COUNT; ++i) {
+        const Color color = binColor(i);
+        if (dropCluster[nearestCluster(color, centers, k)]) {
+            lut[i] = 255;
+            continue;
+        }
+        const double toText = std::sqrt(distanceSquared(color, centers[text]));
+        const double toBackground = std::sqrt(distanceSquared(color, centers[background]));
+        const double total = toText + toBackground;
+        lut[i] = total > 0.0 ? static_cast<uchar>(qRound(255.0 * toText / total)) : 255;
+    }
+
+    QImage output(width, height, QImage::Format_Grayscale8);
+    for (int y = 0; y < height; ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(rgb.constScanLine(y));
+        uchar* out = output.scanLine(y);
+        for (int x = 0; x < width; ++x) {
+            out[x] = lut[binIndex(line[x])];
+        }
+    }
+    output.setDevicePixelRatio(image.devicePixelRatio());
+    return output;
+}
+
+} // namespace TextLayerSeparator
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QImage>
+
+/**
+ * Colour-layer separation for UI text
+ * Clusters the crop's colours with a small k-means over a quantised histogram,
+ * takes the dominant cluster as background and the most distinct remaining one
+ * as text, then renders a Grayscale8 image with dark text on a white page.
+ * Handles light-on-dark themes, terminals and coloured game UIs in one pass.
+ */
+namespace TextLayerSeparator {
+
+// Returns the separated layer, or a plain polarity-normalised grayscale copy
+// when no distinct text colour can be found
+QImage separate(const QImage& image);
+
+} // namespace TextLayerSeparator
@@ -0,0 +1,213 @@
+#include "TableDetector.h"
+#include "../preprocessing/Binarize.h"
+#include <algorithm>
+
+namespace TableDetector {
+
+namespace {
+
+constexpr double RULE_FRACTION = 0.5;   // An ink run this fraction of the table span is a ruling line
+constexpr int MERGE_GAP = 2;            // Blank rows bridged inside one text line (i-dots, accents)
+constexpr int MIN_LINE_HEIGHT = 3;      // Shorter ink bands are noise
+constexpr int MIN_COLUMN_GAP = 8;       // Lower bound for a whitespace column separator
+constexpr int MIN_EDGE_SPACING = 3;     // Edges closer than this are one edge
+
+struct Run {
+    int start = 0;
+    int end = 0; // inclusive
+    int length() const { return end - start + 1; }
+    int center() const { return (start + end) / 2; }
+};
+
+// Consecutive indices where flags[i] is set
+QVector<Run> runsOf(const QVector<bool>& flags, int mergeGap = 0)
+{
+    QVector<Run> runs;
+    int i = 0;
+    const int n = flags.size();
+    while (i < n) {
+        while (i < n && !flags[i]) ++i;
+        if (i >= n) break;
+        Run run { i, i };
+        while (i < n && flags[i]) run.end = i++;
+
+        if (!runs.isEmpty() && run.start - runs.last().end - 1 <= mergeGap) {
+            runs.last().end = run.end;
+        } else {
+            runs.append(run);
+        }
+    }
+    return runs;
+}
+
+// Edges at the middle of every gap between content runs, bounded by the content extent
+QVector<int> edgesFromGaps(const QVector<Run>& runs, int minGap)
+{
+    QVector<int> edges;
+    if (runs.isEmpty()) {
+        return edges;
+    }
+    edges.append(qMax(0, runs.first().start - 1));
+    for (int i = 1; i < runs.size(); ++i) {
+        const int gap = runs[i].start - runs[i - 1].end - 1;
+        if (gap >= minGap) {
+            edges.append(runs[i - 1].end + 1 + gap / 2);
+        }
+    }
+    edges.append(runs.last().end + 1);
+    return edges;
+}
+
+QVector<int> edgesFromRules(const QVector<Run>& rules, int extent)
+{
+    QVector<int> edges { 0 };
+    for (const Run& rule : rules) {
+        edges.append(rule.center());
+    }
+    edges.append(extent);
+    return edges;
+}
+
+QVector<int> dedupeEdges(QVector<int> edges)
+{
+    std::sort(edges.begin(), edges.end());
+    QVector<int> result;
+    for (int edge : edges) {
+        if (result.isEmpty() || edge - result.last() >= MIN_EDGE_SPACING) {
+            result.append(edge);
+        }
+    }
+    return result;
+}
+
+// Drop leading/trailing bands with no content (margins outside the outer rules).
+// Empty interior bands are kept - they are genuinely empty rows or columns.
+void trimEmptyBands(QVector<int>& edges, const QVector<int>& profile)
+{
+    auto bandHasInk = [&](int from, int to) {
+        for (int i = qMax(0, from); i < qMin(to, static_cast<int>(profile.size())); ++i) {
+            if (profile[i] > 0) return true;
+        }
+        return false;
+    };
+    while (edges.size() > 2 && !bandHasInk(edges[0], edges[1])) {
+        edges.removeFirst();
+    }
+    while (edges.size() > 2 && !bandHasInk(edges[edges.size() - 2], edges.last())) {
+        edges.removeLast();
+    }
+}
+
+} // namespace
+
+QRect Grid::cellRect(int row, int column) const
+{
+    if (row < 0 || row >= rows() || column < 0 || column >= columns()) {
+        return QRect();
+    }
+    const int left = columnEdges[column] + inset;
+    const int right = columnEdges[column + 1] - inset;
+    const int top = rowEdges[row] + inset;
+    const int bottom = rowEdges[row + 1] - inset;
+    if (right <= left || bottom <= top) {
+        return QRect();
+    }
+    return QRect(left, top, right - left, bottom - top);
+}
+
+Grid detect(const QImage& image)
+{
+    Grid grid;
+    const Binarize::BinaryImage bin = Binarize::otsu(image);
+    if (bin.isEmpty()) {
+        return grid;
+    }
+    const int width = bin.width;
+    const int height = bin.height;
+
+    // Longest ink run per row and per column in one pass over the bitmap
+    QVector<int> rowLongest(height, 0);
+    QVector<int> columnLongest(width, 0);
+    QVector<int> columnRun(width, 0);
+    for (int y = 0; y < height; ++y) {
+        const quint8* line = bin.row(y);
+        int run = 0;
+        for (int x = 0; x < width; ++x) {
+            if (line[x]) {
+                rowLongest[y] = qMax(rowLongest[y], ++run);
+                columnLongest[x] = qMax(columnLongest[x], ++columnRun[x]);
+            } else {
+                run = 0;
+                columnRun[x] = 0;
+            }
+        }
+    }
+
+    QVector<bool> ruledRow(height);
+    QVector<bool> ruledColumn(width);
+    for (int y = 0; y < height; ++y) ruledRow[y] = rowLongest[y] >= width * RULE_FRACTION;
+    for (int x = 0; x < width; ++x) ruledColumn[x] = columnLongest[x] >= height * RULE_FRACTION;
+
+    const QVector<Run> horizontalRules = runsOf(ruledRow);
+    const QVector<Run> verticalRules = runsOf(ruledColumn);
+
+    // Content projections with the ruling lines masked out
+    QVector<int> rowInk(height, 0);
+    QVector<int> columnInk(width, 0);
+    for (int y = 0; y < height; ++y) {
+        if (ruledRow[y]) continue;
+        const quint8* line = bin.row(y);
+        for (int x = 0; x < width; ++x) {
+            if (line[x] && !ruledColumn[x]) {
+                ++rowInk[y];
+                ++columnInk[x];
+            }
+        }
+    }
+
+    QVector<bool> rowHasInk(height);
+    QVector<bool> columnHasInk(width);
+    for (int y = 0; y < height; ++y) rowHasInk[y] = rowInk[y] > 0;
+    for (int x = 0; x < width; ++x) columnHasInk[x] = columnInk[x] > 0;
+
+    QVector<Run> textLines;
+    for (const Run& run : runsOf(rowHasInk, MERGE_GAP)) {
+        if (run.length() >= MIN_LINE_HEIGHT) textLines.append(run);
+    }
+    if (textLines.isEmpty()) {
+        return grid;
+    }
+
+    QVector<int> heights;
+    for (const Run& line : textLines) heights.append(line.length());
+    std::nth_element(heights.begin(), heights.begin() + heights.size() / 2, heights.end());
+    const int medianLineHeight = heights[heights.size() / 2];
+
+    // Rows: ruling lines when there are at least two, otherwise one row per text line
+    if (horizontalRules.size() >= 2) {
+        grid.rowEdges = edgesFromRules(horizontalRules, height);
+    } else {
+        grid.rowEdges = edgesFromGaps(textLines, 1);
+    }
+
+    // Columns: ruling lines, otherwise gaps wider than a word space
+    if (verticalRules.size() >= 2) {
+        grid.columnEdges = edgesFromRules(verticalRules, width);
+    } else {
+        grid.columnEdges = edgesFromGaps(runsOf(columnHasInk), qMax(MIN_COLUMN_GAP, medianLineHeight));
+    }
+
+    grid.rowEdges = dedupeEdges(grid.rowEdges);
+    grid.columnEdges = dedupeEdges(grid.columnEdges);
+    trimEmptyBands(grid.rowEdges, rowInk);
+    trimEmptyBands(grid.columnEdges, columnInk);
+
+    int thickest = 0;
+    for (const Run& rule : horizontalRules) thickest = qMax(thickest, rule.length());
+    for (const Run& rule : verticalRules) thickest = qMax(thickest, rule.length());
+    grid.ruled = !horizontalRules.isEmpty() || !verticalRules.isEmpty();
+    grid.inset = grid.ruled ? thickest / 2 + 2 : 0;
+    return grid;
+}
+
+} // namespace TableDetector
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <QVector>
+
+/**
+ * Table structure detection
+ * Finds ruling lines (long ink runs) and, where an axis has no rules, falls back
+ * to the whitespace grid: text lines become rows and wide vertical gaps become
+ * column separators. Coordinates are in the pixels of the analysed image.
+ */
+namespace TableDetector {
+
+struct Grid {
+    QVector<int> rowEdges;     // rows() + 1 ascending y boundaries
+    QVector<int> columnEdges;  // columns() + 1 ascending x boundaries
+    int inset = 0;             // Pixels trimmed inside each edge so ruling lines don't reach the cells
+    bool ruled = false;
+
+    int rows() const { return qMax(0, static_cast<int>(rowEdges.size()) - 1); }
+    int columns() const { return qMax(0, static_cast<int>(columnEdges.size()) - 1); }
+    bool isValid() const { return rows() >= 2 && columns() >= 2; }
+
+    // Cell interior with ruling lines trimmed off
+    QRect cellRect(int row, int column) const;
+};
+
+Grid detect(const QImage& image);
+
+} // namespace TableDetector
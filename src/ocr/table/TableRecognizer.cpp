@@ -0,0 +1,196 @@
+#include "TableRecognizer.h"
+#include "TableDetector.h"
+#include "../engines/tesseract/TesseractEngine.h"
+#include "../preprocessing/Deskew.h"
+#include "../preprocessing/TextLayerSeparator.h"
+#include "ImageFrame.h"
+#include <QThreadPool>
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+
+namespace TableRecognizer {
+
+namespace {
+
+constexpr int CELL_PADDING = 8;        // Tesseract needs a quiet margin around glyphs
+constexpr int MIN_CELL_HEIGHT = 30;    // Smaller cells are upscaled 2x before recognition
+constexpr int MIN_CELL_CONTRAST = 40;  // Gray range below this means the cell is blank
+
+struct CellJob {
+    int row = 0;
+    int column = 0;
+    QImage image;
+};
+
+bool isBlank(const QImage& cell)
+{
+    const QImage gray = cell.convertToFormat(QImage::Format_Grayscale8);
+    int darkest = 255;
+    int lightest = 0;
+    for (int y = 0; y < gray.height(); ++y) {
+        const uchar* line = gray.constScanLine(y);
+        for (int x = 0; x < gray.width(); ++x) {
+            darkest = qMin(darkest, int(line[x]));
+            lightest = qMax(lightest, int(line[x]));
+        }
+    }
+    return lightest - darkest < MIN_CELL_CONTRAST;
+}
+
+QImage prepareCell(const QImage& cell)
+{
+    // The table is already Grayscale8; the padded cell stays in it so Tesseract gets it as is
+    QImage source = cell;
+    if (source.height() < MIN_CELL_HEIGHT) {
+        source = source.scaled(source.size() * 2, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    QImage padded(source.width() + 2 * CELL_PADDING, source.height() + 2 * CELL_PADDING, QImage::Format_Grayscale8);
+    padded.fill(QColor(source.pixel(0, 0)));
+    QPainter painter(&padded);
+    painter.drawImage(CELL_PADDING, CELL_PADDING, source);
+    painter.end();
+    return padded;
+}
+
+QString cleanCell(const QString& text)
+{
+    // One logical value per cell: tabs and line breaks would break the TSV/CSV grid
+    return text.simplified();
+}
+
+} // namespace
+
+OCRResult recognize(
+    const QImage& image,
+    const QString& language,
+    int qualityLevel,
+    bool preprocessing,
+    bool autoDetectOrientation,
+    const std::atomic_bool* cancelled)
+{
+    OCRResult result;
+    result.success = false;
+    if (image.isNull()) {
+        result.errorMessage = "Invalid image provided for table OCR";
+        return result;
+    }
+
+    // Normalise the whole table once; cells then skip per-cell preprocessing. Either way the
+    // table goes to Grayscale8 here, and detection, blank checks and cells all read that
+    QImage table = preprocessing
+        ? TextLayerSeparator::separate(image)
+        : image.convertToFormat(QImage::Format_Grayscale8);
+    if (autoDetectOrientation) {
+        table = Deskew::correct(table, Deskew::estimate(table));
+    }
+
+    const TableDetector::Grid grid = TableDetector::detect(table);
+    if (!grid.isValid()) {
+        result.errorMessage = "No table structure detected";
+        return result;
+    }
+
+    const int rows = grid.rows();
+    const int columns = grid.columns();
+    for (int row = 0; row < rows; ++row) {
+        QStringList cells;
+        for (int column = 0; column < columns; ++column) {
+            cells << QString();
+        }
+        result.table.append(cells);
+    }
+
+    QVector<CellJob> jobs;
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            const QRect rect = grid.cellRect(row, column).intersected(table.rect());
+            if (rect.isEmpty()) continue;
+            const QImage cell = ImageFrame::view(table, rect);
+            if (isBlank(cell)) continue;
+            jobs.append({ row, column, prepareCell(cell) });
+        }
+    }
+
+    // Whitespace grids are one text line per row by construction; ruled cells may wrap
+    const int psm = grid.ruled ? 6 : 7;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount()));
+    QMutex resultMutex;
+    for (const CellJob& job : jobs) {
+        pool.start([&, job]() {
+            if (cancelled && cancelled->load()) {
+                return;
+            }
+            const OCRResult cell = TesseractEngine::performOCR(job.image, language, qualityLevel, false, false, psm,
+                                                               cancelled);
+            const QString text = cell.success ? cleanCell(cell.text) : QString();
+
+            QMutexLocker locker(&resultMutex);
+            result.table[job.row][job.column] = text;
+        });
+    }
+    pool.waitForDone();
+    if (cancelled && cancelled->load()) {
+        result.table.clear();
+        result.errorMessage = "Table OCR cancelled";
+        return result;
+    }
+
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            const QString& text = result.table[row][column];
+            if (text.isEmpty()) continue;
+            OCRResult::OCRToken token;
+            token.text = text;
+            token.box = grid.cellRect(row, column);
+            token.lineId = row;
+            result.tokens.append(token);
+        }
+    }
+
+    result.text = toTsv(result.table);
+    result.success = !result.tokens.isEmpty();
+    result.confidence = "N/A";
+    result.language = language;
+    if (!result.success) {
+        result.errorMessage = "No text detected in table cells";
+    }
+    return result;
+}
+
+QString toTsv(const QVector<QStringList>& table)
+{
+    QStringList lines;
+    for (const QStringList& row : table) {
+        QStringList cells;
+        for (const QString& cell : row) {
+            cells << cleanCell(cell);
+        }
+        lines << cells.join('\t');
+    }
+    return lines.join('\n');
+}
+
+QString toCsv(const QVector<QStringList>& table)
+{
+    QStringList lines;
+    for (const QStringList& row : table) {
+        QStringList cells;
+        for (const QString& cell : row) {
+            QString value = cleanCell(cell);
+            if (value.contains(',') || value.contains('"')) {
+                value = '"' + value.replace('"', "\"\"") + '"';
+            }
+            cells << value;
+        }
+        lines << cells.join(',');
+    }
+    // RFC 4180 line endings
+    return lines.join("\r\n");
+}
+
+} // namespace TableRecognizer
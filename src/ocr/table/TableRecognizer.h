@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include "../OCREngine.h"
+
+/**
+ * Table-mode OCR
+ * Detects the grid with TableDetector, then recognises every non-empty cell
+ * concurrently on a thread pool so a large table costs about one row of
+ * Tesseract runs rather than the sum of all cells. The result carries the grid
+ * in OCRResult::table and a TSV rendering in OCRResult::text.
+ */
+namespace TableRecognizer {
+
+// Returns success == false (and an empty table) when no grid is found,
+// so callers can fall back to regular paragraph OCR. Cells not read yet are
+// skipped once *cancelled is set, and those being read are abandoned
+OCRResult recognize(
+    const QImage& image,
+    const QString& language,
+    int qualityLevel,
+    bool preprocessing,
+    bool autoDetectOrientation,
+    const std::atomic_bool* cancelled = nullptr
+);
+
+QString toTsv(const QVector<QStringList>& table);
+QString toCsv(const QVector<QStringList>& table);
+
+} // namespace TableRecognizer
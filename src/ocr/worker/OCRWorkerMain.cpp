@@ -0,0 +1,334 @@
+#include "OCRWorkerMain.h"
+#include "OCRWorkerProtocol.h"
+#include "../engines/tesseract/TesseractEngine.h"
+#include "../engines/tesseract/TesseractConfig.h"
+#include <QCoreApplication>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSharedMemory>
+#include <QHash>
+#include <QTimer>
+#include <QDebug>
+#include <cstring>
+#include <map>
+#include <memory>
+
+#ifdef HAVE_LIBTESSERACT
+#include <tesseract/baseapi.h>
+#include <tesseract/resultiterator.h>
+#endif
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <signal.h>
+#include <sys/types.h>
+#endif
+
+namespace OCRWorkerMain {
+
+namespace {
+
+constexpr int IDLE_TIMEOUT_MS = 60000;   // Reap ourselves after a minute without work
+constexpr int PARENT_CHECK_MS = 2000;
+
+bool processAlive(qint64 pid)
+{
+    if (pid <= 0) return true;
+#ifdef Q_OS_WIN
+    HANDLE handle = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (!handle) return false;
+    const bool alive = WaitForSingleObject(handle, 0) == WAIT_TIMEOUT;
+    CloseHandle(handle);
+    return alive;
+#else
+    return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+class WorkerServer : public QObject
+{
+public:
+    WorkerServer(const QString& serverName, qint64 parentPid)
+        : m_serverName(serverName)
+        , m_parentPid(parentPid)
+    {
+        m_idleTimer.setSingleShot(true);
+        m_idleTimer.setInterval(IDLE_TIMEOUT_MS);
+        connect(&m_idleTimer, &QTimer::timeout, this, [this]() {
+            qDebug() << "OCR worker" << m_serverName << "idle, exiting";
+            QCoreApplication::quit();
+        });
+
+        m_parentTimer.setInterval(PARENT_CHECK_MS);
+        connect(&m_parentTimer, &QTimer::timeout, this, [this]() {
+            if (!processAlive(m_parentPid)) {
+                qDebug() << "OCR worker" << m_serverName << "parent gone, exiting";
+                QCoreApplication::quit();
+            }
+        });
+
+        connect(&m_server, &QLocalServer::newConnection, this, [this]() {
+            while (QLocalSocket* socket = m_server.nextPendingConnection()) {
+                connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+                connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+                    m_buffers.remove(socket);
+                    socket->deleteLater();
+                });
+            }
+        });
+    }
+
+    bool listen()
+    {
+        QLocalServer::removeServer(m_serverName);
+        m_server.setSocketOptions(QLocalServer::UserAccessOption);
+        if (!m_server.listen(m_serverName)) {
+            qWarning() << "OCR worker failed to listen on" << m_serverName << m_server.errorString();
+            return false;
+        }
+        m_idleTimer.start();
+        m_parentTimer.start();
+        qDebug() << "OCR worker listening on" << m_serverName;
+        return true;
+    }
+
+private:
+    void onReadyRead(QLocalSocket* socket)
+    {
+        QByteArray& buffer = m_buffers[socket];
+        buffer.append(socket->readAll());
+
+        QByteArray payload;
+        while (OCRWorkerProtocol::takeFrame(buffer, payload)) {
+            OCRWorkerProtocol::Request request;
+            if (!OCRWorkerProtocol::decode(payload, request)) {
+                socket->abort();
+                return;
+            }
+
+            // An empty memory key is the pool asking us to exit
+            if (request.memoryKey.isEmpty()) {
+                qDebug() << "OCR worker" << m_serverName << "asked to shut down";
+                QCoreApplication::quit();
+                return;
+            }
+
+            m_idleTimer.stop();
+            const OCRWorkerProtocol::Response response = handle(request);
+            socket->write(OCRWorkerProtocol::frame(OCRWorkerProtocol::encode(response)));
+            socket->flush();
+            m_idleTimer.start();
+        }
+    }
+
+    OCRWorkerProtocol::Response handle(const OCRWorkerProtocol::Request& request)
+    {
+        OCRWorkerProtocol::Response response;
+        const QImage image = readImage(request);
+        if (image.isNull()) {
+            response.errorMessage = "OCR worker could not read the shared image";
+            return response;
+        }
+
+        const OCRResult result = recognize(image, request);
+        response.success = result.success;
+        response.text = result.text;
+        response.language = result.language;
+        response.errorMessage = result.errorMessage;
+        response.confidence = result.confidence;
+        for (const OCRResult::OCRToken& token : result.tokens) {
+            response.words.append({ token.text, token.box, token.confidence, token.lineId });
+        }
+        return response;
+    }
+
+    QImage readImage(const OCRWorkerProtocol::Request& request)
+    {
+        if (m_memory.key() != request.memoryKey) {
+            if (m_memory.isAttached()) {
+                m_memory.detach();
+            }
+            m_memory.setKey(request.memoryKey);
+            if (!m_memory.attach(QSharedMemory::ReadOnly)) {
+                qWarning() << "OCR worker failed to attach" << request.memoryKey << m_memory.errorString();
+                return QImage();
+            }
+        }
+
+        const qsizetype needed = static_cast<qsizetype>(request.bytesPerLine) * request.height;
+        if (request.width <= 0 || request.height <= 0 || needed > m_memory.size()) {
+            return QImage();
+        }
+
+        // Copy out: the segment is reused for the next request
+        const QImage view(static_cast<const uchar*>(m_memory.constData()),
+                          request.width, request.height, request.bytesPerLine,
+                          static_cast<QImage::Format>(request.format));
+        return view.copy();
+    }
+
+#ifdef HAVE_LIBTESSERACT
+    // Word boxes and confidences from the recognition GetUTF8Text just ran
+    static void collectWords(tesseract::TessBaseAPI* api, OCRResult& result)
+    {
+        result.confidence = "N/A";
+        std::unique_ptr<tesseract::ResultIterator> it(api->GetIterator());
+        if (!it) {
+            return;
+        }
+
+        int lineId = -1;
+        do {
+            if (it->IsAtBeginningOf(tesseract::RIL_TEXTLINE)) {
+                ++lineId;
+            }
+            std::unique_ptr<char[]> word(it->GetUTF8Text(tesseract::RIL_WORD));
+            if (!word) {
+                continue;
+            }
+            int left = 0, top = 0, right = 0, bottom = 0;
+            it->BoundingBox(tesseract::RIL_WORD, &left, &top, &right, &bottom);
+
+            OCRResult::OCRToken token;
+            token.text = QString::fromUtf8(word.get());
+            token.box = QRect(left, top, right - left, bottom - top);
+            token.confidence = it->Confidence(tesseract::RIL_WORD);
+            token.lineId = lineId;
+            result.tokens.append(token);
+        } while (it->Next(tesseract::RIL_WORD));
+
+        if (!result.tokens.isEmpty()) {
+            result.confidence = QString::number(api->MeanTextConf());
+        }
+    }
+#endif
+
+    OCRResult recognize(const QImage& image, const OCRWorkerProtocol::Request& request)
+    {
+#ifdef HAVE_LIBTESSERACT
+        QString languageCode = TesseractConfig::getLanguageCode(request.language);
+        if (languageCode.isEmpty()) {
+            languageCode = "eng";
+        }
+        const bool lstmOnly = TesseractConfig::shouldUseLSTM(request.language, request.qualityLevel, request.autoDetectOrientation);
+
+        if (tesseract::TessBaseAPI* api = warmApi(languageCode, lstmOnly)) {
+            bool nativeOrientation = false;
+            const QImage prepared = TesseractEngine::prepareImage(
+                image, request.preprocessing, request.autoDetectOrientation, &nativeOrientation);
+
+            const int psm = request.psmOverride > 0
+                ? request.psmOverride
+                : TesseractConfig::getPSMForQualityLevel(request.qualityLevel, nativeOrientation);
+            api->SetPageSegMode(static_cast<tesseract::PageSegMode>(psm));
+            // Bytes per pixel from the image itself: Tesseract would read a wider format as a garbled, wider page
+            api->SetImage(prepared.constBits(), prepared.width(), prepared.height(), prepared.depth() / 8, prepared.bytesPerLine());
+
+            char* text = api->GetUTF8Text();
+            OCRResult result;
+            result.text = QString::fromUtf8(text ? text : "").trimmed();
+            delete[] text;
+            collectWords(api, result);
+            api->Clear();
+
+            result.success = !result.text.isEmpty();
+            result.language = request.language;
+            if (!result.success) {
+                result.errorMessage = "Tesseract returned empty output";
+            }
+            return result;
+        }
+#endif
+        // No libtesseract: the worker still isolates crashes but runs the CLI per request
+        return TesseractEngine::performOCRInProcess(
+            image,
+            request.language,
+            request.qualityLevel,
+            request.preprocessing,
+            request.autoDetectOrientation,
+            request.psmOverride);
+    }
+
+#ifdef HAVE_LIBTESSERACT
+    // One initialised engine per language set - loading traineddata is the expensive part
+    tesseract::TessBaseAPI* warmApi(const QString& languageCode, bool lstmOnly)
+    {
+        const QString key = languageCode + (lstmOnly ? "|lstm" : "|default");
+        auto it = m_apis.find(key);
+        if (it != m_apis.end()) {
+            return it->second.get();
+        }
+
+        auto api = std::make_unique<tesseract::TessBaseAPI>();
+        const QByteArray tessdata = TesseractEngine::findTessdataDirectory().toUtf8();
+        const QByteArray language = languageCode.toUtf8();
+        const tesseract::OcrEngineMode mode = lstmOnly ? tesseract::OEM_LSTM_ONLY : tesseract::OEM_DEFAULT;
+        if (api->Init(tessdata.isEmpty() ? nullptr : tessdata.constData(), language.constData(), mode) != 0) {
+            qWarning() << "OCR worker: libtesseract init failed for" << languageCode;
+            return nullptr;
+        }
+
+        qDebug() << "OCR worker: loaded models for" << languageCode;
+        tesseract::TessBaseAPI* raw = api.get();
+        m_apis.emplace(key, std::move(api));
+        return raw;
+    }
+
+    std::map<QString, std::unique_ptr<tesseract::TessBaseAPI>> m_apis;
+#endif
+
+    QString m_serverName;
+    qint64 m_parentPid = 0;
+    QLocalServer m_server;
+    QTimer m_idleTimer;
+    QTimer m_parentTimer;
+    QSharedMemory m_memory;
+    QHash<QLocalSocket*, QByteArray> m_buffers;
+};
+
+} // namespace
+
+bool isWorkerInvocation(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--ocr-worker") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int run(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    // Same identity as the GUI process so QSettings and tessdata lookups match
+    app.setApplicationName("ohao-lang");
+    QCoreApplication::setOrganizationName("ohao");
+    QCoreApplication::setOrganizationDomain("ohao.local");
+
+    QString serverName;
+    qint64 parentPid = 0;
+    const QStringList arguments = app.arguments();
+    for (int i = 1; i + 1 < arguments.size(); ++i) {
+        if (arguments[i] == "--ocr-worker") {
+            serverName = arguments[i + 1];
+        } else if (arguments[i] == "--ocr-parent") {
+            parentPid = arguments[i + 1].toLongLong();
+        }
+    }
+
+    if (serverName.isEmpty()) {
+        qWarning() << "OCR worker started without a server name";
+        return 1;
+    }
+
+    WorkerServer server(serverName, parentPid);
+    if (!server.listen()) {
+        return 1;
+    }
+    return app.exec();
+}
+
+} // namespace OCRWorkerMain
@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * Entry point for OCR worker processes
+ * The app binary doubles as its own worker: OCRWorkerPool starts it with
+ * --ocr-worker <server-name> --ocr-parent <pid>. main() checks for that before
+ * creating a QApplication, so workers stay headless and skip the single-instance
+ * lock.
+ */
+namespace OCRWorkerMain {
+
+bool isWorkerInvocation(int argc, char* argv[]);
+int run(int argc, char* argv[]);
+
+} // namespace OCRWorkerMain
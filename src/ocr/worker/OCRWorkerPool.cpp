@@ -0,0 +1,383 @@
+#include "OCRWorkerPool.h"
+#include "OCRWorkerProtocol.h"
+#include "../../ui/core/AppSettings.h"
+#include <QCoreApplication>
+#include <QSettings>
+#include <QSharedMemory>
+#include <QLocalSocket>
+#include <QProcess>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QDeadlineTimer>
+#include <QMutexLocker>
+#include <QDebug>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#else
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#endif
+#ifdef Q_OS_MACOS
+#include <sys/un.h>
+#endif
+
+namespace {
+
+constexpr int STARTUP_TIMEOUT_MS = 5000;      // Fresh worker: keep retrying the connect this long
+constexpr int CONNECT_TIMEOUT_MS = 500;       // Established worker: one attempt
+constexpr int IO_TIMEOUT_MS = 5000;
+constexpr int RECOGNITION_TIMEOUT_MS = 60000; // Same budget as the CLI path
+constexpr qsizetype SEGMENT_GRANULARITY = 1024 * 1024;
+
+void terminateProcess(qint64 pid)
+{
+    if (pid <= 0) return;
+#ifdef Q_OS_WIN
+    HANDLE handle = OpenProcess(PROCESS_TERMINATE, FALSE, static_cast<DWORD>(pid));
+    if (handle) {
+        TerminateProcess(handle, 1);
+        CloseHandle(handle);
+    }
+#else
+    ::kill(static_cast<pid_t>(pid), SIGKILL);
+#endif
+}
+
+// Process at the other end of a connected local socket, 0 if the platform can't tell
+qint64 peerProcessId(const QLocalSocket& socket)
+{
+    const qintptr descriptor = socket.socketDescriptor();
+    if (descriptor == -1) return 0;
+#if defined(Q_OS_WIN)
+    ULONG pid = 0;
+    return GetNamedPipeServerProcessId(reinterpret_cast<HANDLE>(descriptor), &pid) ? pid : 0;
+#elif defined(Q_OS_MACOS)
+    pid_t pid = 0;
+    socklen_t length = sizeof(pid);
+    return getsockopt(static_cast<int>(descriptor), SOL_LOCAL, LOCAL_PEERPID, &pid, &length) == 0 ? pid : 0;
+#elif defined(SO_PEERCRED)
+    struct ucred credentials {};
+    socklen_t length = sizeof(credentials);
+    return getsockopt(static_cast<int>(descriptor), SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0
+        ? credentials.pid : 0;
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+OCRWorkerPool& OCRWorkerPool::instance()
+{
+    static OCRWorkerPool pool;
+    return pool;
+}
+
+OCRWorkerPool::OCRWorkerPool()
+{
+    QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+    m_workerCount = qMax(0, settings.value("ocr/workerCount", AppSettings::defaultOCRWorkerCount()).toInt());
+    qDebug() << "OCRWorkerPool: configured for" << m_workerCount << "workers";
+}
+
+OCRWorkerPool::~OCRWorkerPool() = default;
+
+void OCRWorkerPool::setWorkerCount(int count)
+{
+    QMutexLocker locker(&m_mutex);
+    m_workerCount = qMax(0, count);
+
+    // Idle workers above the new limit go now; busy ones are retired on release
+    for (auto& worker : m_workers) {
+        if (worker->index >= m_workerCount && !worker->busy) {
+            retireWorker(*worker);
+        }
+    }
+    m_workerAvailable.wakeAll();
+}
+
+int OCRWorkerPool::workerCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_workerCount;
+}
+
+bool OCRWorkerPool::isEnabled() const
+{
+    return workerCount() > 0;
+}
+
+void OCRWorkerPool::prewarm()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_workerCount == 0 || !m_workers.empty()) {
+        return;
+    }
+    auto worker = std::make_unique<Worker>();
+    worker->index = 0;
+    worker->serverName = QString("ohao-ocr-worker-%1-0").arg(QCoreApplication::applicationPid());
+    startWorker(*worker);
+    m_workers.push_back(std::move(worker));
+}
+
+void OCRWorkerPool::shutdown()
+{
+    QMutexLocker locker(&m_mutex);
+    m_workerCount = 0;
+    for (auto& worker : m_workers) {
+        if (!worker->busy) {
+            retireWorker(*worker);
+        }
+    }
+    m_workerAvailable.wakeAll();
+}
+
+OCRWorkerPool::Worker* OCRWorkerPool::acquire()
+{
+    QMutexLocker locker(&m_mutex);
+    while (true) {
+        if (m_workerCount == 0) {
+            return nullptr;
+        }
+
+        // Prefer a running idle worker (models already warm), then a stopped slot
+        Worker* candidate = nullptr;
+        for (auto& worker : m_workers) {
+            if (worker->index >= m_workerCount || worker->busy) continue;
+            if (worker->pid != 0) {
+                candidate = worker.get();
+                break;
+            }
+            if (!candidate) {
+                candidate = worker.get();
+            }
+        }
+
+        if (!candidate && static_cast<int>(m_workers.size()) < m_workerCount) {
+            auto worker = std::make_unique<Worker>();
+            worker->index = static_cast<int>(m_workers.size());
+            worker->serverName = QString("ohao-ocr-worker-%1-%2")
+                .arg(QCoreApplication::applicationPid()).arg(worker->index);
+            candidate = worker.get();
+            m_workers.push_back(std::move(worker));
+        }
+
+        if (candidate) {
+            candidate->busy = true;
+            return candidate;
+        }
+        m_workerAvailable.wait(&m_mutex);
+    }
+}
+
+void OCRWorkerPool::release(Worker* worker)
+{
+    QMutexLocker locker(&m_mutex);
+    worker->busy = false;
+    if (worker->index >= m_workerCount) {
+        retireWorker(*worker);
+    }
+    m_workerAvailable.wakeOne();
+}
+
+bool OCRWorkerPool::startWorker(Worker& worker)
+{
+    const QStringList arguments {
+        "--ocr-worker", worker.serverName,
+        "--ocr-parent", QString::number(QCoreApplication::applicationPid())
+    };
+
+    qint64 pid = 0;
+    if (!QProcess::startDetached(QCoreApplication::applicationFilePath(), arguments, QString(), &pid)) {
+        qDebug() << "OCRWorkerPool: failed to start worker" << worker.index;
+        worker.pid = 0;
+        return false;
+    }
+
+    worker.pid = pid;
+    worker.started.start();
+    qDebug() << "OCRWorkerPool: started worker" << worker.index << "pid" << pid;
+    return true;
+}
+
+void OCRWorkerPool::retireWorker(Worker& worker)
+{
+    if (worker.pid != 0) {
+        // An empty memory key is the shutdown request
+        QLocalSocket socket;
+        socket.connectToServer(worker.serverName);
+        if (socket.waitForConnected(100)) {
+            OCRWorkerProtocol::writeFrame(&socket, OCRWorkerProtocol::encode(OCRWorkerProtocol::Request()), 100);
+            socket.disconnectFromServer();
+        }
+    }
+    forgetWorker(worker);
+}
+
+void OCRWorkerPool::killWorker(Worker& worker, const QLocalSocket& socket)
+{
+    // A worker that crashed mid-request may have had its pid recycled already. Only the process
+    // still holding the other end of this connection is certainly the one we started
+    if (worker.pid != 0 && socket.state() == QLocalSocket::ConnectedState
+        && peerProcessId(socket) == worker.pid) {
+        qDebug() << "OCRWorkerPool: killing worker" << worker.index << "pid" << worker.pid;
+        terminateProcess(worker.pid);
+    }
+    forgetWorker(worker);
+}
+
+void OCRWorkerPool::forgetWorker(Worker& worker)
+{
+    worker.pid = 0;
+    worker.started.invalidate();
+    worker.memory.reset();
+}
+
+bool OCRWorkerPool::uploadImage(Worker& worker, const QImage& image, OCRWorkerProtocol::Request& request)
+{
+    QImage source = image;
+    switch (source.format()) {
+    case QImage::Format_Grayscale8:
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+        break;
+    default:
+        source = source.convertToFormat(QImage::Format_RGB32);
+        break;
+    }
+
+    // Rows are repacked: a view into a larger frame carries the parent's bytesPerLine, and
+    // copying height * bytesPerLine from its first pixel would run past the parent's buffer
+    const qsizetype rowBytes = static_cast<qsizetype>(source.width()) * (source.depth() / 8);
+    const qsizetype stride = (rowBytes + 3) & ~qsizetype(3);
+    const qsizetype bytes = stride * source.height();
+    if (!worker.memory || worker.memory->size() < bytes) {
+        // Grow by replacing the segment under a new key; the worker re-attaches on key change
+        worker.memory.reset();
+        const qsizetype capacity = ((bytes + SEGMENT_GRANULARITY - 1) / SEGMENT_GRANULARITY) * SEGMENT_GRANULARITY;
+        auto memory = std::make_unique<QSharedMemory>(QString("ohao-ocr-shm-%1-%2-%3")
+            .arg(QCoreApplication::applicationPid()).arg(worker.index).arg(++worker.generation));
+        if (!memory->create(capacity) && !(memory->error() == QSharedMemory::AlreadyExists && memory->attach())) {
+            qDebug() << "OCRWorkerPool: shared memory unavailable:" << memory->errorString();
+            return false;
+        }
+        worker.memory = std::move(memory);
+    }
+
+    uchar* target = static_cast<uchar*>(worker.memory->data());
+    if (source.bytesPerLine() == stride) {
+        std::memcpy(target, source.constBits(), static_cast<size_t>(bytes));
+    } else {
+        for (int y = 0; y < source.height(); ++y) {
+            std::memcpy(target + y * stride, source.constScanLine(y), static_cast<size_t>(rowBytes));
+        }
+    }
+
+    request.memoryKey = worker.memory->key();
+    request.width = source.width();
+    request.height = source.height();
+    request.bytesPerLine = static_cast<qint32>(stride);
+    request.format = static_cast<qint32>(source.format());
+    return true;
+}
+
+bool OCRWorkerPool::exchange(Worker& worker, const OCRWorkerProtocol::Request& request, OCRResult& result,
+                             const std::atomic_bool* cancelled)
+{
+    QLocalSocket socket;
+
+    // A freshly spawned worker needs a moment before it listens; an idle-reaped one never will
+    const bool starting = worker.started.isValid() && worker.started.elapsed() < STARTUP_TIMEOUT_MS;
+    QDeadlineTimer deadline(starting ? STARTUP_TIMEOUT_MS - worker.started.elapsed() : CONNECT_TIMEOUT_MS);
+    while (true) {
+        socket.connectToServer(worker.serverName);
+        if (socket.waitForConnected(CONNECT_TIMEOUT_MS)) break;
+        if (!starting || deadline.hasExpired()) {
+            // Nothing listening: crashed or exited after its idle timeout
+            forgetWorker(worker);
+            return false;
+        }
+        socket.abort();
+        QThread::msleep(25);
+    }
+
+    if (!OCRWorkerProtocol::writeFrame(&socket, OCRWorkerProtocol::encode(request), IO_TIMEOUT_MS)) {
+        killWorker(worker, socket);
+        return false;
+    }
+
+    QByteArray payload;
+    if (!OCRWorkerProtocol::readFrame(&socket, payload, RECOGNITION_TIMEOUT_MS, cancelled)) {
+        // Crashed or hung mid-request, or still busy with an abandoned one - make sure it's gone
+        // so the next request gets a clean worker
+        qDebug() << "OCRWorkerPool: worker" << worker.index
+                 << (cancelled && cancelled->load() ? "abandoned, restarting" : "did not answer, restarting");
+        killWorker(worker, socket);
+        return false;
+    }
+
+    OCRWorkerProtocol::Response response;
+    if (!OCRWorkerProtocol::decode(payload, response)) {
+        killWorker(worker, socket);
+        return false;
+    }
+    socket.disconnectFromServer();
+
+    result = OCRResult();
+    result.success = response.success;
+    result.text = response.text;
+    result.language = response.language;
+    result.errorMessage = response.errorMessage;
+    result.confidence = response.confidence.isEmpty() ? QString("N/A") : response.confidence;
+    for (const OCRWorkerProtocol::Word& word : std::as_const(response.words)) {
+        OCRResult::OCRToken token;
+        token.text = word.text;
+        token.box = word.box;
+        token.confidence = word.confidence;
+        token.lineId = word.lineId;
+        result.tokens.append(token);
+    }
+    return true;
+}
+
+bool OCRWorkerPool::recognize(
+    const QImage& image,
+    const QString& language,
+    int qualityLevel,
+    bool preprocessing,
+    bool autoDetectOrientation,
+    int psmOverride,
+    OCRResult& result,
+    const std::atomic_bool* cancelled)
+{
+    if (image.isNull() || (cancelled && cancelled->load())) {
+        return false;
+    }
+
+    Worker* worker = acquire();
+    if (!worker) {
+        return false;
+    }
+
+    OCRWorkerProtocol::Request request;
+    request.language = language;
+    request.qualityLevel = qualityLevel;
+    request.preprocessing = preprocessing;
+    request.autoDetectOrientation = autoDetectOrientation;
+    request.psmOverride = psmOverride;
+
+    // Second attempt covers a worker that crashed or was reaped while idle:
+    // exchange() forgets a dead worker, so it is simply started again here
+    bool served = false;
+    for (int attempt = 0; attempt < 2 && !served && !(cancelled && cancelled->load()); ++attempt) {
+        if (worker->pid == 0 && !startWorker(*worker)) break;
+        if (!uploadImage(*worker, image, request)) break;
+        served = exchange(*worker, request, result, cancelled);
+    }
+    release(worker);
+    return served;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QImage>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "../OCREngine.h"
+
+class QLocalSocket;
+class QSharedMemory;
+
+namespace OCRWorkerProtocol { struct Request; }
+
+/**
+ * Pool of long-lived OCR worker processes
+ * Each worker is this executable started with --ocr-worker. It keeps its
+ * recognition models loaded between requests. Images are handed over through
+ * a per-worker shared memory segment, and requests/results travel as framed
+ * messages on a local socket. Workers exit on their own after an idle period.
+ * A worker that crashed or was reaped is restarted on the next request.
+ *
+ * recognize() is blocking and thread-safe. Concurrent callers (table cells)
+ * each get their own worker, up to workerCount(). A caller that gives up on its
+ * request (cancelled) has the worker killed, so it stops taking CPU from the next.
+ */
+class OCRWorkerPool
+{
+public:
+    static OCRWorkerPool& instance();
+
+    // 0 runs OCR in-process (no workers)
+    void setWorkerCount(int count);
+    int workerCount() const;
+    bool isEnabled() const;
+
+    // Start the first worker in the background so the first capture doesn't pay for it
+    void prewarm();
+
+    // Ask every worker to exit (called once the event loop has finished)
+    void shutdown();
+
+    // Returns false when no worker could serve the request; caller falls back to in-process OCR
+    // unless *cancelled was set, which abandons the request
+    bool recognize(
+        const QImage& image,
+        const QString& language,
+        int qualityLevel,
+        bool preprocessing,
+        bool autoDetectOrientation,
+        int psmOverride,
+        OCRResult& result,
+        const std::atomic_bool* cancelled = nullptr
+    );
+
+private:
+    struct Worker {
+        int index = 0;
+        QString serverName;
+        qint64 pid = 0;
+        bool busy = false;
+        int generation = 0;
+        QElapsedTimer started;
+        std::unique_ptr<QSharedMemory> memory;
+    };
+
+    OCRWorkerPool();
+    ~OCRWorkerPool();
+    OCRWorkerPool(const OCRWorkerPool&) = delete;
+    OCRWorkerPool& operator=(const OCRWorkerPool&) = delete;
+
+    Worker* acquire();
+    void release(Worker* worker);
+    bool startWorker(Worker& worker);
+    void retireWorker(Worker& worker);   // polite shutdown request
+    void killWorker(Worker& worker, const QLocalSocket& socket);  // hung or misbehaving worker
+    void forgetWorker(Worker& worker);   // worker already gone (crashed or idle-reaped)
+    bool uploadImage(Worker& worker, const QImage& image, OCRWorkerProtocol::Request& request);
+    bool exchange(Worker& worker, const OCRWorkerProtocol::Request& request, OCRResult& result,
+                  const std::atomic_bool* cancelled);
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_workerAvailable;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    int m_workerCount = 0;
+};
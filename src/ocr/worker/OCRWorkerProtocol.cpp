@@ -0,0 +1,149 @@
+#include "OCRWorkerProtocol.h"
+#include <QDataStream>
+#include <QDeadlineTimer>
+#include <QLocalSocket>
+#include <QtEndian>
+
+namespace OCRWorkerProtocol {
+
+namespace {
+
+constexpr int HEADER_BYTES = sizeof(quint32);
+
+bool readHeader(QDataStream& stream)
+{
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    return stream.status() == QDataStream::Ok && magic == MAGIC && version == VERSION;
+}
+
+} // namespace
+
+QByteArray frame(const QByteArray& payload)
+{
+    QByteArray bytes(HEADER_BYTES, Qt::Uninitialized);
+    qToBigEndian<quint32>(static_cast<quint32>(payload.size()), bytes.data());
+    bytes.append(payload);
+    return bytes;
+}
+
+QByteArray encode(const Request& request)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << MAGIC << VERSION
+           << request.memoryKey << request.width << request.height << request.bytesPerLine << request.format
+           << request.language << request.qualityLevel << request.preprocessing
+           << request.autoDetectOrientation << request.psmOverride;
+    return payload;
+}
+
+QByteArray encode(const Response& response)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << MAGIC << VERSION
+           << response.success << response.text << response.language << response.errorMessage
+           << response.confidence << static_cast<qint32>(response.words.size());
+    for (const Word& word : response.words) {
+        stream << word.text << word.box << word.confidence << word.lineId;
+    }
+    return payload;
+}
+
+bool decode(const QByteArray& payload, Request& request)
+{
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_6_0);
+    if (!readHeader(stream)) {
+        return false;
+    }
+    stream >> request.memoryKey >> request.width >> request.height >> request.bytesPerLine >> request.format
+           >> request.language >> request.qualityLevel >> request.preprocessing
+           >> request.autoDetectOrientation >> request.psmOverride;
+    return stream.status() == QDataStream::Ok;
+}
+
+bool decode(const QByteArray& payload, Response& response)
+{
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_6_0);
+    if (!readHeader(stream)) {
+        return false;
+    }
+    qint32 wordCount = 0;
+    stream >> response.success >> response.text >> response.language >> response.errorMessage
+           >> response.confidence >> wordCount;
+    if (stream.status() != QDataStream::Ok || wordCount < 0) {
+        return false;
+    }
+    response.words.clear();
+    for (qint32 i = 0; i < wordCount && stream.status() == QDataStream::Ok; ++i) {
+        Word word;
+        stream >> word.text >> word.box >> word.confidence >> word.lineId;
+        response.words.append(word);
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+bool writeFrame(QLocalSocket* socket, const QByteArray& payload, int timeoutMs)
+{
+    const QByteArray bytes = frame(payload);
+    if (socket->write(bytes) != bytes.size()) {
+        return false;
+    }
+    QDeadlineTimer deadline(timeoutMs);
+    while (socket->bytesToWrite() > 0) {
+        if (!socket->waitForBytesWritten(static_cast<int>(deadline.remainingTime()))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readFrame(QLocalSocket* socket, QByteArray& payload, int timeoutMs, const std::atomic_bool* cancelled)
+{
+    QDeadlineTimer deadline(timeoutMs);
+    QByteArray buffer;
+    while (true) {
+        buffer.append(socket->readAll());
+        if (takeFrame(buffer, payload)) {
+            return true;
+        }
+        if (socket->state() != QLocalSocket::ConnectedState && socket->bytesAvailable() == 0) {
+            return false;
+        }
+        if (deadline.hasExpired() || (cancelled && cancelled->load())) {
+            return false;
+        }
+        const qint64 remaining = deadline.remainingTime();
+        const int wait = static_cast<int>(cancelled ? qMin<qint64>(remaining, CANCEL_POLL_MS) : remaining);
+        if (!socket->waitForReadyRead(wait) && socket->state() != QLocalSocket::ConnectedState) {
+            return false;
+        }
+    }
+}
+
+bool takeFrame(QByteArray& buffer, QByteArray& payload)
+{
+    if (buffer.size() < HEADER_BYTES) {
+        return false;
+    }
+    const quint32 length = qFromBigEndian<quint32>(buffer.constData());
+    if (length > MAX_FRAME_BYTES) {
+        // Corrupt stream - drop it so the caller reconnects
+        buffer.clear();
+        return false;
+    }
+    if (buffer.size() < HEADER_BYTES + static_cast<int>(length)) {
+        return false;
+    }
+    payload = buffer.mid(HEADER_BYTES, length);
+    buffer.remove(0, HEADER_BYTES + length);
+    return true;
+}
+
+} // namespace OCRWorkerProtocol
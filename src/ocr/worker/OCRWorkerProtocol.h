@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QByteArray>
+#include <QRect>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+class QLocalSocket;
+
+/**
+ * Wire format between the app and its OCR worker processes
+ * Every message is one frame: a big-endian quint32 payload length followed by
+ * a QDataStream payload. Pixels never go over the socket - the request names a
+ * shared memory segment that already holds the image.
+ */
+namespace OCRWorkerProtocol {
+
+constexpr quint32 MAGIC = 0x4f435257;          // "OCRW"
+constexpr quint16 VERSION = 2;
+constexpr quint32 MAX_FRAME_BYTES = 16 * 1024 * 1024;
+constexpr int CANCEL_POLL_MS = 50;
+
+struct Request {
+    QString memoryKey;       // QSharedMemory key holding the pixels
+    qint32 width = 0;
+    qint32 height = 0;
+    qint32 bytesPerLine = 0;
+    qint32 format = 0;       // QImage::Format
+    QString language;
+    qint32 qualityLevel = 3;
+    bool preprocessing = true;
+    bool autoDetectOrientation = true;
+    qint32 psmOverride = 0;
+};
+
+struct Word {
+    QString text;
+    QRect box;               // In the recognised image
+    float confidence = -1.f; // 0-100
+    qint32 lineId = -1;
+};
+
+struct Response {
+    bool success = false;
+    QString text;
+    QString language;
+    QString errorMessage;
+    QString confidence;      // Mean word confidence, "N/A" when the CLI produced the text
+    QVector<Word> words;     // Only filled by libtesseract
+};
+
+QByteArray encode(const Request& request);
+QByteArray encode(const Response& response);
+bool decode(const QByteArray& payload, Request& request);
+bool decode(const QByteArray& payload, Response& response);
+
+// Length-prefixes a payload
+QByteArray frame(const QByteArray& payload);
+
+// Blocking helpers for the client side (no event loop needed)
+bool writeFrame(QLocalSocket* socket, const QByteArray& payload, int timeoutMs);
+// Also gives up once *cancelled is set (polled every CANCEL_POLL_MS while waiting)
+bool readFrame(QLocalSocket* socket, QByteArray& payload, int timeoutMs,
+               const std::atomic_bool* cancelled = nullptr);
+
+// Event-driven helper for the worker: pops one complete frame off buffer if present
+bool takeFrame(QByteArray& buffer, QByteArray& payload);
+
+} // namespace OCRWorkerProtocol
@@ -0,0 +1,505 @@
+#include "CapabilityRegistry.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+#include <QDebug>
+
+namespace {
+
+constexpr int CACHE_VERSION = 1;
+
+#ifdef Q_OS_WIN
+const QString EXE_SUFFIX = QStringLiteral(".exe");
+#else
+const QString EXE_SUFFIX;
+#endif
+
+// Absolute path for a bundled file or a bare command name on PATH; empty if neither exists
+QString locate(const QString& candidate)
+{
+    if (candidate.contains('/') || candidate.contains('\\')) {
+        QFileInfo info(candidate);
+        return info.isFile() ? info.absoluteFilePath() : QString();
+    }
+    return QStandardPaths::findExecutable(candidate);
+}
+
+// OCR worker processes have no GUI; their main thread may wait for the probe
+bool onGuiThread()
+{
+    const QCoreApplication* app = QCoreApplication::instance();
+    return qobject_cast<const QGuiApplication*>(app) && QThread::currentThread() == app->thread();
+}
+
+} // namespace
+
+CapabilityRegistry& CapabilityRegistry::instance()
+{
+    static CapabilityRegistry registry;
+    return registry;
+}
+
+void CapabilityRegistry::probeAsync()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_state != State::Idle) {
+            return;
+        }
+        m_state = State::Probing;
+    }
+    QThreadPool::globalInstance()->start([this]() { runProbe(); });
+}
+
+void CapabilityRegistry::refresh()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_state == State::Probing) {
+            // It may have looked before the tool was installed
+            m_refreshQueued = true;
+            return;
+        }
+        // Until the new probe is done, GUI queries keep getting the current results
+        m_state = State::Idle;
+    }
+    forgetFailures();
+    probeAsync();
+}
+
+bool CapabilityRegistry::isReady() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_state == State::Ready;
+}
+
+bool CapabilityRegistry::hasTesseract()
+{
+    return !capabilities().tesseractPath.isEmpty();
+}
+
+QString CapabilityRegistry::tesseractPath()
+{
+    return capabilities().tesseractPath;
+}
+
+QString CapabilityRegistry::tessdataDirectory()
+{
+    return capabilities().tessdataDirectory;
+}
+
+QStringList CapabilityRegistry::tessdataLanguages()
+{
+    return capabilities().tessdataLanguages;
+}
+
+bool CapabilityRegistry::hasTessdataLanguage(const QString& code)
+{
+    const QStringList installed = capabilities().tessdataLanguages;
+    const QStringList wanted = code.split('+', Qt::SkipEmptyParts);
+    if (wanted.isEmpty()) {
+        return false;
+    }
+    for (const QString& language : wanted) {
+        if (!installed.contains(language)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CapabilityRegistry::hasImageMagick()
+{
+    return !capabilities().imageMagickPath.isEmpty();
+}
+
+QString CapabilityRegistry::imageMagickPath()
+{
+    return capabilities().imageMagickPath;
+}
+
+bool CapabilityRegistry::hasEdgeTts()
+{
+    return !capabilities().edgeTtsPath.isEmpty();
+}
+
+QString CapabilityRegistry::edgeTtsPath()
+{
+    return capabilities().edgeTtsPath;
+}
+
+CapabilityRegistry::Capabilities CapabilityRegistry::capabilities()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_state == State::Ready) {
+        return m_capabilities;
+    }
+
+    if (onGuiThread()) {
+        // Never wait for tools to run here: the last results, empty before the first probe
+        if (m_state == State::Idle) {
+            locker.unlock();
+            probeAsync();
+            locker.relock();
+        }
+        return m_capabilities;
+    }
+
+    if (m_state == State::Idle) {
+        // Nobody started a probe (e.g. OCR worker processes) - do it on this thread
+        m_state = State::Probing;
+        locker.unlock();
+        runProbe();
+        locker.relock();
+    }
+
+    while (m_state != State::Ready) {
+        m_ready.wait(&m_mutex);
+    }
+    return m_capabilities;
+}
+
+void CapabilityRegistry::runProbe()
+{
+    while (true) {
+        const Capabilities probed = probe();
+
+        QMutexLocker locker(&m_mutex);
+        m_capabilities = probed;
+        if (!m_refreshQueued) {
+            m_state = State::Ready;
+            m_ready.wakeAll();
+            return;
+        }
+        m_refreshQueued = false;
+        locker.unlock();
+        forgetFailures();
+    }
+}
+
+CapabilityRegistry::Capabilities CapabilityRegistry::probe()
+{
+    loadCache();
+
+    Capabilities result;
+    result.tesseractPath = resolveTesseract();
+    result.tessdataDirectory = resolveTessdata(result.tesseractPath, result.tessdataLanguages);
+    result.imageMagickPath = resolveImageMagick();
+    result.edgeTtsPath = resolveEdgeTts();
+
+    saveCache();
+
+    qDebug() << "CapabilityRegistry: tesseract:" << (result.tesseractPath.isEmpty() ? "missing" : result.tesseractPath)
+             << "languages:" << result.tessdataLanguages.join(',')
+             << "imagemagick:" << (result.imageMagickPath.isEmpty() ? "missing" : result.imageMagickPath)
+             << "edge-tts:" << (result.edgeTtsPath.isEmpty() ? "missing" : result.edgeTtsPath);
+    return result;
+}
+
+QString CapabilityRegistry::resolveTesseract()
+{
+    const QString exeName = "tesseract" + EXE_SUFFIX;
+    const QString appDir = QCoreApplication::applicationDirPath();
+
+    // 1. Bundled next to the app, 2. anywhere below the app directory, 3. system PATH
+    QStringList candidates;
+    candidates << appDir + "/tesseract/" + exeName;
+
+    // Breadth-first so shallower copies win, same depth limit as the old recursive search
+    QStringList level{appDir};
+    for (int depth = 0; depth < 3 && !level.isEmpty(); ++depth) {
+        QStringList next;
+        for (const QString& dirPath : level) {
+            QDir dir(dirPath);
+            const QString candidate = dir.filePath(exeName);
+            if (QFile::exists(candidate) && !candidates.contains(candidate)) {
+                candidates << candidate;
+            }
+            for (const QString& subdir : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+                next << dir.filePath(subdir);
+            }
+        }
+        level = next;
+    }
+    candidates << "tesseract";
+
+    for (const QString& candidate : candidates) {
+        const QString path = locate(candidate);
+        if (!path.isEmpty() && verify(path, QStringList() << "--version", QString(), 3000)) {
+            return path;
+        }
+    }
+    return QString();
+}
+
+QString CapabilityRegistry::resolveTessdata(const QString& tesseractPath, QStringList& languages)
+{
+    languages.clear();
+
+    QStringList candidates;
+    // 1) Bundled tessdata next to the app
+    candidates << QCoreApplication::applicationDirPath() + "/tesseract/tessdata";
+
+    // 2) Allow TESSDATA_PREFIX override
+    if (!qEnvironmentVariableIsEmpty("TESSDATA_PREFIX")) {
+        QString prefix = QString::fromUtf8(qgetenv("TESSDATA_PREFIX"));
+        candidates << (prefix.endsWith("/tessdata") || prefix.endsWith("\\tessdata")
+            ? prefix
+            : (prefix + "/tessdata"));
+    }
+
+    // 3) Fall back to system installation (Scoop path)
+#ifdef Q_OS_WIN
+    candidates << QDir::homePath() + "/scoop/persist/tesseract/tessdata";
+#endif
+
+    for (const QString& candidate : candidates) {
+        if (!QFile::exists(candidate + "/eng.traineddata")) {
+            continue;
+        }
+        const QStringList files = QDir(candidate).entryList(QStringList() << "*.traineddata", QDir::Files, QDir::Name);
+        for (const QString& file : files) {
+            languages << QFileInfo(file).completeBaseName();
+        }
+        return candidate;
+    }
+
+    // No directory we know of: tesseract uses its compiled-in default, so ask it
+    if (!tesseractPath.isEmpty()) {
+        languages = listLanguages(tesseractPath);
+    }
+    return QString();
+}
+
+QString CapabilityRegistry::resolveImageMagick()
+{
+    // ImageMagick 7 ships "magick"; fall back to the IM6 "convert" name
+    QStringList candidates;
+    candidates << "magick";
+#ifndef Q_OS_WIN
+    // On Windows "convert" is the FAT-to-NTFS system tool
+    candidates << "convert";
+#endif
+
+    for (const QString& candidate : candidates) {
+        const QString path = locate(candidate);
+        if (!path.isEmpty() && verify(path, QStringList() << "-version", "ImageMagick", 3000)) {
+            return path;
+        }
+    }
+    return QString();
+}
+
+QString CapabilityRegistry::resolveEdgeTts()
+{
+    QStringList candidates;
+#ifdef Q_OS_WIN
+    // 1. Bundled edge-tts.exe in application directory (from CMake build)
+    candidates << QCoreApplication::applicationDirPath() + "/edge-tts.exe";
+    // 2. Legacy path (edge-tts subdirectory, for backwards compatibility)
+    candidates << QCoreApplication::applicationDirPath() + "/edge-tts/edge-tts.exe";
+#endif
+    // 3. System-installed edge-tts (from pip, cross-platform)
+    candidates << "edge-tts";
+
+    for (const QString& candidate : candidates) {
+        const QString path = locate(candidate);
+        // --help proves the CLI runs without the network round trip --list-voices needs
+        if (!path.isEmpty() && verify(path, QStringList() << "--help", "--list-voices", 5000)) {
+            return path;
+        }
+    }
+    return QString();
+}
+
+bool CapabilityRegistry::verify(const QString& path, const QStringList& arguments, const QString& expectedOutput, int timeoutMs)
+{
+    const QFileInfo info(path);
+    const qint64 size = info.size();
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        auto it = m_cache.constFind(path);
+        if (it != m_cache.constEnd() && it->size == size && it->modified == modified) {
+            return it->ok;
+        }
+    }
+
+    QProcess process;
+    process.start(path, arguments);
+    bool ok = process.waitForFinished(timeoutMs)
+        && process.exitStatus() == QProcess::NormalExit
+        && process.exitCode() == 0;
+    if (ok && !expectedOutput.isEmpty()) {
+        const QString output = QString::fromUtf8(process.readAllStandardOutput() + process.readAllStandardError());
+        ok = output.contains(expectedOutput);
+    }
+    if (process.state() != QProcess::NotRunning) {
+        process.kill();
+        process.waitForFinished(1000);
+    }
+
+    qDebug() << "CapabilityRegistry: ran" << path << arguments << "->" << (ok ? "ok" : "unusable");
+
+    QMutexLocker locker(&m_cacheMutex);
+    ProbeRecord& record = m_cache[path];
+    record.size = size;
+    record.modified = modified;
+    record.ok = ok;
+    // A different binary may have different languages compiled in
+    record.languagesListed = false;
+    record.languages.clear();
+    m_cacheDirty = true;
+    return ok;
+}
+
+QStringList CapabilityRegistry::listLanguages(const QString& tesseractPath)
+{
+    const QFileInfo info(tesseractPath);
+    const qint64 size = info.size();
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        auto it = m_cache.constFind(tesseractPath);
+        if (it != m_cache.constEnd() && it->size == size && it->modified == modified && it->languagesListed) {
+            return it->languages;
+        }
+    }
+
+    QStringList languages;
+    QProcess process;
+    process.start(tesseractPath, QStringList() << "--list-langs");
+    const bool ok = process.waitForFinished(3000) && process.exitCode() == 0;
+    if (ok) {
+        const QStringList lines = QString::fromUtf8(process.readAllStandardOutput()).split('\n', Qt::SkipEmptyParts);
+        // First line is the "List of available languages ..." header
+        for (int i = 1; i < lines.size(); ++i) {
+            languages << lines[i].trimmed();
+        }
+    }
+    if (process.state() != QProcess::NotRunning) {
+        process.kill();
+        process.waitForFinished(1000);
+    }
+    qDebug() << "CapabilityRegistry: ran" << tesseractPath << "--list-langs ->" << languages.size() << "languages";
+
+    // Kept with the binary's --version verdict, which verify() has just brought up to date
+    QMutexLocker locker(&m_cacheMutex);
+    auto it = m_cache.find(tesseractPath);
+    if (ok && it != m_cache.end() && it->size == size && it->modified == modified) {
+        it->languagesListed = true;
+        it->languages = languages;
+        m_cacheDirty = true;
+    }
+    return languages;
+}
+
+QString CapabilityRegistry::cacheFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/capabilities.json";
+}
+
+void CapabilityRegistry::loadCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    if (m_cacheLoaded) {
+        return;
+    }
+    m_cacheLoaded = true;
+
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != CACHE_VERSION) {
+        return;
+    }
+
+    const QJsonObject probes = root.value("probes").toObject();
+    for (auto it = probes.constBegin(); it != probes.constEnd(); ++it) {
+        const QJsonObject entry = it.value().toObject();
+        ProbeRecord record;
+        record.size = entry.value("size").toInteger(-1);
+        record.modified = entry.value("modified").toInteger();
+        record.ok = entry.value("ok").toBool();
+        if (!record.ok) {
+            continue;  // Written by older versions; a missing tool is always looked for again
+        }
+        record.languagesListed = entry.contains("languages");
+        for (const QJsonValue& language : entry.value("languages").toArray()) {
+            record.languages << language.toString();
+        }
+        m_cache.insert(it.key(), record);
+    }
+}
+
+void CapabilityRegistry::forgetFailures()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    for (auto it = m_cache.begin(); it != m_cache.end();) {
+        if (!it->ok) {
+            it = m_cache.erase(it);
+            continue;
+        }
+        // New traineddata may have been installed next to the same binary
+        if (it->languagesListed) {
+            it->languagesListed = false;
+            it->languages.clear();
+            m_cacheDirty = true;
+        }
+        ++it;
+    }
+}
+
+void CapabilityRegistry::saveCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    if (!m_cacheDirty) {
+        return;
+    }
+
+    QJsonObject probes;
+    for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+        if (!it->ok) {
+            continue;  // Only for this run: the user may install or fix the tool before the next
+        }
+        QJsonObject entry;
+        entry.insert("size", it->size);
+        entry.insert("modified", it->modified);
+        entry.insert("ok", it->ok);
+        if (it->languagesListed) {
+            entry.insert("languages", QJsonArray::fromStringList(it->languages));
+        }
+        probes.insert(it.key(), entry);
+    }
+
+    QJsonObject root;
+    root.insert("version", CACHE_VERSION);
+    root.insert("probes", probes);
+
+    const QString path = cacheFilePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    // Atomic replace - OCR worker processes may read this at the same time
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        if (file.commit()) {
+            m_cacheDirty = false;
+        }
+    }
+}
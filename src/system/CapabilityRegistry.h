@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QWaitCondition>
+
+/**
+ * Which external tools this machine has, probed once per run
+ * Resolves tesseract (plus its installed tessdata languages), ImageMagick and
+ * edge-tts on a background thread at startup. A working binary is only executed
+ * again when its path, size or mtime differs from the on-disk cache, so a normal
+ * start spawns nothing. Missing or broken tools are not cached on disk; they are
+ * looked for again on the next start or refresh().
+ *
+ * All queries are answered from memory. A query on a worker thread that arrives
+ * before the probe has finished waits for it. A GUI-thread query never waits: it
+ * gets the last results, which are empty until the first probe is done, so
+ * "missing" there only means missing once isReady() is true.
+ */
+class CapabilityRegistry
+{
+public:
+    static CapabilityRegistry& instance();
+
+    // Start probing on the global thread pool (no-op if already started)
+    void probeAsync();
+
+    // Look again for tools found missing (e.g. after the user installs one); doesn't block
+    void refresh();
+
+    bool isReady() const;
+
+    bool hasTesseract();
+    QString tesseractPath();
+    QString tessdataDirectory();
+    QStringList tessdataLanguages();
+    bool hasTessdataLanguage(const QString& code);   // accepts "eng+fra" style codes
+
+    bool hasImageMagick();
+    QString imageMagickPath();
+
+    bool hasEdgeTts();
+    QString edgeTtsPath();
+
+private:
+    struct Capabilities {
+        QString tesseractPath;
+        QString tessdataDirectory;
+        QStringList tessdataLanguages;
+        QString imageMagickPath;
+        QString edgeTtsPath;
+    };
+
+    // Result of running a binary once, remembered across launches
+    struct ProbeRecord {
+        qint64 size = -1;
+        qint64 modified = 0;
+        bool ok = false;
+        bool languagesListed = false;  // tesseract only: --list-langs ran for this exact file
+        QStringList languages;
+    };
+
+    enum class State { Idle, Probing, Ready };
+
+    CapabilityRegistry() = default;
+    CapabilityRegistry(const CapabilityRegistry&) = delete;
+    CapabilityRegistry& operator=(const CapabilityRegistry&) = delete;
+
+    Capabilities capabilities();
+    void runProbe();
+    Capabilities probe();
+
+    QString resolveTesseract();
+    QString resolveTessdata(const QString& tesseractPath, QStringList& languages);
+    QString resolveImageMagick();
+    QString resolveEdgeTts();
+
+    // Runs path with arguments unless the cache already knows the answer for this exact file
+    bool verify(const QString& path, const QStringList& arguments, const QString& expectedOutput, int timeoutMs);
+    // tesseract --list-langs, likewise only run when the cache has no list for this exact file
+    QStringList listLanguages(const QString& tesseractPath);
+
+    void loadCache();
+    void saveCache();
+    // Drops the in-memory negative verdicts and language lists so they are run again
+    void forgetFailures();
+    static QString cacheFilePath();
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_ready;
+    State m_state = State::Idle;
+    bool m_refreshQueued = false;  // refresh() during a probe: probe again once it's done
+    Capabilities m_capabilities;
+
+    QMutex m_cacheMutex;
+    QHash<QString, ProbeRecord> m_cache;
+    bool m_cacheLoaded = false;
+    bool m_cacheDirty = false;
+};
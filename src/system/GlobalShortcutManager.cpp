@@ -22,6 +22,72 @@
 #include <xcb/xproto.h>
 #endif
 
+namespace {
+
+#ifdef Q_OS_WIN
+constexpr int REGION_HOTKEY_BASE = 100;   // Saved region i is hotkey id REGION_HOTKEY_BASE + i
+
+// Virtual key for letters, digits and F-keys; 0 for anything else
+UINT virtualKey(Qt::Key key)
+{
+    if ((key >= Qt::Key_A && key <= Qt::Key_Z) || (key >= Qt::Key_0 && key <= Qt::Key_9)) {
+        return static_cast<UINT>(key); // Same codes as ASCII
+    }
+    if (key >= Qt::Key_F1 && key <= Qt::Key_F24) {
+        return VK_F1 + (key - Qt::Key_F1);
+    }
+    return 0;
+}
+#endif
+
+#ifdef Q_OS_MACOS
+// Carbon virtual key code for letters and digits, -1 for anything else
+int carbonKeyCode(int key)
+{
+    switch (key) {
+        case Qt::Key_A: return kVK_ANSI_A;
+        case Qt::Key_B: return kVK_ANSI_B;
+        case Qt::Key_C: return kVK_ANSI_C;
+        case Qt::Key_D: return kVK_ANSI_D;
+        case Qt::Key_E: return kVK_ANSI_E;
+        case Qt::Key_F: return kVK_ANSI_F;
+        case Qt::Key_G: return kVK_ANSI_G;
+        case Qt::Key_H: return kVK_ANSI_H;
+        case Qt::Key_I: return kVK_ANSI_I;
+        case Qt::Key_J: return kVK_ANSI_J;
+        case Qt::Key_K: return kVK_ANSI_K;
+        case Qt::Key_L: return kVK_ANSI_L;
+        case Qt::Key_M: return kVK_ANSI_M;
+        case Qt::Key_N: return kVK_ANSI_N;
+        case Qt::Key_O: return kVK_ANSI_O;
+        case Qt::Key_P: return kVK_ANSI_P;
+        case Qt::Key_Q: return kVK_ANSI_Q;
+        case Qt::Key_R: return kVK_ANSI_R;
+        case Qt::Key_S: return kVK_ANSI_S;
+        case Qt::Key_T: return kVK_ANSI_T;
+        case Qt::Key_U: return kVK_ANSI_U;
+        case Qt::Key_V: return kVK_ANSI_V;
+        case Qt::Key_W: return kVK_ANSI_W;
+        case Qt::Key_X: return kVK_ANSI_X;
+        case Qt::Key_Y: return kVK_ANSI_Y;
+        case Qt::Key_Z: return kVK_ANSI_Z;
+        case Qt::Key_0: return kVK_ANSI_0;
+        case Qt::Key_1: return kVK_ANSI_1;
+        case Qt::Key_2: return kVK_ANSI_2;
+        case Qt::Key_3: return kVK_ANSI_3;
+        case Qt::Key_4: return kVK_ANSI_4;
+        case Qt::Key_5: return kVK_ANSI_5;
+        case Qt::Key_6: return kVK_ANSI_6;
+        case Qt::Key_7: return kVK_ANSI_7;
+        case Qt::Key_8: return kVK_ANSI_8;
+        case Qt::Key_9: return kVK_ANSI_9;
+        default: return -1;
+    }
+}
+#endif
+
+} // namespace
+
 GlobalShortcutManager::GlobalShortcutManager(QObject *parent)
     : QObject(parent)
 {
@@ -100,36 +166,9 @@ void GlobalShortcutManager::registerShortcuts()
         int baseKey = key & ~(Qt::MetaModifier | Qt::ShiftModifier | Qt::ControlModifier | Qt::AltModifier);
         
         // Map Qt keys to Carbon virtual key codes
-        switch (baseKey) {
-            case Qt::Key_A: keyCode = kVK_ANSI_A; break;
-            case Qt::Key_B: keyCode = kVK_ANSI_B; break;
-            case Qt::Key_C: keyCode = kVK_ANSI_C; break;
-            case Qt::Key_D: keyCode = kVK_ANSI_D; break;
-            case Qt::Key_E: keyCode = kVK_ANSI_E; break;
-            case Qt::Key_F: keyCode = kVK_ANSI_F; break;
-            case Qt::Key_G: keyCode = kVK_ANSI_G; break;
-            case Qt::Key_H: keyCode = kVK_ANSI_H; break;
-            case Qt::Key_I: keyCode = kVK_ANSI_I; break;
-            case Qt::Key_J: keyCode = kVK_ANSI_J; break;
-            case Qt::Key_K: keyCode = kVK_ANSI_K; break;
-            case Qt::Key_L: keyCode = kVK_ANSI_L; break;
-            case Qt::Key_M: keyCode = kVK_ANSI_M; break;
-            case Qt::Key_N: keyCode = kVK_ANSI_N; break;
-            case Qt::Key_O: keyCode = kVK_ANSI_O; break;
-            case Qt::Key_P: keyCode = kVK_ANSI_P; break;
-            case Qt::Key_Q: keyCode = kVK_ANSI_Q; break;
-            case Qt::Key_R: keyCode = kVK_ANSI_R; break;
-            case Qt::Key_S: keyCode = kVK_ANSI_S; break;
-            case Qt::Key_T: keyCode = kVK_ANSI_T; break;
-            case Qt::Key_U: keyCode = kVK_ANSI_U; break;
-            case Qt::Key_V: keyCode = kVK_ANSI_V; break;
-            case Qt::Key_W: keyCode = kVK_ANSI_W; break;
-            case Qt::Key_X: keyCode = kVK_ANSI_X; break;
-            case Qt::Key_Y: keyCode = kVK_ANSI_Y; break;
-            case Qt::Key_Z: keyCode = kVK_ANSI_Z; break;
-            default:
-                qWarning() << "Unsupported key for screenshot shortcut:" << baseKey;
-                keyCode = -1;
+        keyCode = carbonKeyCode(baseKey);
+        if (keyCode < 0) {
+            qWarning() << "Unsupported key for screenshot shortcut:" << baseKey;
         }
         
         if (keyCode >= 0) {
@@ -170,36 +209,10 @@ void GlobalShortcutManager::registerShortcuts()
         
         int baseKey = key & ~(Qt::MetaModifier | Qt::ShiftModifier | Qt::ControlModifier | Qt::AltModifier);
         
-        switch (baseKey) {
-            case Qt::Key_A: keyCode = kVK_ANSI_A; break;
-            case Qt::Key_B: keyCode = kVK_ANSI_B; break;
-            case Qt::Key_C: keyCode = kVK_ANSI_C; break;
-            case Qt::Key_D: keyCode = kVK_ANSI_D; break;
-            case Qt::Key_E: keyCode = kVK_ANSI_E; break;
-            case Qt::Key_F: keyCode = kVK_ANSI_F; break;
-            case Qt::Key_G: keyCode = kVK_ANSI_G; break;
-            case Qt::Key_H: keyCode = kVK_ANSI_H; break;
-            case Qt::Key_I: keyCode = kVK_ANSI_I; break;
-            case Qt::Key_J: keyCode = kVK_ANSI_J; break;
-            case Qt::Key_K: keyCode = kVK_ANSI_K; break;
-            case Qt::Key_L: keyCode = kVK_ANSI_L; break;
-            case Qt::Key_M: keyCode = kVK_ANSI_M; break;
-            case Qt::Key_N: keyCode = kVK_ANSI_N; break;
-            case Qt::Key_O: keyCode = kVK_ANSI_O; break;
-            case Qt::Key_P: keyCode = kVK_ANSI_P; break;
-            case Qt::Key_Q: keyCode = kVK_ANSI_Q; break;
-            case Qt::Key_R: keyCode = kVK_ANSI_R; break;
-            case Qt::Key_S: keyCode = kVK_ANSI_S; break;
-            case Qt::Key_T: keyCode = kVK_ANSI_T; break;
-            case Qt::Key_U: keyCode = kVK_ANSI_U; break;
-            case Qt::Key_V: keyCode = kVK_ANSI_V; break;
-            case Qt::Key_W: keyCode = kVK_ANSI_W; break;
-            case Qt::Key_X: keyCode = kVK_ANSI_X; break;
-            case Qt::Key_Y: keyCode = kVK_ANSI_Y; break;
-            case Qt::Key_Z: keyCode = kVK_ANSI_Z; break;
-            default:
-                qWarning() << "Unsupported key for toggle shortcut:" << baseKey;
-                keyCode = -1;
+        // Map Qt keys to Carbon virtual key codes
+        keyCode = carbonKeyCode(baseKey);
+        if (keyCode < 0) {
+            qWarning() << "Unsupported key for toggle shortcut:" << baseKey;
         }
         
         if (keyCode >= 0) {
@@ -295,6 +308,91 @@ void GlobalShortcutManager::registerShortcuts()
 #else
     qWarning() << "Global shortcuts are not supported on this platform";
 #endif
+
+    registerRegionShortcuts();
+}
+
+void GlobalShortcutManager::registerRegionShortcuts()
+{
+    for (int i = 0; i < regionShortcuts.size(); ++i) {
+        const QKeySequence sequence(regionShortcuts[i]);
+        if (sequence.isEmpty()) {
+            continue;
+        }
+        const Qt::Key key = sequence[0].key();
+        const Qt::KeyboardModifiers keyModifiers = sequence[0].keyboardModifiers();
+
+#ifdef Q_OS_WIN
+        UINT modifiers = MOD_NOREPEAT;
+        if (keyModifiers & Qt::ControlModifier) modifiers |= MOD_CONTROL;
+        if (keyModifiers & Qt::AltModifier) modifiers |= MOD_ALT;
+        if (keyModifiers & Qt::ShiftModifier) modifiers |= MOD_SHIFT;
+        if (keyModifiers & Qt::MetaModifier) modifiers |= MOD_WIN;
+        const UINT vk = virtualKey(key);
+        if (vk && RegisterHotKey(nullptr, REGION_HOTKEY_BASE + i, modifiers, vk)) {
+            regionHotkeyIds.append(REGION_HOTKEY_BASE + i);
+            qInfo() << "Registered saved region shortcut" << regionShortcuts[i];
+        } else {
+            qWarning() << "Failed to register saved region shortcut" << regionShortcuts[i] << "Error:" << GetLastError();
+        }
+#elif defined(Q_OS_MACOS)
+        int modifiers = 0;
+        if (keyModifiers & Qt::MetaModifier) modifiers |= cmdKey;
+        if (keyModifiers & Qt::ShiftModifier) modifiers |= shiftKey;
+        if (keyModifiers & Qt::ControlModifier) modifiers |= controlKey;
+        if (keyModifiers & Qt::AltModifier) modifiers |= optionKey;
+        const int keyCode = carbonKeyCode(key);
+        if (keyCode < 0) {
+            qWarning() << "Unsupported key for saved region shortcut:" << regionShortcuts[i];
+            continue;
+        }
+        EventHotKeyID regionHotKeyID;
+        regionHotKeyID.signature = 'htkr';
+        regionHotKeyID.id = i;
+        EventHotKeyRef ref = nullptr;
+        const OSStatus status = RegisterEventHotKey(keyCode, modifiers, regionHotKeyID,
+                                                    GetApplicationEventTarget(), 0, &ref);
+        if (status == noErr) {
+            regionHotKeyRefs.append(ref);
+            qInfo() << "Registered saved region shortcut" << regionShortcuts[i];
+        } else {
+            qWarning() << "Failed to register saved region shortcut" << regionShortcuts[i] << "Error:" << status;
+        }
+#elif defined(Q_OS_LINUX)
+        if (!display) {
+            return;
+        }
+        Display *dpy = static_cast<Display*>(display);
+        Window root = DefaultRootWindow(dpy);
+
+        // X keysym names match Qt's key names, in lower case for letters ("a", "5", "F5")
+        QString name = QKeySequence(key).toString();
+        if (name.size() == 1) {
+            name = name.toLower();
+        }
+        RegionKey regionKey;
+        regionKey.index = i;
+        regionKey.keycode = XKeysymToKeycode(dpy, XStringToKeysym(name.toLatin1().constData()));
+        if (keyModifiers & Qt::ControlModifier) regionKey.modifiers |= ControlMask;
+        if (keyModifiers & Qt::AltModifier) regionKey.modifiers |= Mod1Mask;
+        if (keyModifiers & Qt::ShiftModifier) regionKey.modifiers |= ShiftMask;
+        if (keyModifiers & Qt::MetaModifier) regionKey.modifiers |= Mod4Mask;
+        if (regionKey.keycode == 0) {
+            qWarning() << "Failed to get keycode for saved region shortcut" << regionShortcuts[i];
+            continue;
+        }
+        XGrabKey(dpy, regionKey.keycode, regionKey.modifiers, root, True, GrabModeAsync, GrabModeAsync);
+        XGrabKey(dpy, regionKey.keycode, regionKey.modifiers | Mod2Mask, root, True, GrabModeAsync, GrabModeAsync);
+        XGrabKey(dpy, regionKey.keycode, regionKey.modifiers | LockMask, root, True, GrabModeAsync, GrabModeAsync);
+        XGrabKey(dpy, regionKey.keycode, regionKey.modifiers | Mod2Mask | LockMask, root, True, GrabModeAsync, GrabModeAsync);
+        XSync(dpy, False);
+        regionKeys.append(regionKey);
+        qInfo() << "Registered saved region shortcut" << regionShortcuts[i];
+#else
+        Q_UNUSED(key);
+        Q_UNUSED(keyModifiers);
+#endif
+    }
 }
 
 void GlobalShortcutManager::unregisterShortcuts()
@@ -308,6 +406,10 @@ void GlobalShortcutManager::unregisterShortcuts()
         UnregisterHotKey(nullptr, toggleHotkeyId);
         toggleRegistered = false;
     }
+    for (int id : std::as_const(regionHotkeyIds)) {
+        UnregisterHotKey(nullptr, id);
+    }
+    regionHotkeyIds.clear();
 #elif defined(Q_OS_MACOS)
     if (screenshotRegistered) {
         UnregisterEventHotKey(screenshotHotKeyRef);
@@ -317,6 +419,10 @@ void GlobalShortcutManager::unregisterShortcuts()
         UnregisterEventHotKey(toggleHotKeyRef);
         toggleRegistered = false;
     }
+    for (EventHotKeyRef ref : std::as_const(regionHotKeyRefs)) {
+        UnregisterEventHotKey(ref);
+    }
+    regionHotKeyRefs.clear();
     if (eventHandlerRef) {
         RemoveEventHandler(eventHandlerRef);
         eventHandlerRef = nullptr;
@@ -346,6 +452,14 @@ void GlobalShortcutManager::unregisterShortcuts()
             toggleRegistered = false;
         }
 
+        for (const RegionKey &regionKey : std::as_const(regionKeys)) {
+            XUngrabKey(dpy, regionKey.keycode, regionKey.modifiers, root);
+            XUngrabKey(dpy, regionKey.keycode, regionKey.modifiers | Mod2Mask, root);
+            XUngrabKey(dpy, regionKey.keycode, regionKey.modifiers | LockMask, root);
+            XUngrabKey(dpy, regionKey.keycode, regionKey.modifiers | Mod2Mask | LockMask, root);
+        }
+        regionKeys.clear();
+
         XCloseDisplay(dpy);
         display = nullptr;
     }
@@ -374,6 +488,12 @@ bool GlobalShortcutManager::nativeEventFilter(const QByteArray &eventType, void
                     *result = 0;
                 }
                 return true;
+            } else if (regionHotkeyIds.contains(static_cast<int>(msg->wParam))) {
+                emit regionRequested(static_cast<int>(msg->wParam) - REGION_HOTKEY_BASE);
+                if (result) {
+                    *result = 0;
+                }
+                return true;
             }
         }
     }
@@ -403,6 +523,16 @@ bool GlobalShortcutManager::nativeEventFilter(const QByteArray &eventType, void
                 }
                 return true;
             }
+
+            for (const RegionKey &regionKey : std::as_const(regionKeys)) {
+                if (keyEvent->detail == regionKey.keycode && cleanState == regionKey.modifiers) {
+                    emit regionRequested(regionKey.index);
+                    if (result) {
+                        *result = 0;
+                    }
+                    return true;
+                }
+            }
         }
     }
 #else
@@ -436,6 +566,10 @@ OSStatus GlobalShortcutManager::hotKeyHandler(EventHandlerCallRef nextHandler, E
         // Toggle visibility hotkey (Cmd+Shift+H)
         emit manager->toggleVisibilityRequested();
         return noErr;
+    } else if (hotKeyID.signature == 'htkr') {
+        // Saved region hotkey
+        emit manager->regionRequested(static_cast<int>(hotKeyID.id));
+        return noErr;
     }
     
     return eventNotHandledErr;
@@ -448,6 +582,15 @@ void GlobalShortcutManager::setEnabled(bool enabled)
     qDebug() << "Global shortcuts" << (enabled ? "enabled" : "disabled");
 }
 
+void GlobalShortcutManager::setRegionShortcuts(const QStringList &shortcuts)
+{
+    if (shortcuts == regionShortcuts) {
+        return;
+    }
+    regionShortcuts = shortcuts;
+    registerShortcuts();
+}
+
 void GlobalShortcutManager::reloadShortcuts()
 {
     qDebug() << "Reloading global shortcuts...";
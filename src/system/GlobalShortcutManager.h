@@ -3,6 +3,8 @@
 #include <QObject>
 #include <QAbstractNativeEventFilter>
 #include <QByteArray>
+#include <QStringList>
+#include <QVector>
 
 #ifdef Q_OS_MACOS
 #include <Carbon/Carbon.h>
@@ -18,23 +20,29 @@ public:
     
     void setEnabled(bool enabled);
     void reloadShortcuts();
+    // One hotkey per saved region (QKeySequence text, empty for none); replaces the previous set
+    void setRegionShortcuts(const QStringList &shortcuts);
 
 signals:
     void screenshotRequested();
     void toggleVisibilityRequested();
+    void regionRequested(int index);
 
 private:
     bool nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result) override;
     void registerShortcuts();
     void unregisterShortcuts();
+    void registerRegionShortcuts();
     
     bool isEnabled = true;
+    QStringList regionShortcuts;
 
 #ifdef Q_OS_WIN
     int screenshotHotkeyId = 1;
     int toggleHotkeyId = 2;
     bool screenshotRegistered = false;
     bool toggleRegistered = false;
+    QVector<int> regionHotkeyIds;
 #endif
 
 #ifdef Q_OS_MACOS
@@ -44,6 +52,7 @@ private:
     EventHandlerRef eventHandlerRef = nullptr;
     bool screenshotRegistered = false;
     bool toggleRegistered = false;
+    QVector<EventHotKeyRef> regionHotKeyRefs;
 
     static OSStatus hotKeyHandler(EventHandlerCallRef nextHandler, EventRef event, void *userData);
 #endif
@@ -57,6 +66,12 @@ private:
     unsigned int toggleModifiers = 0;
     bool screenshotRegistered = false;
     bool toggleRegistered = false;
+    struct RegionKey {
+        int index = 0;
+        unsigned int keycode = 0;
+        unsigned int modifiers = 0;
+    };
+    QVector<RegionKey> regionKeys;
 
     void startX11Monitoring();
     void stopX11Monitoring();
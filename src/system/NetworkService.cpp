@@ -0,0 +1,34 @@
+#include "NetworkService.h"
+#include <QCoreApplication>
+#include <QPointer>
+#include <QSslConfiguration>
+#include <QDebug>
+
+namespace {
+constexpr quint16 HTTPS_PORT = 443;
+}
+
+QNetworkAccessManager* NetworkService::manager()
+{
+    // Owned by the application object so it goes away with it, not after it
+    static QPointer<QNetworkAccessManager> manager;
+    if (!manager) {
+        manager = new QNetworkAccessManager(QCoreApplication::instance());
+    }
+    return manager;
+}
+
+void NetworkService::prewarm(const QString& host)
+{
+    if (host.isEmpty()) {
+        return;
+    }
+#if QT_CONFIG(ssl)
+    // Offering h2 like the requests do makes this the connection they multiplex over
+    QSslConfiguration configuration = QSslConfiguration::defaultConfiguration();
+    configuration.setAllowedNextProtocols({ QSslConfiguration::ALPNProtocolHTTP2, QSslConfiguration::ALPNProtocolHTTP1_1 });
+    // A connection still in the manager's cache is reused; only a missing one is opened
+    qDebug() << "NetworkService: Pre-connecting to" << host;
+    manager()->connectToHostEncrypted(host, HTTPS_PORT, configuration);
+#endif
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QNetworkAccessManager>
+#include <QString>
+
+/**
+ * The one QNetworkAccessManager every online feature sends its requests through
+ * Translation and speech go to the same hosts; with one manager they share its
+ * connection cache and TLS sessions, and a connection one of them opened stays
+ * open for the next request of either.
+ *
+ * prewarm() opens the TLS connection to a host ahead of the first request: the
+ * screenshot hotkey calls it, so DNS, TCP and the handshake happen while the
+ * user selects and OCR runs instead of when the translation is sent.
+ *
+ * GUI thread only. The manager belongs to the application object.
+ */
+class NetworkService
+{
+public:
+    static QNetworkAccessManager* manager();
+
+    // Opens (or keeps) an encrypted connection to host on port 443; requests to it reuse that connection
+    static void prewarm(const QString& host);
+};
@@ -1,6 +1,9 @@
 #include "SystemTray.h"
 #include "../ui/core/FloatingWidget.h"
+#include "../ui/overlays/LiveRegionTranslator.h"
+#include "ScreenCapture.h"
 #include <QApplication>
+#include <QFontMetrics>
 #include <QStyle>
 #include <QSettings>
 
@@ -15,6 +18,10 @@ SystemTray::SystemTray(FloatingWidget *widget, QObject *parent)
     connect(screenshotAction, &QAction::triggered, this, &SystemTray::takeScreenshot);
     trayMenu->addAction(screenshotAction);
 
+    // Live translation of one window; the list is read each time the menu opens
+    windowMenu = trayMenu->addMenu("🪟 Translate Window");
+    connect(windowMenu, &QMenu::aboutToShow, this, &SystemTray::populateWindowMenu);
+
     trayMenu->addSeparator();
 
     // Toggle visibility action
@@ -72,6 +79,26 @@ void SystemTray::takeScreenshot()
     }
 }
 
+void SystemTray::populateWindowMenu()
+{
+    windowMenu->clear();
+
+    const QList<WindowCapture::Info> windows = ScreenCapture::windows();
+    if (windows.isEmpty()) {
+        windowMenu->addAction("No capturable windows")->setEnabled(false);
+        return;
+    }
+
+    const QFontMetrics metrics(windowMenu->font());
+    for (const WindowCapture::Info &window : windows) {
+        const quintptr id = window.id;
+        QAction *action = windowMenu->addAction(metrics.elidedText(window.title, Qt::ElideRight, 400));
+        connect(action, &QAction::triggered, this, [id]() {
+            LiveRegionTranslator::startWindow(id);
+        });
+    }
+}
+
 void SystemTray::toggleVisibility()
 {
     if (floatingWidget) {
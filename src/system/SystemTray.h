@@ -18,6 +18,7 @@ public:
 private slots:
     void onTrayActivated(QSystemTrayIcon::ActivationReason reason);
     void takeScreenshot();
+    void populateWindowMenu();
     void toggleVisibility();
     void openSettings();
     void quitApplication();
@@ -26,6 +27,7 @@ private:
     FloatingWidget *floatingWidget;
     QMenu *trayMenu;
     QAction *screenshotAction;
+    QMenu *windowMenu;
     QAction *toggleAction;
     QAction *settingsAction;
     QAction *quitAction;
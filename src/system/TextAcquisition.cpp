@@ -0,0 +1,382 @@
+#include "TextAcquisition.h"
+#include "WindowCapture.h"
+#include <QClipboard>
+#include <QGuiApplication>
+#include <QDebug>
+
+#ifdef Q_OS_LINUX
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusConnectionInterface>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusObjectPath>
+#include <QDBusReply>
+#include <utility>
+#endif
+
+namespace {
+
+constexpr int PRIMARY_FRESH_MS = 30000;    // PRIMARY set longer before the overlay opened is not this selection
+constexpr double CHAR_WIDTH = 0.5;         // Average glyph advance, in line heights
+constexpr double LENGTH_TOLERANCE = 2.5;   // How far the text's length may stray from what the lines hold
+constexpr double MAX_EDIT_DISTANCE = 0.2;  // Edits per character between PRIMARY and the OCR text, at most
+constexpr int MAX_COMPARED = 4000;         // Longer texts aren't compared (quadratic); OCR stands
+
+// text could be what lines show: no more paragraphs than lines, and about as many characters as they fit
+bool fitsLayout(const QString &text, const QVector<QRect> &lines)
+{
+    if (text.trimmed().isEmpty() || lines.isEmpty()) {
+        return false;
+    }
+    if (text.split('\n', Qt::SkipEmptyParts).size() > lines.size()) {
+        return false;
+    }
+    double expected = 0.0;
+    for (const QRect &line : lines) {
+        expected += line.width() / (CHAR_WIDTH * qMax(1, line.height()));
+    }
+    const int length = text.simplified().size();
+    return length >= expected / LENGTH_TOLERANCE && length <= expected * LENGTH_TOLERANCE;
+}
+
+#ifdef Q_OS_LINUX
+
+constexpr int CALL_TIMEOUT_MS = 150;       // Per AT-SPI call: an application that is busy is skipped, not waited for
+constexpr int BUDGET_MS = 400;             // Whole AT-SPI lookup; OCR is started after this at the latest
+constexpr int MAX_DEPTH = 32;              // Accessible tree levels descended under the point
+constexpr uint SCREEN_COORDS = 0;          // ATSPI_COORD_TYPE_SCREEN
+constexpr uint STATE_SHOWING = 25;         // ATSPI_STATE_SHOWING
+constexpr int EDGE_SLACK = 4;              // A text object this close inside the selection counts as inside
+
+const QString REGISTRY = "org.a11y.atspi.Registry";
+const QString ROOT_PATH = "/org/a11y/atspi/accessible/root";
+const QString NULL_PATH = "/org/a11y/atspi/null";
+const QString ACCESSIBLE = "org.a11y.atspi.Accessible";
+const QString COMPONENT = "org.a11y.atspi.Component";
+const QString TEXT = "org.a11y.atspi.Text";
+const QString BUS_NAME = "ohao-a11y";
+
+// An accessible object: bus name and object path, marshalled as (so)
+struct Ref {
+    QString service;
+    QString path;
+
+    bool isNull() const { return service.isEmpty() || path.isEmpty() || path == NULL_PATH; }
+    bool operator==(const Ref &other) const { return service == other.service && path == other.path; }
+};
+
+QDBusArgument &operator<<(QDBusArgument &argument, const Ref &ref)
+{
+    argument.beginStructure();
+    argument << ref.service << QDBusObjectPath(ref.path);
+    argument.endStructure();
+    return argument;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &argument, Ref &ref)
+{
+    QDBusObjectPath path;
+    argument.beginStructure();
+    argument >> ref.service >> path;
+    argument.endStructure();
+    ref.path = path.path();
+    return argument;
+}
+
+#endif
+
+} // namespace
+
+#ifdef Q_OS_LINUX
+Q_DECLARE_METATYPE(Ref)
+
+namespace {
+
+// The accessibility bus is separate from the session bus; its address comes from org.a11y.Bus
+QDBusConnection accessibilityBus()
+{
+    QDBusConnection bus(BUS_NAME);
+    if (bus.isConnected()) {
+        return bus;
+    }
+    QDBusMessage message = QDBusMessage::createMethodCall("org.a11y.Bus", "/org/a11y/bus", "org.a11y.Bus", "GetAddress");
+    const QDBusReply<QString> address = QDBusConnection::sessionBus().call(message, QDBus::Block, CALL_TIMEOUT_MS);
+    if (!address.isValid() || address.value().isEmpty()) {
+        return bus;
+    }
+    return QDBusConnection::connectToBus(address.value(), BUS_NAME);
+}
+
+QVariant call(const QDBusConnection &bus, const Ref &ref, const QString &interface, const QString &method,
+              const QList<QVariant> &arguments = QList<QVariant>())
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(ref.service, ref.path, interface, method);
+    message.setArguments(arguments);
+    const QDBusMessage reply = bus.call(message, QDBus::Block, CALL_TIMEOUT_MS);
+    if (reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty()) {
+        return QVariant();
+    }
+    return reply.arguments().first();
+}
+
+QVector<Ref> children(const QDBusConnection &bus, const Ref &ref)
+{
+    const QVariant value = call(bus, ref, ACCESSIBLE, "GetChildren");
+    return value.isValid() ? qdbus_cast<QVector<Ref>>(value) : QVector<Ref>();
+}
+
+QRect extents(const QDBusConnection &bus, const Ref &ref)
+{
+    const QVariant value = call(bus, ref, COMPONENT, "GetExtents", { QVariant::fromValue(SCREEN_COORDS) });
+    if (!value.canConvert<QDBusArgument>()) {
+        return QRect();
+    }
+    int x = 0, y = 0, width = 0, height = 0;
+    const QDBusArgument argument = value.value<QDBusArgument>();
+    argument.beginStructure();
+    argument >> x >> y >> width >> height;
+    argument.endStructure();
+    return QRect(x, y, width, height);
+}
+
+bool isShowing(const QDBusConnection &bus, const Ref &ref)
+{
+    const QVariant value = call(bus, ref, ACCESSIBLE, "GetState");
+    const QList<uint> states = value.isValid() ? qdbus_cast<QList<uint>>(value) : QList<uint>();
+    return states.size() == 2 && (states[STATE_SHOWING / 32] & (1u << (STATE_SHOWING % 32)));
+}
+
+bool hasInterface(const QDBusConnection &bus, const Ref &ref, const QString &interface)
+{
+    return call(bus, ref, ACCESSIBLE, "GetInterfaces").toStringList().contains(interface);
+}
+
+int offsetAt(const QDBusConnection &bus, const Ref &text, const QPoint &point)
+{
+    const QVariant value = call(bus, text, TEXT, "GetOffsetAtPoint",
+                                { point.x(), point.y(), QVariant::fromValue(SCREEN_COORDS) });
+    return value.isValid() ? value.toInt() : -1;
+}
+
+// Text of the deepest accessible under the centre of rect (native pixels) in the application with pid
+QString accessibleText(const QRect &rect, qint64 pid)
+{
+    QElapsedTimer timer;
+    timer.start();
+    const QDBusConnection bus = accessibilityBus();
+    if (!bus.isConnected()) {
+        return QString();
+    }
+    qDBusRegisterMetaType<Ref>();
+    qDBusRegisterMetaType<QVector<Ref>>();
+
+    // The application that owns the window on top: accessible roots don't know about stacking
+    Ref application;
+    for (const Ref &candidate : children(bus, { REGISTRY, ROOT_PATH })) {
+        const QDBusReply<uint> candidatePid = bus.interface()->servicePid(candidate.service);
+        if (candidatePid.isValid() && candidatePid.value() == pid) {
+            application = candidate;
+            break;
+        }
+        if (timer.elapsed() > BUDGET_MS) {
+            return QString();
+        }
+    }
+    if (application.isNull()) {
+        return QString();
+    }
+
+    const QPoint centre = rect.center();
+    Ref object;
+    for (const Ref &frame : children(bus, application)) {
+        if (extents(bus, frame).contains(centre) && isShowing(bus, frame)) {
+            object = frame;
+            break;
+        }
+    }
+
+    // Down to the deepest object under the point, then back up to the nearest one with text
+    QVector<Ref> chain;
+    while (!object.isNull() && chain.size() < MAX_DEPTH && timer.elapsed() < BUDGET_MS) {
+        chain.append(object);
+        Ref child;
+        const QVariant value = call(bus, object, COMPONENT, "GetAccessibleAtPoint",
+                                    { centre.x(), centre.y(), QVariant::fromValue(SCREEN_COORDS) });
+        if (value.isValid()) {
+            child = qdbus_cast<Ref>(value);
+        }
+        if (child == object) {
+            break;
+        }
+        object = child;
+    }
+    Ref text;
+    for (int i = chain.size() - 1; i >= 0 && text.isNull() && timer.elapsed() < BUDGET_MS; --i) {
+        if (hasInterface(bus, chain[i], TEXT)) {
+            text = chain[i];
+        }
+    }
+    if (text.isNull()) {
+        return QString();
+    }
+
+    // Whole object inside the selection, or only the characters between its corners
+    const QRect bounds = extents(bus, text);
+    int start = 0;
+    int end = -1;
+    if (!rect.adjusted(-EDGE_SLACK, -EDGE_SLACK, EDGE_SLACK, EDGE_SLACK).contains(bounds)) {
+        const QRect visible = rect.intersected(bounds);
+        start = offsetAt(bus, text, visible.topLeft());
+        end = offsetAt(bus, text, visible.bottomRight());
+        if (start < 0 || end < 0) {
+            return QString();
+        }
+        if (start > end) {
+            std::swap(start, end);
+        }
+        ++end;
+    }
+    QString result = call(bus, text, TEXT, "GetText", { start, end }).toString();
+    result.remove(QChar(0xFFFC)); // Embedded objects (links, images) stand in as this character
+
+    qDebug() << "TextAcquisition: AT-SPI gave" << result.size() << "characters";
+    return result.trimmed();
+}
+
+} // namespace
+#endif
+
+TextAcquisition::TextAcquisition(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);
+
+    // Selections made in other applications; ours (result text) never stand for a screen region
+    if (QClipboard *clipboard = QGuiApplication::clipboard()) {
+        connect(clipboard, &QClipboard::selectionChanged, this, [this, clipboard]() {
+            if (!clipboard->ownsSelection()) {
+                m_primaryChanged.start();
+            }
+        });
+    }
+}
+
+TextAcquisition::~TextAcquisition()
+{
+    // The lookup posts back to this object; let it drain before it goes away
+    cancel();
+    m_pool.waitForDone();
+}
+
+bool TextAcquisition::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return QGuiApplication::platformName() == "xcb";
+#else
+    return false;
+#endif
+}
+
+void TextAcquisition::begin()
+{
+    m_primaryFresh = m_primaryChanged.isValid() && m_primaryChanged.elapsed() < PRIMARY_FRESH_MS;
+}
+
+void TextAcquisition::request(const QRect &nativeRect, const QVector<QRect> &lines)
+{
+    const int request = ++m_request;
+
+    // PRIMARY is read here (QClipboard is GUI-only) and weighed once AT-SPI has had its say
+    QString primary;
+    if (m_primaryFresh && QGuiApplication::clipboard()) {
+        primary = QGuiApplication::clipboard()->text(QClipboard::Selection).trimmed();
+        if (!fitsLayout(primary, lines)) {
+            primary.clear();
+        }
+    }
+
+#ifdef Q_OS_LINUX
+    // Without layout lines nothing could pass the fit check, so AT-SPI isn't asked
+    const bool ask = isSupported() && !nativeRect.isEmpty() && !lines.isEmpty();
+    const qint64 pid = ask ? WindowCapture::windowAt(nativeRect.center()).pid : 0;
+    if (pid > 0) {
+        m_pool.start([this, request, nativeRect, pid, lines, primary]() {
+            QString text = accessibleText(nativeRect, pid);
+            if (!fitsLayout(text, lines)) {
+                text.clear();
+            }
+            QMetaObject::invokeMethod(this, [this, request, text, primary]() {
+                onAccessibleText(request, text, primary);
+            }, Qt::QueuedConnection);
+        });
+        return;
+    }
+#else
+    Q_UNUSED(nativeRect);
+#endif
+
+    QMetaObject::invokeMethod(this, [this, request, primary]() {
+        onAccessibleText(request, QString(), primary);
+    }, Qt::QueuedConnection);
+}
+
+void TextAcquisition::cancel()
+{
+    ++m_request;
+    m_pool.clear();
+}
+
+void TextAcquisition::onAccessibleText(int request, const QString &text, const QString &primary)
+{
+    if (request != m_request) {
+        return;
+    }
+    if (!text.isEmpty()) {
+        emit acquired(text, QString());
+        return;
+    }
+    if (!primary.isEmpty()) {
+        // One selection, one use: the next region in this overlay is something else
+        m_primaryFresh = false;
+        qDebug() << "TextAcquisition: PRIMARY selection is a candidate for the OCR to confirm";
+    }
+    emit acquired(QString(), primary);
+}
+
+bool TextAcquisition::agrees(const QString &primary, const QString &recognised)
+{
+    // Line breaks, spacing and case are where OCR and applications differ most harmlessly
+    const QString a = primary.simplified().toCaseFolded();
+    const QString b = recognised.simplified().toCaseFolded();
+    if (a.isEmpty() || b.isEmpty() || a.size() > MAX_COMPARED || b.size() > MAX_COMPARED) {
+        return false;
+    }
+    const int longest = qMax(a.size(), b.size());
+    const int allowed = int(longest * MAX_EDIT_DISTANCE);
+    if (qAbs(a.size() - b.size()) > allowed) {
+        return false;
+    }
+
+    // Levenshtein distance, two rows
+    QVector<int> previous(b.size() + 1);
+    QVector<int> current(b.size() + 1);
+    for (int j = 0; j <= b.size(); ++j) {
+        previous[j] = j;
+    }
+    for (int i = 1; i <= a.size(); ++i) {
+        current[0] = i;
+        int rowBest = current[0];
+        for (int j = 1; j <= b.size(); ++j) {
+            const int substitution = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+            current[j] = qMin(substitution, qMin(previous[j], current[j - 1]) + 1);
+            rowBest = qMin(rowBest, current[j]);
+        }
+        // Every later row is at least this row's best
+        if (rowBest > allowed) {
+            return false;
+        }
+        previous.swap(current);
+    }
+    return previous[b.size()] <= allowed;
+}
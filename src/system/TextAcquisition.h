@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QRect>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+/**
+ * Real text for a selection, asked for before it is OCR'd
+ * Much of what gets selected (browsers, editors, terminals) is text an
+ * application already has. Two sources are tried:
+ *  - AT-SPI over the accessibility bus: the topmost window under the selection
+ *    (X11 stacking order) is matched to its accessible application by PID, and
+ *    the deepest Text object under the selection's centre gives the characters
+ *    between the selection's corners.
+ *  - The PRIMARY selection, if another application changed it shortly before
+ *    the overlay opened.
+ * Either has to fit the text lines TextLayout found in the rect (length and
+ * line count), so a neighbouring paragraph is never passed off as what was
+ * selected. AT-SPI text is then used as it is. PRIMARY can't be tied to the
+ * rect at all, so it is only a candidate: the selection is still OCR'd, and
+ * PRIMARY replaces the OCR text only when agrees() holds. Otherwise the
+ * selection is OCR'd as before.
+ *
+ * Linux/X11 only: AT-SPI screen coordinates mean nothing on Wayland. AT-SPI
+ * runs off the GUI thread with short per-call timeouts, so an application
+ * that doesn't answer costs a bounded delay, never a hang.
+ */
+class TextAcquisition : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TextAcquisition(QObject *parent = nullptr);
+    ~TextAcquisition();
+
+    static bool isSupported();
+
+    // The overlay opened: a PRIMARY selection changed shortly before now is a candidate
+    void begin();
+
+    // Text in nativeRect (native desktop pixels; empty to skip AT-SPI) whose TextLayout lines
+    // are lines (any coordinates, only their sizes count). acquired() follows, queued
+    void request(const QRect &nativeRect, const QVector<QRect> &lines);
+    // A request in flight is ignored when it returns
+    void cancel();
+
+    // PRIMARY text is what was OCR'd as recognised, give or take OCR errors (normalised edit distance)
+    static bool agrees(const QString &primary, const QString &recognised);
+
+signals:
+    // text is AT-SPI's, empty when it didn't have the selection's text; primary is the unconfirmed
+    // PRIMARY candidate for the OCR to check, or empty
+    void acquired(const QString &text, const QString &primary);
+
+private:
+    void onAccessibleText(int request, const QString &text, const QString &primary);
+
+    QThreadPool m_pool;
+    int m_request = 0;
+    QElapsedTimer m_primaryChanged;   // Since another application last set PRIMARY
+    bool m_primaryFresh = false;      // ... shortly before the overlay opened, and not used yet
+};
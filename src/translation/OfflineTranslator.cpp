@@ -0,0 +1,292 @@
+#include "OfflineTranslator.h"
+#include "../ui/core/AppSettings.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QLocale>
+#include <QStandardPaths>
+#include <QDebug>
+
+#ifdef HAVE_CTRANSLATE2
+#include <ctranslate2/translator.h>
+#include <sentencepiece_processor.h>
+#include <exception>
+#include <string>
+#include <vector>
+#endif
+
+namespace {
+
+constexpr qint64 MB = 1024 * 1024;
+constexpr int BEAM_SIZE = 2;                // Small beam: UI strings gain little from a wide one, latency does
+constexpr int MAX_DECODING_LENGTH = 256;    // Tokens per translated segment
+
+// "zh-CN" -> "zh": model directories are named after OPUS-MT's plain language codes
+QString primaryCode(const QString &code)
+{
+    return code.section('-', 0, 0).toLower();
+}
+
+// Script most letters of texts are in; any kana makes it Japanese rather than Chinese
+QLocale::Script dominantScript(const QStringList &texts)
+{
+    QHash<int, int> counts;
+    for (const QString &text : texts) {
+        for (const QChar c : text) {
+            if (!c.isLetter()) {
+                continue;
+            }
+            QLocale::Script script = QLocale::AnyScript;
+            switch (c.script()) {
+            case QChar::Script_Latin: script = QLocale::LatinScript; break;
+            case QChar::Script_Cyrillic: script = QLocale::CyrillicScript; break;
+            case QChar::Script_Greek: script = QLocale::GreekScript; break;
+            case QChar::Script_Arabic: script = QLocale::ArabicScript; break;
+            case QChar::Script_Hebrew: script = QLocale::HebrewScript; break;
+            case QChar::Script_Thai: script = QLocale::ThaiScript; break;
+            case QChar::Script_Devanagari: script = QLocale::DevanagariScript; break;
+            case QChar::Script_Hangul: script = QLocale::KoreanScript; break;
+            case QChar::Script_Hiragana:
+            case QChar::Script_Katakana: script = QLocale::JapaneseScript; break;
+            case QChar::Script_Han: script = QLocale::SimplifiedHanScript; break;
+            default: break;
+            }
+            ++counts[script];
+        }
+    }
+    if (counts.contains(QLocale::JapaneseScript)) {
+        return QLocale::JapaneseScript;
+    }
+    QLocale::Script dominant = QLocale::AnyScript;
+    int most = 0;
+    for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) {
+        if (it.key() != QLocale::AnyScript && it.value() > most) {
+            dominant = QLocale::Script(it.key());
+            most = it.value();
+        }
+    }
+    return dominant;
+}
+
+} // namespace
+
+struct OfflineTranslator::Model {
+#ifdef HAVE_CTRANSLATE2
+    std::unique_ptr<ctranslate2::Translator> translator;
+    sentencepiece::SentencePieceProcessor source;
+    sentencepiece::SentencePieceProcessor target;
+#endif
+    qint64 bytes = 0;
+};
+
+OfflineTranslator& OfflineTranslator::instance()
+{
+    static OfflineTranslator translator;
+    return translator;
+}
+
+OfflineTranslator::OfflineTranslator()
+{
+    // One batch at a time; CTranslate2 spreads each one over its own threads
+    m_pool.setMaxThreadCount(1);
+}
+
+OfflineTranslator::~OfflineTranslator()
+{
+    m_pool.waitForDone();
+}
+
+bool OfflineTranslator::isAvailable()
+{
+#ifdef HAVE_CTRANSLATE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+QString OfflineTranslator::modelsDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/translation-models";
+}
+
+int OfflineTranslator::translate(const QStringList &texts, const QString &source, const QString &target)
+{
+    const int request = ++m_request;
+
+    // Read here: AppSettings belongs to the GUI thread
+    const AppSettings::TranslationConfig config = AppSettings::instance().getTranslationConfig();
+    const int threads = qMax(1, config.offlineThreads);
+    const qint64 memoryCap = qint64(config.offlineMemoryMB) * MB;
+
+    m_pool.start([this, request, texts, source, target, threads, memoryCap]() {
+        QString error;
+        QStringList translations = run(texts, source, target, threads, memoryCap, &error);
+        if (error.isEmpty() && translations.size() != texts.size()) {
+            error = "Offline translation returned the wrong number of segments";
+        }
+        if (!error.isEmpty()) {
+            translations.clear();
+        }
+        QMetaObject::invokeMethod(this, [this, request, translations, error]() {
+            emit finished(request, translations, error);
+        }, Qt::QueuedConnection);
+    });
+    return request;
+}
+
+QStringList OfflineTranslator::run(const QStringList &texts, const QString &source, const QString &target,
+                                   int threads, qint64 memoryCap, QString *error)
+{
+#ifdef HAVE_CTRANSLATE2
+    const QString pair = pairFor(texts, source, target, error);
+    if (pair.isEmpty()) {
+        return QStringList();
+    }
+    Model *loaded = model(pair, threads, memoryCap, error);
+    if (!loaded) {
+        return QStringList();
+    }
+
+    std::vector<std::vector<std::string>> batch;
+    batch.reserve(texts.size());
+    for (const QString &text : texts) {
+        std::vector<std::string> pieces;
+        loaded->source.Encode(text.toStdString(), &pieces);
+        batch.push_back(std::move(pieces));
+    }
+
+    ctranslate2::TranslationOptions options;
+    options.beam_size = BEAM_SIZE;
+    options.max_decoding_length = MAX_DECODING_LENGTH;
+    std::vector<ctranslate2::TranslationResult> results;
+    try {
+        results = loaded->translator->translate_batch(batch, options);
+    } catch (const std::exception &e) {
+        *error = QString("Offline translation failed: %1").arg(QString::fromUtf8(e.what()));
+        return QStringList();
+    }
+
+    QStringList translations;
+    for (const ctranslate2::TranslationResult &result : results) {
+        std::string text;
+        loaded->target.Decode(result.output(), &text);
+        translations << QString::fromStdString(text);
+    }
+    return translations;
+#else
+    Q_UNUSED(texts);
+    Q_UNUSED(source);
+    Q_UNUSED(target);
+    Q_UNUSED(threads);
+    Q_UNUSED(memoryCap);
+    *error = "Offline translation isn't available in this build (needs CTranslate2)";
+    return QStringList();
+#endif
+}
+
+QString OfflineTranslator::pairFor(const QStringList &texts, const QString &source, const QString &target,
+                                   QString *error) const
+{
+    const QDir directory(modelsDirectory());
+    const QString to = primaryCode(target);
+    auto installed = [&directory](const QString &pair) {
+        return QFileInfo::exists(directory.filePath(pair + "/model.bin"));
+    };
+
+    if (source != "auto") {
+        for (const QString &pair : QStringList{ primaryCode(source) + '-' + to, "mul-" + to }) {
+            if (installed(pair)) {
+                return pair;
+            }
+        }
+        *error = QString("No offline model for %1 to %2 in %3").arg(source, target, directory.path());
+        return QString();
+    }
+
+    // Auto-Detect: the only pair into target, or the one whose source language is written in the texts' script
+    QStringList candidates;
+    for (const QString &pair : directory.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (pair.endsWith('-' + to) && installed(pair)) {
+            candidates << pair;
+        }
+    }
+    if (candidates.size() == 1) {
+        return candidates.first();
+    }
+    const QLocale::Script script = dominantScript(texts);
+    QStringList matching;
+    for (const QString &pair : std::as_const(candidates)) {
+        const QString from = pair.section('-', 0, 0);
+        if (from != "mul" && QLocale(from).script() == script) {
+            matching << pair;
+        }
+    }
+    if (matching.size() == 1) {
+        return matching.first();
+    }
+    if (candidates.contains("mul-" + to)) {
+        return "mul-" + to;
+    }
+    *error = candidates.isEmpty()
+        ? QString("No offline model to %1 in %2").arg(target, directory.path())
+        : QString("Several offline models to %1 could fit; choose a source language").arg(target);
+    return QString();
+}
+
+OfflineTranslator::Model *OfflineTranslator::model(const QString &pair, int threads, qint64 memoryCap, QString *error)
+{
+    if (threads != m_threads) {
+        // A model's thread count is fixed when it is loaded
+        m_models.clear();
+        m_recent.clear();
+        m_loadedBytes = 0;
+        m_threads = threads;
+    }
+    const auto it = m_models.constFind(pair);
+    if (it != m_models.constEnd()) {
+        m_recent.removeOne(pair);
+        m_recent.append(pair);
+        return it.value().get();
+    }
+
+#ifdef HAVE_CTRANSLATE2
+    const QString path = QDir(modelsDirectory()).filePath(pair);
+    auto loaded = std::make_shared<Model>();
+    loaded->bytes = QFileInfo(path + "/model.bin").size();
+
+    try {
+        ctranslate2::models::ModelLoader loader(path.toStdString());
+        loader.device = ctranslate2::Device::CPU;
+        loader.compute_type = ctranslate2::ComputeType::INT8;
+        ctranslate2::ReplicaPoolConfig config;
+        config.num_threads_per_replica = threads;
+        loaded->translator = std::make_unique<ctranslate2::Translator>(loader, config);
+    } catch (const std::exception &e) {
+        *error = QString("Can't load offline model %1: %2").arg(pair, QString::fromUtf8(e.what()));
+        return nullptr;
+    }
+    if (!loaded->source.Load((path + "/source.spm").toStdString()).ok()
+        || !loaded->target.Load((path + "/target.spm").toStdString()).ok()) {
+        *error = QString("Offline model %1 is missing source.spm or target.spm").arg(pair);
+        return nullptr;
+    }
+    qDebug() << "OfflineTranslator: Loaded" << pair << "(" << loaded->bytes / MB << "MB," << threads << "threads)";
+
+    // Room is made only once the new model is in: a failed load leaves the others loaded,
+    // at the price of the cap being exceeded while one loads
+    while (!m_recent.isEmpty() && memoryCap > 0 && m_loadedBytes + loaded->bytes > memoryCap) {
+        const QString oldest = m_recent.takeFirst();
+        m_loadedBytes -= m_models.take(oldest)->bytes;
+        qDebug() << "OfflineTranslator: Unloaded" << oldest;
+    }
+
+    m_models.insert(pair, loaded);
+    m_recent.append(pair);
+    m_loadedBytes += loaded->bytes;
+    return loaded.get();
+#else
+    Q_UNUSED(memoryCap);
+    *error = "Offline translation isn't available in this build (needs CTranslate2)";
+    return nullptr;
+#endif
+}
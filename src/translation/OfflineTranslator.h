@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <memory>
+
+/**
+ * On-device neural translation, for machines without network access
+ * Runs quantised Marian/OPUS-MT models converted for CTranslate2 on the CPU.
+ * Each language pair is a directory under modelsDirectory() named
+ * "<source>-<target>" (e.g. "de-en"; "mul-en" for a multilingual source)
+ * holding the converted model.bin plus the pair's source.spm and target.spm
+ * SentencePiece models.
+ *
+ * A model is loaded on first use and stays loaded; once the loaded models
+ * outgrow translation/offlineMemoryMB the least recently used are unloaded.
+ * Texts are translated as one batch with translation/offlineThreads CPU
+ * threads, on a background thread: short UI strings take tens of milliseconds
+ * once their model is warm.
+ *
+ * Only does anything when built with CTranslate2 and SentencePiece
+ * (HAVE_CTRANSLATE2); otherwise every request fails with an error.
+ */
+class OfflineTranslator : public QObject
+{
+    Q_OBJECT
+
+public:
+    static OfflineTranslator& instance();
+
+    static bool isAvailable();
+    static QString modelsDirectory();
+
+    // Translates texts from source to target (language codes; source may be "auto").
+    // finished() follows with the returned request id
+    int translate(const QStringList &texts, const QString &source, const QString &target);
+
+signals:
+    // translations has one entry per text of the request; empty, with error set, on failure
+    void finished(int request, const QStringList &translations, const QString &error);
+
+private:
+    struct Model;
+
+    OfflineTranslator();
+    ~OfflineTranslator();
+    OfflineTranslator(const OfflineTranslator&) = delete;
+    OfflineTranslator& operator=(const OfflineTranslator&) = delete;
+
+    // Everything below runs on m_pool's thread only
+    QStringList run(const QStringList &texts, const QString &source, const QString &target,
+                    int threads, qint64 memoryCap, QString *error);
+    // Installed pair that translates texts from source into target; empty if there is none
+    QString pairFor(const QStringList &texts, const QString &source, const QString &target, QString *error) const;
+    // Loaded model of pair, loading it (and unloading others past memoryCap) if needed
+    Model *model(const QString &pair, int threads, qint64 memoryCap, QString *error);
+
+    QThreadPool m_pool;
+    int m_request = 0;
+
+    QHash<QString, std::shared_ptr<Model>> m_models;  // Pair -> loaded model
+    QStringList m_recent;                             // Loaded pairs, least recently used first
+    qint64 m_loadedBytes = 0;
+    int m_threads = 0;                                // Threads the loaded models were created with
+};
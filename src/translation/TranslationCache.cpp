@@ -0,0 +1,289 @@
+#include "TranslationCache.h"
+#include "../ui/core/AppSettings.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[4] = { 'O', 'H', 'T', 'C' };
+constexpr quint32 FILE_VERSION = 1;
+constexpr qint64 HEADER_SIZE = 8;          // MAGIC, FILE_VERSION
+constexpr qint64 RECORD_HEADER_SIZE = 8;   // Key and value sizes; then the key and value, UTF-8
+constexpr qint64 MB = 1024 * 1024;
+constexpr int MEMORY_CHARS = 1 << 20;      // In-memory tier: about 2 MB of keys and translations
+constexpr QChar SEPARATOR(0x1F);           // Unit separator: never part of OCR'd text
+
+QByteArray fileHeader()
+{
+    QByteArray header(MAGIC, sizeof(MAGIC));
+    const quint32 version = qToLittleEndian(FILE_VERSION);
+    header.append(reinterpret_cast<const char *>(&version), sizeof(version));
+    return header;
+}
+
+size_t keyHash(const QByteArray &key)
+{
+    // Fixed seed: the index is rebuilt every run, but the same key must always land in the same slot
+    return qHash(key, 0);
+}
+
+} // namespace
+
+TranslationCache& TranslationCache::instance()
+{
+    static TranslationCache cache;
+    return cache;
+}
+
+TranslationCache::TranslationCache()
+{
+    m_memory.setMaxCost(MEMORY_CHARS);
+}
+
+TranslationCache::~TranslationCache()
+{
+    close();
+}
+
+QString TranslationCache::lookup(const QString& text, const QString& source, const QString& target)
+{
+    const QString key = makeKey(text, source, target);
+    if (key.isEmpty()) {
+        return QString();
+    }
+    if (const QString *cached = m_memory.object(key)) {
+        return *cached;
+    }
+
+    if (!open()) {
+        return QString();
+    }
+    const QByteArray utf8 = key.toUtf8();
+    const auto it = m_index.constFind(keyHash(utf8));
+    QString translation;
+    if (it == m_index.constEnd() || !readRecord(it.value(), utf8, &translation)) {
+        return QString();
+    }
+    m_memory.insert(key, new QString(translation), key.size() + translation.size());
+    return translation;
+}
+
+void TranslationCache::store(const QString& text, const QString& source, const QString& target, const QString& translation)
+{
+    const QString key = makeKey(text, source, target);
+    if (key.isEmpty() || translation.isEmpty()) {
+        return;
+    }
+    m_memory.insert(key, new QString(translation), key.size() + translation.size());
+
+    if (!open()) {
+        return;
+    }
+    const QByteArray utf8Key = key.toUtf8();
+    const QByteArray utf8Value = translation.toUtf8();
+    const quint32 sizes[2] = { qToLittleEndian(quint32(utf8Key.size())), qToLittleEndian(quint32(utf8Value.size())) };
+    QByteArray record(reinterpret_cast<const char *>(sizes), sizeof(sizes));
+    record += utf8Key;
+    record += utf8Value;
+
+    // Appended, never rewritten in place: the mapped part of the file stays valid
+    const qint64 offset = m_file.size();
+    if (!m_file.seek(offset) || m_file.write(record) != record.size() || !m_file.flush()) {
+        qWarning() << "TranslationCache: Write failed:" << m_file.errorString();
+        return;
+    }
+
+    m_index.insert(keyHash(utf8Key), Record{ offset, record.size() });
+
+    if (m_file.size() > maxFileBytes()) {
+        compact();
+    }
+}
+
+QString TranslationCache::makeKey(const QString& text, const QString& source, const QString& target)
+{
+    // Full-width forms, ligatures and stray spaces from OCR don't make a different text.
+    // Line breaks do: they decide how the text is split into segments and laid out again
+    QStringList lines = text.normalized(QString::NormalizationForm_KC).split('\n');
+    for (QString& line : lines) {
+        line = line.simplified();
+    }
+    const QString normalised = lines.join('\n').trimmed();
+    if (normalised.isEmpty()) {
+        return QString();
+    }
+    return source + SEPARATOR + target + SEPARATOR + normalised;
+}
+
+QString TranslationCache::filePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/translations.bin";
+}
+
+qint64 TranslationCache::maxFileBytes()
+{
+    return qint64(AppSettings::instance().getTranslationConfig().cacheMaxMB) * MB;
+}
+
+bool TranslationCache::open()
+{
+    if (maxFileBytes() <= 0) {
+        // The on-disk tier is switched off; memory still serves this run
+        close();
+        m_opened = false;
+        return false;
+    }
+    if (m_opened) {
+        return m_file.isOpen();
+    }
+    m_opened = true;
+
+    const QString path = filePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qWarning() << "TranslationCache: Can't open" << path << m_file.errorString();
+        return false;
+    }
+    load();
+    return m_file.isOpen();
+}
+
+void TranslationCache::close()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_mapped = 0;
+    }
+    m_file.close();
+    m_index.clear();
+}
+
+void TranslationCache::load()
+{
+    m_index.clear();
+
+    const qint64 size = m_file.size();
+    const QByteArray header = fileHeader();
+    if (size < HEADER_SIZE || !mapTo(size) || memcmp(m_map, header.constData(), HEADER_SIZE) != 0) {
+        // New, foreign or older-format file: start it over
+        if (m_map) {
+            m_file.unmap(m_map);
+            m_map = nullptr;
+            m_mapped = 0;
+        }
+        if (!m_file.resize(0) || !m_file.seek(0) || m_file.write(header) != header.size() || !m_file.flush()) {
+            qWarning() << "TranslationCache: Can't initialise" << m_file.fileName();
+            m_file.close();
+        }
+        return;
+    }
+
+    qint64 offset = HEADER_SIZE;
+    while (offset + RECORD_HEADER_SIZE <= size) {
+        const qint64 keySize = qFromLittleEndian<quint32>(m_map + offset);
+        const qint64 valueSize = qFromLittleEndian<quint32>(m_map + offset + 4);
+        const qint64 recordSize = RECORD_HEADER_SIZE + keySize + valueSize;
+        if (offset + recordSize > size) {
+            break;
+        }
+        const QByteArray key = QByteArray::fromRawData(reinterpret_cast<const char *>(m_map + offset + RECORD_HEADER_SIZE), keySize);
+        m_index.insert(keyHash(key), Record{ offset, recordSize });
+        offset += recordSize;
+    }
+
+    if (offset < size) {
+        // Torn write from a crash: the records before it are intact
+        qDebug() << "TranslationCache: Dropping" << size - offset << "bytes of a torn record";
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_mapped = 0;
+        m_file.resize(offset);
+    }
+    qDebug() << "TranslationCache:" << m_index.size() << "translations," << offset / 1024 << "KB on disk";
+}
+
+bool TranslationCache::mapTo(qint64 end)
+{
+    if (m_map && m_mapped >= end) {
+        return true;
+    }
+    // Appends happened since the last map; map the whole file again
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_mapped = 0;
+    }
+    const qint64 size = m_file.size();
+    if (size < end) {
+        return false;
+    }
+    m_map = m_file.map(0, size);
+    m_mapped = m_map ? size : 0;
+    return m_map != nullptr;
+}
+
+bool TranslationCache::readRecord(const Record& record, const QByteArray& key, QString* value)
+{
+    if (!mapTo(record.offset + record.size)) {
+        return false;
+    }
+    const uchar *data = m_map + record.offset;
+    const qint64 keySize = qFromLittleEndian<quint32>(data);
+    const qint64 valueSize = qFromLittleEndian<quint32>(data + 4);
+    // Another key with the same hash may have taken the slot
+    if (keySize != key.size() || memcmp(data + RECORD_HEADER_SIZE, key.constData(), keySize) != 0) {
+        return false;
+    }
+    *value = QString::fromUtf8(reinterpret_cast<const char *>(data + RECORD_HEADER_SIZE + keySize), valueSize);
+    return true;
+}
+
+void TranslationCache::compact()
+{
+    const qint64 budget = maxFileBytes() / 2;
+    if (!mapTo(m_file.size())) {
+        return;
+    }
+
+    // Newest records first until half the cap is used; superseded records aren't in the index
+    QVector<Record> records;
+    records.reserve(m_index.size());
+    for (const Record &record : std::as_const(m_index)) {
+        records.append(record);
+    }
+    std::sort(records.begin(), records.end(), [](const Record &a, const Record &b) { return a.offset > b.offset; });
+    qint64 kept = 0;
+    int count = 0;
+    while (count < records.size() && kept + records[count].size <= budget) {
+        kept += records[count].size;
+        ++count;
+    }
+    records.resize(count);
+    std::reverse(records.begin(), records.end());
+
+    QByteArray data = fileHeader();
+    data.reserve(HEADER_SIZE + kept);
+    for (const Record &record : std::as_const(records)) {
+        data.append(reinterpret_cast<const char *>(m_map + record.offset), record.size);
+    }
+
+    const qint64 before = m_file.size();
+    const QString path = m_file.fileName();
+    close();
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qWarning() << "TranslationCache: Compaction failed:" << file.errorString();
+    }
+    qDebug() << "TranslationCache: Compacted" << before / 1024 << "KB to" << data.size() / 1024 << "KB";
+
+    m_opened = false;
+    open();
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QFile>
+#include <QHash>
+#include <QString>
+
+/**
+ * Translations already fetched, so the same text is never sent twice
+ * Menus, subtitles and UI strings get OCR'd over and over; each lookup is
+ * keyed by the text (NFKC-normalised, spaces collapsed, line breaks kept) plus the source
+ * and target language codes.
+ *
+ * Two tiers: an in-memory LRU (QCache) in front of an append-only file in the
+ * cache directory, memory-mapped for reads. Only an index (key hash -> record
+ * offset) is kept in memory for the file. A key stored again supersedes its
+ * old record; once the file grows past translation/cacheMaxMB it is compacted
+ * down to its newest half. Hits work offline and cost no request.
+ *
+ * GUI thread only, like TranslationEngine.
+ */
+class TranslationCache
+{
+public:
+    static TranslationCache& instance();
+
+    // Cached translation of text from source to target (language codes); empty on a miss
+    QString lookup(const QString& text, const QString& source, const QString& target);
+    void store(const QString& text, const QString& source, const QString& target, const QString& translation);
+
+private:
+    // Where a key's newest record is in the file
+    struct Record {
+        qint64 offset = 0;
+        qint64 size = 0;
+    };
+
+    TranslationCache();
+    ~TranslationCache();
+    TranslationCache(const TranslationCache&) = delete;
+    TranslationCache& operator=(const TranslationCache&) = delete;
+
+    static QString makeKey(const QString& text, const QString& source, const QString& target);
+    static QString filePath();
+    static qint64 maxFileBytes();
+
+    bool open();
+    void close();
+    // Rebuilds the index from the file; a torn record at the end is cut off
+    void load();
+    // Maps at least up to end; false if the file can't be mapped
+    bool mapTo(qint64 end);
+    // Value of record if its key is key
+    bool readRecord(const Record& record, const QByteArray& key, QString* value);
+    // Rewrites the file with only the newest live records, up to half the size cap
+    void compact();
+
+    QCache<QString, QString> m_memory;  // Key -> translation; cost in characters
+    QFile m_file;
+    uchar* m_map = nullptr;
+    qint64 m_mapped = 0;                // Bytes of m_file covered by m_map
+    QHash<size_t, Record> m_index;      // qHash of the UTF-8 key -> its newest record
+    bool m_opened = false;              // open() was tried (it isn't retried after a failure)
+};
@@ -1,4 +1,7 @@
 #include "TranslationEngine.h"
+#include "TranslationCache.h"
+#include "OfflineTranslator.h"
+#include "NetworkService.h"
 #include "../ui/core/LanguageManager.h"
 #include <QCoreApplication>
 #include <QDebug>
@@ -6,24 +9,32 @@
 #include <QHttpMultiPart>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QTextBoundaryFinder>
+
+namespace {
+const QString GOOGLE_TRANSLATE_HOST = QStringLiteral("translate.googleapis.com");
+}
 
 TranslationEngine::TranslationEngine(QObject *parent)
     : QObject(parent)
 {
-    m_networkManager = new QNetworkAccessManager(this);
-    m_timeoutTimer = new QTimer(this);
-    m_timeoutTimer->setSingleShot(true);
-    connect(m_timeoutTimer, &QTimer::timeout, this, &TranslationEngine::onRequestTimeout);
+    // Shared with speech: a connection either of them opened (or prewarm() did) is reused
+    m_networkManager = NetworkService::manager();
 
     m_settings = new QSettings(QCoreApplication::organizationName(), QCoreApplication::applicationName(), this);
+
+    // Shared by every engine instance; results for another instance's request are ignored
+    connect(&OfflineTranslator::instance(), &OfflineTranslator::finished, this, &TranslationEngine::onOfflineFinished);
 }
 
 TranslationEngine::~TranslationEngine()
 {
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply->deleteLater();
-    }
+    abortChunks();
+}
+
+void TranslationEngine::prewarm()
+{
+    NetworkService::prewarm(GOOGLE_TRANSLATE_HOST);
 }
 
 void TranslationEngine::setEngine(Engine engine)
@@ -61,6 +72,105 @@ void TranslationEngine::translate(const QString &text)
         return;
     }
 
+    QString sourceLang;
+    QString targetLang;
+    if (!checkLanguages(&sourceLang, &targetLang)) {
+        return;
+    }
+
+    // Cancel any existing request
+    abortChunks();
+    m_givenSegments.clear();
+
+    // Text translated before (same menu, same subtitle) needs no request, and works offline
+    const QString cached = TranslationCache::instance().lookup(text, sourceLang, targetLang);
+    if (!cached.isEmpty()) {
+        qDebug() << "TranslationEngine: Cache hit for" << text.left(50);
+        TranslationResult result;
+        result.translatedText = cached;
+        result.sourceLanguage = m_sourceLanguage;
+        result.targetLanguage = m_targetLanguage;
+        result.success = true;
+        emit translationProgress("Translation completed");
+        emit translationFinished(result);
+        return;
+    }
+
+    m_currentText = text;
+    m_currentSourceCode = sourceLang;
+    m_currentTargetCode = targetLang;
+    emit translationProgress("Starting translation...");
+
+    if (m_engine == Offline) {
+        splitPieces();
+        startOffline();
+        return;
+    }
+
+    // A scrolled or re-selected region is mostly text seen before: only its new sentences are sent
+    if (startSegments()) {
+        return;
+    }
+    m_segmented = false;
+    QVector<QStringList> chunks;
+    for (const QString &chunk : chunkTextByLimit(text, CHUNK_CHAR_LIMIT)) {
+        chunks.append({ chunk });
+    }
+    startChunks(chunks);
+}
+
+void TranslationEngine::translateSegments(const QStringList &texts)
+{
+    bool empty = true;
+    for (const QString &text : texts) {
+        empty = empty && text.trimmed().isEmpty();
+    }
+    if (empty) {
+        TranslationResult result;
+        result.success = false;
+        result.errorMessage = "No text to translate";
+        emit translationFinished(result);
+        return;
+    }
+
+    QString sourceLang;
+    QString targetLang;
+    if (!checkLanguages(&sourceLang, &targetLang)) {
+        return;
+    }
+    abortChunks();
+
+    // One segment piece per text; the cache answers per text, so there is no whole-text lookup
+    m_givenSegments = texts;
+    m_currentText = texts.join('\n');
+    m_currentSourceCode = sourceLang;
+    m_currentTargetCode = targetLang;
+    m_pieces.clear();
+    for (int i = 0; i < texts.size(); ++i) {
+        if (i > 0) {
+            m_pieces.append({ QStringLiteral("\n"), false });
+        }
+        const QString core = texts[i].trimmed();
+        m_pieces.append({ core, !core.isEmpty() });
+    }
+    emit translationProgress("Starting translation...");
+
+    if (m_engine == Offline) {
+        startOffline();
+        return;
+    }
+    m_segmented = true;
+    int segments = 0;
+    const QStringList missing = missingSegments(&segments);
+    if (missing.isEmpty()) {
+        finishChunks();
+        return;
+    }
+    startSegmentChunks(missing);
+}
+
+bool TranslationEngine::checkLanguages(QString *sourceCode, QString *targetCode)
+{
     // Validate language configuration
     QString sourceLang = getLanguageCode(m_sourceLanguage, m_engine);
     QString targetLang = getLanguageCode(m_targetLanguage, m_engine);
@@ -79,225 +189,227 @@ void TranslationEngine::translate(const QString &text)
         qDebug() << "Translation aborted:" << result.errorMessage;
         emit translationError(result.errorMessage);
         emit translationFinished(result);
-        return;
+        return false;
     }
 
-    m_currentText = text;
-    emit translationProgress("Starting translation...");
+    *sourceCode = sourceLang;
+    *targetCode = targetLang;
+    return true;
+}
 
-    // Cancel any existing request
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
+void TranslationEngine::splitPieces()
+{
+    // Lines, then sentences within each line; the whitespace around them is kept for reassembly
+    m_pieces.clear();
+    const QStringList lines = m_currentText.split('\n');
+    for (int i = 0; i < lines.size(); ++i) {
+        if (i > 0) {
+            m_pieces.append({ QStringLiteral("\n"), false });
+        }
+        const QString &line = lines[i];
+        QTextBoundaryFinder finder(QTextBoundaryFinder::Sentence, line);
+        int start = 0;
+        while (start < line.size()) {
+            int end = finder.toNextBoundary();
+            if (end <= start) {
+                end = line.size();
+            }
+            const QString sentence = line.mid(start, end - start);
+            const QString core = sentence.trimmed();
+            if (core.isEmpty()) {
+                m_pieces.append({ sentence, false });
+            } else {
+                const int leading = sentence.indexOf(core);
+                if (leading > 0) {
+                    m_pieces.append({ sentence.left(leading), false });
+                }
+                m_pieces.append({ core, true });
+                if (leading + core.size() < sentence.size()) {
+                    m_pieces.append({ sentence.mid(leading + core.size()), false });
+                }
+            }
+            start = end;
+        }
     }
+}
 
-    // Reset state for new translation
-    m_aggregatedText.clear();
-    m_forceAutoDetect = false;
-    m_retryAttempt = 0;
-    m_chunks = chunkTextByLimit(text, CHUNK_CHAR_LIMIT);
-    m_currentChunkIndex = -1;
-    startNextChunk();
+QStringList TranslationEngine::missingSegments(int *segmentCount)
+{
+    // Known segments come from the cache; each missing one is sent once, however often it appears
+    m_segmentTranslations.clear();
+    QStringList missing;
+    int segments = 0;
+    for (const Piece &piece : std::as_const(m_pieces)) {
+        if (!piece.segment) {
+            continue;
+        }
+        ++segments;
+        if (m_segmentTranslations.contains(piece.text) || missing.contains(piece.text)) {
+            continue;
+        }
+        const QString cached = TranslationCache::instance().lookup(piece.text, m_currentSourceCode, m_currentTargetCode);
+        if (cached.isEmpty()) {
+            missing.append(piece.text);
+        } else {
+            m_segmentTranslations.insert(piece.text, cached);
+        }
+    }
+    qDebug() << "TranslationEngine:" << segments - missing.size() << "of" << segments << "segments cached;"
+             << missing.size() << "to translate";
+    *segmentCount = segments;
+    return missing;
 }
 
-QNetworkRequest TranslationEngine::createGoogleTranslateRequest(const QString &url)
+bool TranslationEngine::startSegments()
 {
-    QNetworkRequest request{QUrl(url)};
-    request.setRawHeader("User-Agent", "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
-    request.setRawHeader("Accept", "application/json, text/plain, */*");
-    request.setRawHeader("Accept-Language", "en-US,en;q=0.9");
-    request.setRawHeader("Cache-Control", "no-cache");
-    request.setRawHeader("Pragma", "no-cache");
-    request.setRawHeader("Referer", "https://translate.google.com/");
-    return request;
+    splitPieces();
+    int segments = 0;
+    const QStringList missing = missingSegments(&segments);
+    for (const QString &segment : missing) {
+        if (segment.size() > CHUNK_CHAR_LIMIT) {
+            return false;
+        }
+    }
+    if (segments < 2 && missing.size() == segments) {
+        // A single new sentence: nothing to save by segmenting
+        return false;
+    }
+
+    m_segmented = true;
+    startSegmentChunks(missing);
+    return true;
 }
 
-void TranslationEngine::translateWithGoogle(const QString &text)
+void TranslationEngine::startSegmentChunks(const QStringList &missing)
 {
-    emit translationProgress("Connecting to Google Translate...");
+    QVector<QStringList> chunks;
+    QStringList chunk;
+    int chunkSize = 0;
+    for (const QString &segment : std::as_const(missing)) {
+        if (!chunk.isEmpty() && chunkSize + segment.size() > CHUNK_CHAR_LIMIT) {
+            chunks << chunk;
+            chunk.clear();
+            chunkSize = 0;
+        }
+        chunk << segment;
+        chunkSize += segment.size();
+    }
+    if (!chunk.isEmpty()) {
+        chunks << chunk;
+    }
+    startChunks(chunks);
+}
 
-    QString url = buildGoogleTranslateUrl(text);
-    QNetworkRequest request = createGoogleTranslateRequest(url);
+void TranslationEngine::storeSegmentTranslations(const QStringList &segments, const QStringList &translations)
+{
+    for (int i = 0; i < segments.size(); ++i) {
+        const QString translation = translations[i].trimmed();
+        m_segmentTranslations.insert(segments[i], translation);
+        TranslationCache::instance().store(segments[i], m_currentSourceCode, m_currentTargetCode, translation);
+    }
+}
 
-    // Cancel any existing reply
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
+void TranslationEngine::startOffline()
+{
+    // Sentence by sentence, as the models were trained; the cache still answers the ones seen before
+    m_segmented = true;
+    int segments = 0;
+    m_offlineSegments = missingSegments(&segments);
+    if (m_offlineSegments.isEmpty()) {
+        finishChunks();
+        return;
     }
+    m_offlineRequest = OfflineTranslator::instance().translate(m_offlineSegments, m_currentSourceCode, m_currentTargetCode);
+}
 
-    m_currentReply = m_networkManager->get(request);
-    connect(m_currentReply, &QNetworkReply::finished, this, &TranslationEngine::onNetworkReplyFinished);
-    m_timeoutTimer->start(TIMEOUT_MS);
+void TranslationEngine::onOfflineFinished(int request, const QStringList &translations, const QString &error)
+{
+    if (request != m_offlineRequest) {
+        return;
+    }
+    m_offlineRequest = 0;
+    if (!error.isEmpty()) {
+        failTranslation(error);
+        return;
+    }
+    storeSegmentTranslations(m_offlineSegments, translations);
+    finishChunks();
 }
 
-// REMOVED: Non-Google translation engines (LibreTranslate, Ollama, Microsoft, L, Offline)
-// Only Google Translate is supported (free, no API key needed)
+QString TranslationEngine::assembleSegments() const
+{
+    QString text;
+    for (const Piece &piece : m_pieces) {
+        text += piece.segment ? m_segmentTranslations.value(piece.text) : piece.text;
+    }
+    return text;
+}
 
-QString TranslationEngine::buildGoogleTranslateUrl(const QString &text)
+QNetworkRequest TranslationEngine::createGoogleTranslateRequest(const QUrl &url)
 {
-    QString sourceLang = getLanguageCode(m_sourceLanguage, GoogleTranslate);
+    QNetworkRequest request{url};
+    request.setRawHeader("User-Agent", "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36");
+    request.setRawHeader("Accept", "application/json, text/plain, */*");
+    request.setRawHeader("Accept-Language", "en-US,en;q=0.9");
+    request.setRawHeader("Cache-Control", "no-cache");
+    request.setRawHeader("Pragma", "no-cache");
+    request.setRawHeader("Referer", "https://translate.google.com/");
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded;charset=UTF-8");
+    // Concurrent chunks share one multiplexed connection instead of opening one each
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    request.setTransferTimeout(TIMEOUT_MS);
+    return request;
+}
+
+QUrl TranslationEngine::buildGoogleTranslateUrl(bool forceAutoDetect) const
+{
+    QString sourceLang = forceAutoDetect ? QStringLiteral("auto")
+                                         : getLanguageCode(m_sourceLanguage, GoogleTranslate);
     QString targetLang = getLanguageCode(m_targetLanguage, GoogleTranslate);
 
     qDebug() << "TranslationEngine: Building Google Translate URL";
     qDebug() << "  Source language (display):" << m_sourceLanguage << "-> code:" << sourceLang;
     qDebug() << "  Target language (display):" << m_targetLanguage << "-> code:" << targetLang;
-    qDebug() << "  Text to translate:" << text.left(50);
 
-    QUrl url("https://translate.googleapis.com/translate_a/single");
+    // translate_a/t answers every q field separately, in order
+    QUrl url("https://" + GOOGLE_TRANSLATE_HOST + "/translate_a/t");
     QUrlQuery query;
     query.addQueryItem("client", "gtx");
     query.addQueryItem("sl", sourceLang);
     query.addQueryItem("tl", targetLang);
-    query.addQueryItem("dt", "t");
     query.addQueryItem("hl", "en");
     query.addQueryItem("ie", "UTF-8");
     query.addQueryItem("oe", "UTF-8");
-    query.addQueryItem("dj", "1");          // prefer object format for robustness
     query.addQueryItem("source", "input");   // better handling for multi-script
-    query.addQueryItem("q", text);
-    url.setQuery(query);
-
-    return url.toString();
-}
-
-QString TranslationEngine::buildGoogleTranslateUrl(const QString &text, bool forceAutoDetect)
-{
-    QString src = forceAutoDetect ? QStringLiteral("auto")
-                                  : getLanguageCode(m_sourceLanguage, GoogleTranslate);
-    QString tgt = getLanguageCode(m_targetLanguage, GoogleTranslate);
-    QUrl url("https://translate.googleapis.com/translate_a/single");
-    QUrlQuery query;
-    query.addQueryItem("client", "gtx");
-    query.addQueryItem("sl", src);
-    query.addQueryItem("tl", tgt);
-    query.addQueryItem("dt", "t");
-    query.addQueryItem("hl", "en");
-    query.addQueryItem("ie", "UTF-8");
-    query.addQueryItem("oe", "UTF-8");
-    query.addQueryItem("dj", "1");
-    query.addQueryItem("source", "input");
-    query.addQueryItem("q", text);
     url.setQuery(query);
-    return url.toString();
+    return url;
 }
 
-void TranslationEngine::onNetworkReplyFinished()
+QByteArray TranslationEngine::buildGoogleTranslateBody(const QStringList &texts)
 {
-    m_timeoutTimer->stop();
-
-    if (!m_currentReply) {
-        return;
+    // One q field per text: the body has no length cap, and no separator in the texts can merge two
+    QUrlQuery body;
+    for (const QString &text : texts) {
+        body.addQueryItem("q", text);
     }
-
-    auto cleanupReply = [this]() {
-        if (m_currentReply) {
-            m_currentReply->deleteLater();
-            m_currentReply = nullptr;
-        }
-    };
-
-    if (m_currentReply->error() != QNetworkReply::NoError) {
-        QString errorMsg = QString("Network error: %1").arg(m_currentReply->errorString());
-        qDebug() << errorMsg;
-        cleanupReply();
-
-        if (m_retryAttempt < MAX_RETRIES) {
-            int delay = BACKOFF_BASE_MS * (1 << m_retryAttempt);
-            m_retryAttempt++;
-            emit translationProgress(QString("Retrying... (%1/%2)").arg(m_retryAttempt).arg(MAX_RETRIES));
-            QTimer::singleShot(delay, this, [this]() {
-                // If we detect right-to-left or Cyrillic content, force auto-detect on retry
-                if (!m_chunks.isEmpty()) {
-                    QString chunk = m_chunks.value(m_currentChunkIndex);
-                    // Use QRegularExpression (Qt 6)
-                    QRegularExpression arabicRe(QStringLiteral("[\u0600-\u06FF]"));
-                    QRegularExpression cyrillicRe(QStringLiteral("[\u0400-\u04FF]"));
-                    bool rtlOrCyr = arabicRe.match(chunk).hasMatch() || cyrillicRe.match(chunk).hasMatch();
-                    if (rtlOrCyr) {
-                        m_forceAutoDetect = true;
-                    }
-                }
-                sendRequestForText(m_chunks.value(m_currentChunkIndex));
-            });
-            return;
-        }
-
-        emit translationError(errorMsg);
-        TranslationResult result;
-        result.success = false;
-        result.errorMessage = errorMsg;
-        emit translationFinished(result);
-        return;
-    }
-
-    QByteArray response = m_currentReply->readAll();
-    cleanupReply();
-
-    // Only Google Translate is supported
-    parseGoogleResponse(response);
+    // Fully encoded: '+', '&' and '=' in a text must not read as form syntax
+    return body.query(QUrl::FullyEncoded).toUtf8();
 }
 
-void TranslationEngine::parseGoogleResponse(const QByteArray &response)
+QString TranslationEngine::engineName(Engine engine)
 {
-    QString chunkText;
-    if (!parseGoogleResponseText(response, chunkText)) {
-        if (m_retryAttempt < MAX_RETRIES) {
-            int delay = BACKOFF_BASE_MS * (1 << m_retryAttempt);
-            m_retryAttempt++;
-            emit translationProgress(QString("Retrying parse... (%1/%2)").arg(m_retryAttempt).arg(MAX_RETRIES));
-            QTimer::singleShot(delay, this, [this]() {
-                sendRequestForText(m_chunks.value(m_currentChunkIndex));
-            });
-            return;
-        }
-
-        TranslationResult result;
-        result.success = false;
-        result.errorMessage = "Failed to parse Google Translate response";
-        emit translationError(result.errorMessage);
-        emit translationFinished(result);
-        return;
-    }
-
-    m_aggregatedText += chunkText;
-
-    // Move to next chunk or finish
-    startNextChunk();
+    return engine == Offline ? QStringLiteral("Offline (on-device)") : QStringLiteral("Google Translate (Free)");
 }
 
-// Only Google Translate is supported
-
-void TranslationEngine::onRequestTimeout()
+TranslationEngine::Engine TranslationEngine::engineForName(const QString &name)
 {
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
-    }
-
-    if (m_retryAttempt < MAX_RETRIES) {
-        int delay = BACKOFF_BASE_MS * (1 << m_retryAttempt);
-        m_retryAttempt++;
-        emit translationProgress(QString("Retrying after timeout... (%1/%2)").arg(m_retryAttempt).arg(MAX_RETRIES));
-        QTimer::singleShot(delay, this, [this]() {
-            sendRequestForText(m_chunks.value(m_currentChunkIndex));
-        });
-        return;
-    }
-
-    TranslationResult result;
-    result.success = false;
-    result.errorMessage = "Translation request timed out";
-
-    emit translationError("Request timed out");
-    emit translationFinished(result);
+    // A build without CTranslate2 falls back to Google for a setting made by one with it
+    return name == engineName(Offline) && OfflineTranslator::isAvailable() ? Offline : GoogleTranslate;
 }
 
 QString TranslationEngine::getLanguageCode(const QString &language, Engine engine)
 {
-    Q_UNUSED(engine); // Only Google Translate is supported
+    Q_UNUSED(engine); // Offline model directories are named after the same codes
 
     // Special case for Auto-Detect
     if (language == "Auto-Detect") {
@@ -357,22 +469,131 @@ QStringList TranslationEngine::chunkTextByLimit(const QString &text, int limit)
     return chunks;
 }
 
-void TranslationEngine::startNextChunk()
+void TranslationEngine::startChunks(const QVector<QStringList> &chunks)
 {
-    m_retryAttempt = 0;
-    m_currentChunkIndex++;
-    if (m_currentChunkIndex >= 0 && m_currentChunkIndex < m_chunks.size()) {
-        QString status = QString("Translating chunk %1/%2...")
-                              .arg(m_currentChunkIndex + 1)
-                              .arg(m_chunks.size());
-        emit translationProgress(status);
-        sendRequestForText(m_chunks[m_currentChunkIndex]);
+    m_chunks = chunks;
+    m_chunkState = QVector<Chunk>(chunks.size());
+    m_nextChunk = 0;
+    m_inFlight = 0;
+    m_chunksDone = 0;
+    dispatchChunks();
+}
+
+void TranslationEngine::dispatchChunks()
+{
+    if (m_chunksDone == m_chunks.size()) {
+        finishChunks();
         return;
     }
+    // A slot is held from the first send until the chunk is done, retries included
+    while (m_inFlight < MAX_IN_FLIGHT && m_nextChunk < m_chunks.size()) {
+        ++m_inFlight;
+        sendChunk(m_nextChunk++);
+    }
+}
 
-    // Finished all chunks
+void TranslationEngine::sendChunk(int index)
+{
+    // Build URL based on whether we're forcing auto-detect
+    const QUrl url = buildGoogleTranslateUrl(m_chunkState[index].forceAutoDetect);
+    QNetworkReply *reply = m_networkManager->post(createGoogleTranslateRequest(url),
+                                                  buildGoogleTranslateBody(m_chunks[index]));
+    m_chunkState[index].reply = reply;
+    const int generation = m_generation;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, index, generation]() {
+        onChunkFinished(reply, index, generation);
+    });
+}
+
+void TranslationEngine::onChunkFinished(QNetworkReply *reply, int index, int generation)
+{
+    reply->deleteLater();
+    if (generation != m_generation) {
+        return;
+    }
+    Chunk &chunk = m_chunkState[index];
+    chunk.reply = nullptr;
+
+    QString error;
+    QStringList translations;
+    if (reply->error() == QNetworkReply::OperationCanceledError || reply->error() == QNetworkReply::TimeoutError) {
+        // Only the transfer timeout cancels a reply of the current translation
+        error = "Translation request timed out";
+    } else if (reply->error() != QNetworkReply::NoError) {
+        error = QString("Network error: %1").arg(reply->errorString());
+    } else {
+        // The reply's shape follows what was asked for, so read sl back from the request
+        const bool autoDetect = QUrlQuery(reply->request().url()).queryItemValue("sl") == "auto";
+        const QByteArray body = reply->readAll();
+        if (!parseGoogleBatchResponse(body, m_chunks[index].size(), autoDetect, translations)) {
+            // Size and status only: the body is the user's text
+            qDebug() << "TranslationEngine: Unparsable reply of" << body.size() << "bytes, HTTP"
+                     << reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            error = "Failed to parse Google Translate response";
+        }
+    }
+
+    if (!error.isEmpty()) {
+        qDebug() << "TranslationEngine: Chunk" << index + 1 << "of" << m_chunks.size() << "-" << error;
+        if (chunk.attempts >= MAX_RETRIES) {
+            failTranslation(error);
+            return;
+        }
+        // Only this chunk waits, still holding its slot; the others go on
+        const int delay = BACKOFF_BASE_MS * (1 << chunk.attempts);
+        chunk.attempts++;
+        emit translationProgress(QString("Retrying... (%1/%2)").arg(chunk.attempts).arg(MAX_RETRIES));
+
+        // If we detect right-to-left or Cyrillic content, force auto-detect on retry
+        static const QRegularExpression rtlOrCyrillic(QStringLiteral("[\u0600-\u06FF\u0400-\u04FF]"));
+        if (rtlOrCyrillic.match(m_chunks[index].join('\n')).hasMatch()) {
+            chunk.forceAutoDetect = true;
+        }
+        QTimer::singleShot(delay, this, [this, index, generation]() {
+            if (generation == m_generation) {
+                sendChunk(index);
+            }
+        });
+        return;
+    }
+
+    if (m_segmented) {
+        // The n-th q field's translation is the n-th entry, whatever the provider does to line breaks
+        storeSegmentTranslations(m_chunks[index], translations);
+    }
+
+    chunk.translations = translations;
+    chunk.done = true;
+    --m_inFlight;
+    ++m_chunksDone;
+    if (m_chunks.size() > 1) {
+        emit translationProgress(QString("Translated chunk %1/%2...").arg(m_chunksDone).arg(m_chunks.size()));
+    }
+    dispatchChunks();
+}
+
+void TranslationEngine::finishChunks()
+{
+    // In the original order, however the replies arrived
     TranslationResult result;
-    result.translatedText = m_aggregatedText;
+    QString translated;
+    if (!m_givenSegments.isEmpty()) {
+        for (const QString &text : std::as_const(m_givenSegments)) {
+            result.segments << m_segmentTranslations.value(text.trimmed());
+        }
+        translated = result.segments.join('\n');
+    } else if (m_segmented) {
+        translated = assembleSegments();
+    } else {
+        for (const Chunk &chunk : std::as_const(m_chunkState)) {
+            translated += chunk.translations.join(QString());
+        }
+    }
+    if (m_givenSegments.isEmpty()) {
+        TranslationCache::instance().store(m_currentText, m_currentSourceCode, m_currentTargetCode, translated);
+    }
+
+    result.translatedText = translated;
     result.sourceLanguage = m_sourceLanguage;
     result.targetLanguage = m_targetLanguage;
     result.success = true;
@@ -380,27 +601,38 @@ void TranslationEngine::startNextChunk()
     emit translationFinished(result);
 }
 
-void TranslationEngine::sendRequestForText(const QString &text)
+void TranslationEngine::cancel()
 {
-    // Build URL based on whether we're forcing auto-detect
-    QString url = m_forceAutoDetect ? buildGoogleTranslateUrl(text, true)
-                                    : buildGoogleTranslateUrl(text);
+    abortChunks();
+}
 
-    QNetworkRequest request = createGoogleTranslateRequest(url);
+void TranslationEngine::failTranslation(const QString &error)
+{
+    // One chunk gave up: the rest can't make a whole translation
+    abortChunks();
+    TranslationResult result;
+    result.success = false;
+    result.errorMessage = error;
+    emit translationError(error);
+    emit translationFinished(result);
+}
 
-    // Cancel any existing reply
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
+void TranslationEngine::abortChunks()
+{
+    ++m_generation;
+    m_offlineRequest = 0;
+    for (Chunk &chunk : m_chunkState) {
+        if (chunk.reply) {
+            QNetworkReply *reply = chunk.reply;
+            chunk.reply = nullptr;
+            reply->abort();
+        }
     }
-
-    m_currentReply = m_networkManager->get(request);
-    connect(m_currentReply, &QNetworkReply::finished, this, &TranslationEngine::onNetworkReplyFinished);
-    m_timeoutTimer->start(TIMEOUT_MS);
+    m_inFlight = 0;
 }
 
-bool TranslationEngine::parseGoogleResponseText(const QByteArray &response, QString &outText)
+bool TranslationEngine::parseGoogleBatchResponse(const QByteArray &response, int count, bool autoDetect,
+                                                 QStringList &outTexts)
 {
     // Strip potential XSSI prefix ")]}\'\n"
     QByteArray body = response.trimmed();
@@ -411,7 +643,10 @@ bool TranslationEngine::parseGoogleResponseText(const QByteArray &response, QStr
         }
     }
 
-    qDebug() << "Raw Google Translate response (first 500 chars):" << QString::fromUtf8(body.left(500));
+    // A single q can come back as a bare string rather than a one-entry array
+    if (!body.startsWith('[')) {
+        body = '[' + body + ']';
+    }
 
     // Parse JSON
     QJsonParseError error;
@@ -420,53 +655,39 @@ bool TranslationEngine::parseGoogleResponseText(const QByteArray &response, QStr
         qDebug() << "JSON parse error at offset" << error.offset << ":" << error.errorString();
         return false;
     }
+    if (!doc.isArray()) {
+        qDebug() << "Batch response is not an array";
+        return false;
+    }
 
-    // Format 1: Array-based response [[["translated","original",null,null,3]]]
-    if (doc.isArray()) {
-        QJsonArray mainArray = doc.array();
-        if (!mainArray.isEmpty() && mainArray[0].isArray()) {
-            QJsonArray translationsArray = mainArray[0].toArray();
-            QString translatedText;
-            for (const auto &value : translationsArray) {
-                if (value.isArray()) {
-                    QJsonArray item = value.toArray();
-                    if (!item.isEmpty() && item[0].isString()) {
-                        translatedText += item[0].toString();
-                    }
-                }
-            }
-            if (!translatedText.isEmpty()) {
-                outText = translatedText;
-                qDebug() << "Parsed array-based response, translated text length:" << outText.length();
-                return true;
-            }
-        }
-        qDebug() << "Array-based response format not recognized";
-    }
-
-    // Format 2: Object with sentences array (dj=1 style) {"sentences":[{"trans":"..."}]}
-    if (doc.isObject()) {
-        QJsonObject obj = doc.object();
-        if (obj.contains("sentences") && obj["sentences"].isArray()) {
-            QJsonArray sentences = obj["sentences"].toArray();
-            QString translatedText;
-            for (const auto &s : sentences) {
-                if (s.isObject()) {
-                    QJsonObject so = s.toObject();
-                    if (so.contains("trans") && so["trans"].isString()) {
-                        translatedText += so["trans"].toString();
-                    }
-                }
-            }
-            if (!translatedText.isEmpty()) {
-                outText = translatedText;
-                qDebug() << "Parsed object-based response, translated text length:" << outText.length();
-                return true;
-            }
+    // One entry per q field: "translated", or ["translated","detected language"] when sl=auto
+    const QJsonArray entries = doc.array();
+    if (autoDetect && count == 1) {
+        // A single q with sl=auto isn't wrapped in an outer array: entries is its own pair
+        if (entries.isEmpty() || !entries[0].isString()) {
+            qDebug() << "Batch response entry format not recognized";
+            return false;
         }
-        qDebug() << "Object-based response missing 'sentences' array or trans field";
+        outTexts = QStringList{ entries[0].toString() };
+        return true;
+    }
+    if (entries.size() != count) {
+        qDebug() << "Sent" << count << "texts, got" << entries.size() << "translations back";
+        return false;
     }
 
-    qDebug() << "No recognized response format found";
-    return false;
-}
\ No newline at end of file
+    QStringList texts;
+    for (const auto &entry : std::as_const(entries)) {
+        if (entry.isString()) {
+            texts << entry.toString();
+        } else if (entry.isArray() && !entry.toArray().isEmpty() && entry.toArray().at(0).isString()) {
+            texts << entry.toArray().at(0).toString();
+        } else {
+            qDebug() << "Batch response entry format not recognized";
+            return false;
+        }
+    }
+    outTexts = texts;
+    qDebug() << "Parsed batch response," << texts.size() << "translations";
+    return true;
+}
@@ -13,6 +13,8 @@
 #include <QTimer>
 #include <QSettings>
 #include <QStringList>
+#include <QHash>
+#include <QVector>
 
 struct TranslationResult {
     QString translatedText;
@@ -21,6 +23,7 @@ struct TranslationResult {
     QString confidence;
     bool success = false;
     QString errorMessage;
+    QStringList segments;  // translateSegments(): one translation per text, in the order given
 };
 
 class TranslationEngine : public QObject
@@ -29,7 +32,8 @@ class TranslationEngine : public QObject
 
 public:
     enum Engine {
-        GoogleTranslate  // Only Google Translate is supported (free, no API key needed)
+        GoogleTranslate, // Free, no API key needed
+        Offline          // On-device models (OfflineTranslator); no network
     };
 
     explicit TranslationEngine(QObject *parent = nullptr);
@@ -47,8 +51,20 @@ public:
     QString sourceLanguage() const { return m_sourceLanguage; }
     QString targetLanguage() const { return m_targetLanguage; }
 
+    // Connects to the translation host ahead of the first request, e.g. while the user selects
+    static void prewarm();
+
     // Main translation function
     void translate(const QString &text);
+    // Each text is one segment (one q field), never split or merged with its neighbours,
+    // so the result's segments map back onto the texts exactly, e.g. table cells
+    void translateSegments(const QStringList &texts);
+    // Drops the translation in flight; no signal follows for it
+    void cancel();
+
+    // Names the settings store translation/engine as
+    static QString engineName(Engine engine);
+    static Engine engineForName(const QString &name);
 
     // Language code conversion
     static QString getLanguageCode(const QString &language, Engine engine);
@@ -59,22 +75,43 @@ signals:
     void translationProgress(const QString &status);
     void translationError(const QString &error);
 
-private slots:
-    void onNetworkReplyFinished();
-    void onRequestTimeout();
-
 private:
-    void translateWithGoogle(const QString &text);
-	void parseGoogleResponse(const QByteArray &response);
-	bool parseGoogleResponseText(const QByteArray &response, QString &outText);
-	void sendRequestForText(const QString &text);
+	// Translations of a batch of count q fields, in the order they were sent; false unless there are exactly count.
+	// autoDetect: the request went out with sl=auto, so each entry also carries the detected language
+	bool parseGoogleBatchResponse(const QByteArray &response, int count, bool autoDetect, QStringList &outTexts);
 	QStringList chunkTextByLimit(const QString &text, int limit) const;
-	void startNextChunk();
-    QNetworkRequest createGoogleTranslateRequest(const QString &url);
+	// Chunks go out concurrently, at most MAX_IN_FLIGHT at a time, and are reassembled in order
+	// Each chunk is one POST request; its entries go out as separate q fields
+	void startChunks(const QVector<QStringList> &chunks);
+	void dispatchChunks();
+	void sendChunk(int index);
+	void onChunkFinished(QNetworkReply *reply, int index, int generation);
+	void finishChunks();
+	void failTranslation(const QString &error);
+	// Resolves the language codes; false (and the error already emitted) if they can't be used
+	bool checkLanguages(QString *sourceCode, QString *targetCode);
+	// Drops every reply and retry of the current translation
+	void abortChunks();
+	// Splits m_currentText into m_pieces: lines, then sentences
+	void splitPieces();
+	// Takes what the cache knows for the segments of m_pieces; returns the ones still missing
+	QStringList missingSegments(int *segmentCount);
+	// Sends only the segments of m_currentText the cache doesn't know; false if it can't be segmented
+	bool startSegments();
+	// Missing segments one per q field, in as few requests as the size limit allows
+	void startSegmentChunks(const QStringList &missing);
+	// Caches translations, one per entry of segments
+	void storeSegmentTranslations(const QStringList &segments, const QStringList &translations);
+	// Translates the missing segments of m_pieces with OfflineTranslator instead of over the network
+	void startOffline();
+	void onOfflineFinished(int request, const QStringList &translations, const QString &error);
+	QString assembleSegments() const;
+    QNetworkRequest createGoogleTranslateRequest(const QUrl &url);
 
     QString detectSourceLanguage(const QString &text);
-    QString buildGoogleTranslateUrl(const QString &text);
-    QString buildGoogleTranslateUrl(const QString &text, bool forceAutoDetect);
+    // Texts go in the POST body, not the URL: no length cap from the query string
+    QUrl buildGoogleTranslateUrl(bool forceAutoDetect) const;
+    static QByteArray buildGoogleTranslateBody(const QStringList &texts);
 
     Engine m_engine = GoogleTranslate;
     QString m_sourceLanguage; // Set from user settings
@@ -82,19 +119,42 @@ private:
     QString m_apiKey;
     QString m_apiUrl;
     QString m_currentText;
+    QString m_currentSourceCode;  // Language codes m_currentText is cached under once translated
+    QString m_currentTargetCode;
 
-    QNetworkAccessManager *m_networkManager = nullptr;
-    QNetworkReply *m_currentReply = nullptr;
-    QTimer *m_timeoutTimer = nullptr;
+    QNetworkAccessManager *m_networkManager = nullptr;  // NetworkService's, not owned
     QSettings *m_settings = nullptr;
-	int m_retryAttempt = 0;
-	QStringList m_chunks;
-	int m_currentChunkIndex = -1;
-	QString m_aggregatedText;
-    bool m_forceAutoDetect = false;
+
+    // One per entry of m_chunks
+    struct Chunk {
+        QNetworkReply *reply = nullptr;   // While in flight
+        int attempts = 0;                 // Retries so far
+        bool forceAutoDetect = false;
+        bool done = false;
+        QStringList translations;         // One per text of the chunk, once done
+    };
+	QVector<QStringList> m_chunks;
+    QVector<Chunk> m_chunkState;
+    int m_nextChunk = 0;      // First chunk not sent yet
+    int m_inFlight = 0;       // Slots held, by chunks sent or waiting to retry
+    int m_chunksDone = 0;
+    int m_generation = 0;     // Replies and retries of an older translation are dropped
+
+    // Sentence/line segments of m_currentText and the whitespace between them, in order
+    struct Piece {
+        QString text;
+        bool segment = false;   // Translated; otherwise copied through as it is
+    };
+    bool m_segmented = false;                       // Chunks hold missing segments, one per q field
+    QVector<Piece> m_pieces;
+    QHash<QString, QString> m_segmentTranslations;  // Segment -> translation, cached and fetched
+    QStringList m_givenSegments;                    // Texts passed to translateSegments(); empty for translate()
+    QStringList m_offlineSegments;                  // Sent with m_offlineRequest
+    int m_offlineRequest = 0;                       // OfflineTranslator request in flight; 0 if none
 
 	static const int TIMEOUT_MS = 30000; // 30 seconds timeout
 	static const int MAX_RETRIES = 2;    // retry count per chunk
-	static const int BACKOFF_BASE_MS = 800; // exponential backoff base
-	static const int CHUNK_CHAR_LIMIT = 4800; // prefer one request; stay under common 5k limit
+	static const int BACKOFF_BASE_MS = 250; // exponential backoff base; other chunks carry on meanwhile
+	static const int MAX_IN_FLIGHT = 4;  // concurrent chunk requests, multiplexed over one HTTP/2 connection
+	static const int CHUNK_CHAR_LIMIT = 4800; // characters per request, all q fields together; stay under common 5k limit
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "EdgeTTSProvider.h"
+#include "../system/CapabilityRegistry.h"
 
 #include <QBuffer>
 #include <QCoreApplication>
@@ -21,11 +22,6 @@ static QDateTime s_cacheTimestamp;
 static QMutex s_cacheMutex;
 static const int CACHE_HOURS = 24; // Cache voices for 24 hours
 
-// Static availability check - persists across instances
-static bool s_edgeTtsChecked = false;
-static bool s_edgeTtsAvailable = false;
-static QString s_edgeTtsExecutable;  // Cache the executable path too
-
 EdgeTTSProvider::EdgeTTSProvider(QObject* parent)
     : TTSProvider(parent)
 {
@@ -33,44 +29,9 @@ EdgeTTSProvider::EdgeTTSProvider(QObject* parent)
     m_audio = new QAudioOutput(this);
     m_player->setAudioOutput(m_audio);
 
-    // Try to auto-detect edge-tts command (check only once, cache result)
-    if (!s_edgeTtsChecked) {
-        QStringList candidatePaths;
-
-#ifdef Q_OS_WIN
-        // 1. Bundled edge-tts.exe in application directory (from CMake build)
-        candidatePaths << QCoreApplication::applicationDirPath() + "\\edge-tts.exe";
-        // 2. Legacy path (edge-tts subdirectory, for backwards compatibility)
-        candidatePaths << QCoreApplication::applicationDirPath() + "\\edge-tts\\edge-tts.exe";
-#endif
-        // 3. System-installed edge-tts (from pip, cross-platform)
-        candidatePaths << "edge-tts";
-
-        for (const QString& edgePath : candidatePaths) {
-            QProcess testProcess;
-            testProcess.start(edgePath, QStringList() << "--list-voices");
-            if (testProcess.waitForFinished(5000)) {
-                QString output = testProcess.readAllStandardOutput();
-                // If we get voice list output, edge-tts is installed
-                if (!output.isEmpty() && output.contains("Name")) {
-                    s_edgeTtsAvailable = true;
-                    s_edgeTtsExecutable = edgePath;
-                    qDebug() << "EdgeTTSProvider: Found edge-tts at:" << edgePath;
-                    break;
-                }
-            }
-        }
-
-        if (s_edgeTtsExecutable.isEmpty()) {
-            s_edgeTtsAvailable = false;
-            qDebug() << "EdgeTTSProvider: edge-tts not found (checked bundled and system PATH)";
-        }
-        s_edgeTtsChecked = true;
-    }
-
-    // Use cached results
-    m_edgeTtsAvailable = s_edgeTtsAvailable;
-    m_executable = s_edgeTtsExecutable;
+    // Resolved once at startup by the capability registry (bundled exe, then PATH)
+    m_executable = CapabilityRegistry::instance().edgeTtsPath();
+    m_edgeTtsAvailable = !m_executable.isEmpty();
     if (m_edgeTtsAvailable) {
         qDebug() << "EdgeTTSProvider: Using cached availability, executable set to:" << m_executable;
     } else {
@@ -272,10 +233,20 @@ void EdgeTTSProvider::speak(const QString& text,
         return;
     }
 
+    // Constructed before the capability probe finished, or edge-tts installed since
+    if (m_executable.isEmpty()) {
+        m_executable = CapabilityRegistry::instance().edgeTtsPath();
+        m_edgeTtsAvailable = !m_executable.isEmpty();
+    }
+
     qDebug() << "EdgeTTSProvider::speak() - m_executable:" << m_executable << "m_edgeTtsAvailable:" << m_edgeTtsAvailable;
 
     if (m_executable.isEmpty() || !m_edgeTtsAvailable) {
         qDebug() << "EdgeTTSProvider::speak() - FAILING availability check!";
+        if (!CapabilityRegistry::instance().isReady()) {
+            emit errorOccurred(tr("Still looking for Edge TTS, try again in a moment."));
+            return;
+        }
         emit errorOccurred(tr("Edge TTS not installed. Install with: pip install edge-tts"));
         return;
     }
@@ -427,7 +398,7 @@ QStringList EdgeTTSProvider::getAllAvailableVoices(bool forceRefresh)
 
     QStringList voices;
     QProcess process;
-    process.start(s_edgeTtsExecutable, QStringList() << "--list-voices");
+    process.start(CapabilityRegistry::instance().edgeTtsPath(), QStringList() << "--list-voices");
 
     if (!process.waitForFinished(10000)) { // 10 second timeout
         qDebug() << "EdgeTTSProvider: Failed to get voice list from edge-tts";
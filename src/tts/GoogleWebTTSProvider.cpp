@@ -1,4 +1,5 @@
 #include "GoogleWebTTSProvider.h"
+#include "NetworkService.h"
 
 #include <QBuffer>
 #include <QTemporaryFile>
@@ -20,6 +21,7 @@ static QStringList s_googleCachedVoices;
 static QDateTime s_googleCacheTimestamp;
 static QMutex s_googleCacheMutex;
 static const int GOOGLE_CACHE_HOURS = 24; // Cache voices for 24 hours
+static const QString GOOGLE_TTS_HOST = QStringLiteral("translate.googleapis.com");
 
 GoogleWebTTSProvider::GoogleWebTTSProvider(QObject* parent)
     : TTSProvider(parent)
@@ -156,7 +158,7 @@ void GoogleWebTTSProvider::speak(const QString& text,
     const double speakingRate = qBound(0.25, 1.0 + rate, 4.0);
     const QString rateParam = QString::number(speakingRate, 'f', 2);
 
-    QUrl url(QStringLiteral("https://translate.googleapis.com/translate_tts"));
+    QUrl url(QStringLiteral("https://") + GOOGLE_TTS_HOST + QStringLiteral("/translate_tts"));
     QUrlQuery query;
     query.addQueryItem(QStringLiteral("ie"), QStringLiteral("UTF-8"));
     query.addQueryItem(QStringLiteral("client"), QStringLiteral("tw-ob"));
@@ -168,7 +170,8 @@ void GoogleWebTTSProvider::speak(const QString& text,
     QNetworkRequest request(url);
     request.setRawHeader("User-Agent", "Mozilla/5.0 (X11; Linux) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/122 Safari/537.36");
 
-    QNetworkReply* reply = m_nam.get(request);
+    // Shared with translation, so speech right after a translation finds the connection open
+    QNetworkReply* reply = NetworkService::manager()->get(request);
 
     connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         if (reply->error() != QNetworkReply::NoError) {
@@ -477,3 +480,8 @@ bool GoogleWebTTSProvider::isVoiceCacheValid()
     qint64 hoursOld = s_googleCacheTimestamp.secsTo(QDateTime::currentDateTime()) / 3600;
     return hoursOld < GOOGLE_CACHE_HOURS;
 }
+
+void GoogleWebTTSProvider::prewarm()
+{
+    NetworkService::prewarm(GOOGLE_TTS_HOST);
+}
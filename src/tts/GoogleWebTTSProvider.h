@@ -1,6 +1,5 @@
 #pragma once
 
-#include <QNetworkAccessManager>
 #include <QAudioOutput>
 #include <QMediaPlayer>
 
@@ -32,11 +31,13 @@ public:
     static void clearVoiceCache();
     static bool isVoiceCacheValid();
 
+    // Connects to the speech host ahead of the first request
+    static void prewarm();
+
 private:
     QString languageCodeForVoice(const QString& voice) const;
     QString languageCodeForLocale(const QLocale& locale) const;
 
-    QNetworkAccessManager m_nam;
     QMediaPlayer* m_player { nullptr };
     QAudioOutput* m_audio { nullptr };
     QString m_voice;
@@ -3,6 +3,17 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QLocale>
+#include <QThread>
+
+int AppSettings::defaultOCRWorkerCount()
+{
+    return qMax(1, QThread::idealThreadCount());
+}
+
+int AppSettings::defaultOfflineThreads()
+{
+    return qMax(1, QThread::idealThreadCount() / 2);
+}
 
 QString AppSettings::getSystemDefaultLanguage()
 {
@@ -65,6 +76,9 @@ AppSettings::OCRConfig AppSettings::getOCRConfig() const
         m_cachedOCRConfig.qualityLevel = m_settings->value("ocr/quality", 3).toInt();
         m_cachedOCRConfig.preprocessing = m_settings->value("ocr/preprocessing", true).toBool();
         m_cachedOCRConfig.autoDetectOrientation = m_settings->value("ocr/autoDetect", true).toBool();
+        m_cachedOCRConfig.tableMode = m_settings->value("ocr/tableMode", false).toBool();
+        m_cachedOCRConfig.workerCount = m_settings->value("ocr/workerCount", defaultOCRWorkerCount()).toInt();
+        m_cachedOCRConfig.liveIntervalMs = m_settings->value("ocr/liveIntervalMs", 500).toInt();
         m_ocrCacheValid = true;
     }
     return m_cachedOCRConfig;
@@ -77,6 +91,9 @@ void AppSettings::setOCRConfig(const OCRConfig& config)
     m_settings->setValue("ocr/quality", config.qualityLevel);
     m_settings->setValue("ocr/preprocessing", config.preprocessing);
     m_settings->setValue("ocr/autoDetect", config.autoDetectOrientation);
+    m_settings->setValue("ocr/tableMode", config.tableMode);
+    m_settings->setValue("ocr/workerCount", config.workerCount);
+    m_settings->setValue("ocr/liveIntervalMs", config.liveIntervalMs);
 
     m_cachedOCRConfig = config;
     m_ocrCacheValid = true;
@@ -105,6 +122,9 @@ AppSettings::TranslationConfig AppSettings::getTranslationConfig() const
         m_cachedTranslationConfig.targetLanguage = m_settings->value("translation/targetLanguage", defaultTarget).toString();
 
         m_cachedTranslationConfig.overlayMode = m_settings->value("translation/overlayMode", "Deep Learning Mode").toString();
+        m_cachedTranslationConfig.cacheMaxMB = m_settings->value("translation/cacheMaxMB", 16).toInt();
+        m_cachedTranslationConfig.offlineThreads = m_settings->value("translation/offlineThreads", defaultOfflineThreads()).toInt();
+        m_cachedTranslationConfig.offlineMemoryMB = m_settings->value("translation/offlineMemoryMB", 512).toInt();
         m_translationCacheValid = true;
     }
     return m_cachedTranslationConfig;
@@ -117,6 +137,9 @@ void AppSettings::setTranslationConfig(const TranslationConfig& config)
     m_settings->setValue("translation/sourceLanguage", config.sourceLanguage);
     m_settings->setValue("translation/targetLanguage", config.targetLanguage);
     m_settings->setValue("translation/overlayMode", config.overlayMode);
+    m_settings->setValue("translation/cacheMaxMB", config.cacheMaxMB);
+    m_settings->setValue("translation/offlineThreads", config.offlineThreads);
+    m_settings->setValue("translation/offlineMemoryMB", config.offlineMemoryMB);
 
     m_cachedTranslationConfig = config;
     m_translationCacheValid = true;
@@ -221,6 +244,53 @@ void AppSettings::setGlobalConfig(const GlobalConfig& config)
     emit settingsChanged();
 }
 
+// === Saved Regions ===
+
+QVector<AppSettings::SavedRegion> AppSettings::getSavedRegions() const
+{
+    QVector<SavedRegion> regions;
+    const int count = m_settings->beginReadArray("savedRegions");
+    for (int i = 0; i < count; ++i) {
+        m_settings->setArrayIndex(i);
+        SavedRegion region;
+        region.screen = m_settings->value("screen").toString();
+        region.rect = m_settings->value("rect").toRect();
+        region.shortcut = m_settings->value("shortcut").toString();
+        region.calibrated = m_settings->value("calibrated", false).toBool();
+        region.language = m_settings->value("language").toString();
+        region.preprocessing = m_settings->value("preprocessing", true).toBool();
+        region.autoDetectOrientation = m_settings->value("autoDetect", false).toBool();
+        region.scale = m_settings->value("scale", 1).toInt();
+        region.psm = m_settings->value("psm", 0).toInt();
+        regions.append(region);
+    }
+    m_settings->endArray();
+    return regions;
+}
+
+void AppSettings::setSavedRegions(const QVector<SavedRegion>& regions)
+{
+    m_settings->remove("savedRegions");
+    m_settings->beginWriteArray("savedRegions", regions.size());
+    for (int i = 0; i < regions.size(); ++i) {
+        const SavedRegion& region = regions[i];
+        m_settings->setArrayIndex(i);
+        m_settings->setValue("screen", region.screen);
+        m_settings->setValue("rect", region.rect);
+        m_settings->setValue("shortcut", region.shortcut);
+        m_settings->setValue("calibrated", region.calibrated);
+        m_settings->setValue("language", region.language);
+        m_settings->setValue("preprocessing", region.preprocessing);
+        m_settings->setValue("autoDetect", region.autoDetectOrientation);
+        m_settings->setValue("scale", region.scale);
+        m_settings->setValue("psm", region.psm);
+    }
+    m_settings->endArray();
+
+    emit savedRegionsChanged();
+    emit settingsChanged();
+}
+
 // === Direct Accessors ===
 
 QString AppSettings::ocrEngine() const
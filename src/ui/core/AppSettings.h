@@ -6,6 +6,8 @@
 #include <QSize>
 #include <QPoint>
 #include <QColor>
+#include <QRect>
+#include <QVector>
 
 /**
  * Centralized Settings Manager
@@ -19,6 +21,8 @@ class AppSettings : public QObject
 public:
     static AppSettings& instance();
     static QString getSystemDefaultLanguage();
+    static int defaultOCRWorkerCount();  // One per core
+    static int defaultOfflineThreads();  // Half the cores
 
     // === OCR Settings ===
     struct OCRConfig {
@@ -27,6 +31,9 @@ public:
         int qualityLevel = 3;
         bool preprocessing = true;
         bool autoDetectOrientation = true;
+        bool tableMode = false;  // Detect table grids and recognise cells separately
+        int workerCount = defaultOCRWorkerCount();  // OCR worker processes (0 = in-process)
+        int liveIntervalMs = 500; // Live region translation: how often the pinned region is re-captured
     };
 
     OCRConfig getOCRConfig() const;
@@ -39,6 +46,9 @@ public:
         QString sourceLanguage; // Dynamically set from OCR language
         QString targetLanguage; // Dynamically set from system locale or user preference
         QString overlayMode = "Deep Learning Mode";
+        int cacheMaxMB = 16;     // On-disk translation cache (TranslationCache) size cap; 0 = memory only
+        int offlineThreads = defaultOfflineThreads();  // CPU threads per offline model
+        int offlineMemoryMB = 512;  // Offline models kept loaded, least recently used unloaded first
     };
 
     TranslationConfig getTranslationConfig() const;
@@ -81,6 +91,24 @@ public:
     GlobalConfig getGlobalConfig() const;
     void setGlobalConfig(const GlobalConfig& config);
 
+    // === Saved Regions ===
+    // A screen region re-read on its own global hotkey (SavedRegionReader)
+    struct SavedRegion {
+        QString screen;                     // QScreen::name() of the screen rect is on
+        QRect rect;                         // Screen-local, logical
+        QString shortcut;                   // QKeySequence text
+        // Pipeline choices made on the first read, reused by every later one
+        bool calibrated = false;
+        QString language;
+        bool preprocessing = true;
+        bool autoDetectOrientation = false;
+        int scale = 1;                      // Upscale factor before recognition
+        int psm = 0;                        // 0 = the quality level's PSM
+    };
+
+    QVector<SavedRegion> getSavedRegions() const;
+    void setSavedRegions(const QVector<SavedRegion>& regions);
+
     // Direct accessors for commonly used settings
     QString ocrEngine() const;
     void setOCREngine(const QString& engine);
@@ -109,6 +137,7 @@ signals:
     void translationSettingsChanged();
     void uiSettingsChanged();
     void ttsSettingsChanged();
+    void savedRegionsChanged();
 
 private:
     explicit AppSettings(QObject* parent = nullptr);
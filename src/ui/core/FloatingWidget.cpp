@@ -1,10 +1,16 @@
 #include "FloatingWidget.h"
 #include "GlobalShortcutManager.h"
 #include "../screenshot/ScreenshotWidget.h"
+#include "../screenshot/CaptureSession.h"
+#include "../overlays/SavedRegionReader.h"
+#include "AppSettings.h"
 #include "ScreenCapture.h"
+#include "ImageFrame.h"
 #include "ModernSettingsWindow.h"
 #include "ThemeManager.h"
 #include "ThemeColors.h"
+#include "TranslationEngine.h"
+#include "GoogleWebTTSProvider.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QHBoxLayout>
@@ -27,6 +33,11 @@
 #include <QProcess>
 #endif
 
+namespace {
+constexpr int UNMAP_TIMEOUT_MS = 100;     // Platforms that never report the unmap still capture after this
+constexpr int COMPOSITOR_FRAME_MS = 16;
+}
+
 FloatingWidget::FloatingWidget(QWidget *parent)
     : QWidget(parent), isDragging(false), currentScale(1.0), currentOpacity(200)
 {
@@ -34,6 +45,11 @@ FloatingWidget::FloatingWidget(QWidget *parent)
     setupUI();
     applyModernStyle();
 
+    prepareNativeWindow();
+
+    // Build the selection overlay now so the hotkey only has to capture
+    QTimer::singleShot(0, this, &CaptureSession::prewarm);
+
     // Connect to theme changes for runtime updates
     connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, [this](ThemeManager::Theme theme) {
         qDebug() << "FloatingWidget: Received theme change signal, new theme:" << ThemeManager::toString(theme);
@@ -62,6 +78,17 @@ FloatingWidget::FloatingWidget(QWidget *parent)
             this, &FloatingWidget::takeScreenshot);
     connect(shortcutManager, &GlobalShortcutManager::toggleVisibilityRequested,
             this, &FloatingWidget::toggleVisibility);
+    connect(shortcutManager, &GlobalShortcutManager::regionRequested, this, &SavedRegionReader::read);
+    // Every saved region has its own hotkey; saving or forgetting one re-registers them
+    auto registerRegionShortcuts = [this]() {
+        QStringList shortcuts;
+        for (const AppSettings::SavedRegion &region : AppSettings::instance().getSavedRegions()) {
+            shortcuts << region.shortcut;
+        }
+        shortcutManager->setRegionShortcuts(shortcuts);
+    };
+    registerRegionShortcuts();
+    connect(&AppSettings::instance(), &AppSettings::savedRegionsChanged, this, registerRegionShortcuts);
     qDebug() << "Global shortcut manager initialized";
 
     // Setup local server for single instance support
@@ -358,123 +385,173 @@ void FloatingWidget::animateHover(bool hover)
 
 void FloatingWidget::takeScreenshot()
 {
+    if (waitingForUnmap) {
+        return;
+    }
     qDebug() << "Taking screenshot using ScreenCapture!";
 
+    // TLS handshakes run while the user selects and OCR runs, not in front of the first request
+    const AppSettings::TranslationConfig translationConfig = AppSettings::instance().getTranslationConfig();
+    if (translationConfig.autoTranslate
+        && TranslationEngine::engineForName(translationConfig.engine) == TranslationEngine::GoogleTranslate) {
+        TranslationEngine::prewarm();
+    }
+    if (AppSettings::instance().getTTSConfig().engine.contains("Google")) {
+        GoogleWebTTSProvider::prewarm();
+    }
+
     // Remember if widget was visible before hiding
     wasVisibleBeforeScreenshot = isVisible();
     qDebug() << "Widget was visible before screenshot:" << wasVisibleBeforeScreenshot;
 
-    // Hide widget immediately and take screenshot
-    hide();
-
-    // Wait a moment for widget to hide completely
-    QTimer::singleShot(100, [this]() {
-        qDebug() << "Capturing screen with cross-platform ScreenCapture...";
-
-        // Use the new ScreenCapture class for real cross-platform capture
-        ScreenCapture *capture = new ScreenCapture(this);
-        QPixmap screenshot = capture->captureScreen();
-        capture->deleteLater();
-
-        qDebug() << "Screenshot capture completed, size:" << screenshot.size();
-
-        // If still no screenshot after all methods, create demo pattern
-        if (screenshot.isNull()) {
-            qDebug() << "Screenshot capture failed, creating demo pattern as fallback";
-            // Create a realistic demo pattern
-            QScreen *screen = QApplication::primaryScreen();
-            if (!screen) {
-                qWarning() << "No primary screen found!";
-                show();
-                return;
-            }
-            QRect screenRect = screen->geometry();
-            screenshot = QPixmap(screenRect.size());
-
-            // Create a gradient background like a desktop
-            QPainter painter(&screenshot);
-            QLinearGradient gradient(0, 0, 0, screenRect.height());
-            gradient.setColorAt(0, QColor(135, 206, 235)); // Sky blue
-            gradient.setColorAt(1, QColor(25, 25, 112));   // Midnight blue
-            painter.fillRect(screenshot.rect(), gradient);
-
-            // Add some "windows" to make it look realistic
-            painter.fillRect(100, 100, 400, 300, QColor(240, 240, 240, 230));
-            painter.setPen(QPen(Qt::darkGray, 2));
-            painter.drawRect(100, 100, 400, 300);
-
-            painter.fillRect(600, 200, 300, 200, QColor(255, 255, 255, 230));
-            painter.drawRect(600, 200, 300, 200);
-
-            // Add title bars
-            painter.fillRect(100, 100, 400, 30, QColor(70, 130, 180));
-            painter.fillRect(600, 200, 300, 30, QColor(70, 130, 180));
-
-            // Add instructional text
-            painter.setPen(Qt::white);
-            painter.setFont(QFont("Arial", 16, QFont::Bold));
-            painter.drawText(screenRect, Qt::AlignCenter,
-                            "OHAO Screenshot Tool - Demo Mode\n\n"
-                            "Click and drag to select any area\n"
-                            "Screenshot capture restricted by Wayland security");
-
-            painter.setPen(Qt::yellow);
-            painter.setFont(QFont("Arial", 12));
-            painter.drawText(20, screenRect.height() - 40,
-                            "Note: Real screenshot requires special permissions on Wayland");
-
-            qDebug() << "Created Wayland demo screenshot:" << screenshot.size();
-        }
+    // Nothing to wait for when we're already off screen or left out of captures by the window system
+    if (!wasVisibleBeforeScreenshot || excludedFromCapture) {
+        hide();
+        startCapture();
+        return;
+    }
 
-        if (screenshot.isNull()) {
-            qWarning() << "All screenshot methods failed!";
-            show(); // Show widget back
-            return;
+    // Capture once the window system reports the widget unmapped (see eventFilter)
+    waitingForUnmap = true;
+    hide();
+    QTimer::singleShot(UNMAP_TIMEOUT_MS, this, [this]() {
+        if (waitingForUnmap) {
+            qDebug() << "No unmap notification - capturing anyway";
+            waitingForUnmap = false;
+            startCapture();
         }
+    });
+}
 
-        qDebug() << "Screenshot captured successfully:" << screenshot.size();
-
-        // Now create screenshot widget with the captured image
-        ScreenshotWidget *screenshotWidget = new ScreenshotWidget(screenshot);
-
-        if (screenshotWidget) {
-            qDebug() << "Screenshot widget created with image, showing...";
-            screenshotWidget->show();
-            screenshotWidget->raise();
-            screenshotWidget->activateWindow();
+bool FloatingWidget::eventFilter(QObject *watched, QEvent *event)
+{
+    // The platform sends an expose event with nothing exposed once the window is really unmapped
+    if (waitingForUnmap && watched == windowHandle() && event->type() == QEvent::Expose
+        && !windowHandle()->isExposed()) {
+        waitingForUnmap = false;
+        // Compositors repaint the uncovered area on their next frame
+        QTimer::singleShot(COMPOSITOR_FRAME_MS, this, &FloatingWidget::startCapture);
+    }
+    return QWidget::eventFilter(watched, event);
+}
 
-            // Show this widget again after screenshot closes (only if it was visible before)
-            connect(screenshotWidget, &ScreenshotWidget::screenshotFinished, [this]() {
-                qDebug() << "Screenshot finished signal received";
-                // Only show widget if it was visible before screenshot
-                if (wasVisibleBeforeScreenshot) {
-                    qDebug() << "Restoring widget visibility";
-                    show();
-                    raise();
-                    activateWindow();
-                } else {
-                    qDebug() << "Widget was hidden before screenshot, keeping it hidden";
-                }
-            });
+void FloatingWidget::prepareNativeWindow()
+{
+    // Both belong to the native window, which changing the window flags recreates.
+    // Where the window system can leave us out of captures, a screenshot needn't wait for us to hide
+    excludedFromCapture = ScreenCapture::excludeFromCapture(winId());
+    windowHandle()->installEventFilter(this);
+}
 
-            // Keep destroyed as backup
-            connect(screenshotWidget, &QWidget::destroyed, [this]() {
-                qDebug() << "Screenshot widget destroyed (backup signal)";
-                // Only show widget if it was visible before screenshot
-                if (wasVisibleBeforeScreenshot) {
-                    qDebug() << "Restoring widget visibility";
-                    show();
-                    raise();
-                    activateWindow();
-                } else {
-                    qDebug() << "Widget was hidden before screenshot, keeping it hidden";
-                }
-            });
+void FloatingWidget::startCapture()
+{
+    qDebug() << "Capturing screen with cross-platform ScreenCapture...";
+
+    // One overlay per monitor: the cursor's screen now, the others when the cursor reaches them
+    CaptureSession *session = new CaptureSession(this);
+    connect(session, &CaptureSession::finished, this, [this, session]() {
+        qDebug() << "Screenshot session finished";
+        session->deleteLater();
+        // Only show widget if it was visible before screenshot
+        if (wasVisibleBeforeScreenshot) {
+            qDebug() << "Restoring widget visibility";
+            show();
+            raise();
+            activateWindow();
         } else {
-            qWarning() << "Failed to create screenshot widget!";
-            show(); // Show widget back if screenshot creation failed
+            qDebug() << "Widget was hidden before screenshot, keeping it hidden";
         }
     });
+    if (session->start()) {
+        return;
+    }
+    session->deleteLater();
+
+    // No screen could be captured (e.g. Wayland without a portal): this path always shows
+    // a demo pattern to select on, so the overlay itself can still be tried out
+    QScreen *screen = ScreenCapture::screenUnderCursor();
+    if (!screen) {
+        qWarning() << "No primary screen found!";
+        show();
+        return;
+    }
+    qDebug() << "Screenshot capture failed, showing the demo pattern";
+    QRect screenRect = screen->geometry();
+    QImage screenshot(screenRect.size(), ImageFrame::FORMAT);
+
+    // Create a gradient background like a desktop
+    QPainter painter(&screenshot);
+    QLinearGradient gradient(0, 0, 0, screenRect.height());
+    gradient.setColorAt(0, QColor(135, 206, 235)); // Sky blue
+    gradient.setColorAt(1, QColor(25, 25, 112));   // Midnight blue
+    painter.fillRect(screenshot.rect(), gradient);
+
+    // Add some "windows" to make it look realistic
+    painter.fillRect(100, 100, 400, 300, QColor(240, 240, 240, 230));
+    painter.setPen(QPen(Qt::darkGray, 2));
+    painter.drawRect(100, 100, 400, 300);
+
+    painter.fillRect(600, 200, 300, 200, QColor(255, 255, 255, 230));
+    painter.drawRect(600, 200, 300, 200);
+
+    // Add title bars
+    painter.fillRect(100, 100, 400, 30, QColor(70, 130, 180));
+    painter.fillRect(600, 200, 300, 30, QColor(70, 130, 180));
+
+    // Add instructional text
+    painter.setPen(Qt::white);
+    painter.setFont(QFont("Arial", 16, QFont::Bold));
+    painter.drawText(screenRect, Qt::AlignCenter,
+                    "OHAO Screenshot Tool - Demo Mode\n\n"
+                    "Click and drag to select any area\n"
+                    "Screenshot capture restricted by Wayland security");
+
+    painter.setPen(Qt::yellow);
+    painter.setFont(QFont("Arial", 12));
+    painter.drawText(20, screenRect.height() - 40,
+                    "Note: Real screenshot requires special permissions on Wayland");
+    painter.end();
+
+    // Now create screenshot widget with the captured image
+    ScreenshotWidget *screenshotWidget = new ScreenshotWidget(screenshot, screen);
+
+    if (screenshotWidget) {
+        qDebug() << "Screenshot widget created with image, showing...";
+        screenshotWidget->show();
+        screenshotWidget->raise();
+        screenshotWidget->activateWindow();
+
+        // Show this widget again after screenshot closes (only if it was visible before)
+        connect(screenshotWidget, &ScreenshotWidget::screenshotFinished, [this]() {
+            qDebug() << "Screenshot finished signal received";
+            // Only show widget if it was visible before screenshot
+            if (wasVisibleBeforeScreenshot) {
+                qDebug() << "Restoring widget visibility";
+                show();
+                raise();
+                activateWindow();
+            } else {
+                qDebug() << "Widget was hidden before screenshot, keeping it hidden";
+            }
+        });
+
+        // Keep destroyed as backup
+        connect(screenshotWidget, &QWidget::destroyed, [this]() {
+            qDebug() << "Screenshot widget destroyed (backup signal)";
+            // Only show widget if it was visible before screenshot
+            if (wasVisibleBeforeScreenshot) {
+                qDebug() << "Restoring widget visibility";
+                show();
+                raise();
+                activateWindow();
+            } else {
+                qDebug() << "Widget was hidden before screenshot, keeping it hidden";
+            }
+        });
+    } else {
+        qWarning() << "Failed to create screenshot widget!";
+        show(); // Show widget back if screenshot creation failed
+    }
 }
 
 void FloatingWidget::openSettings()
@@ -511,6 +588,7 @@ void FloatingWidget::setAlwaysOnTop(bool onTop)
     }
     setWindowFlags(flags);
     show();  // Need to show after changing flags
+    prepareNativeWindow();
 
 #ifdef Q_OS_LINUX
     // On Wayland/Linux, Qt's WindowStaysOnTopHint doesn't always work
@@ -575,6 +653,9 @@ void FloatingWidget::handleNewConnection()
             } else if (command == "toggle") {
                 qDebug() << "Toggling visibility via IPC command";
                 toggleVisibility();
+            } else if (command.startsWith("region:")) {
+                qDebug() << "Reading saved region via IPC command";
+                SavedRegionReader::read(command.mid(7).toInt() - 1);
             }
 
             socket->deleteLater();
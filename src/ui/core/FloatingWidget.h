@@ -38,6 +38,7 @@ protected:
     void mouseMoveEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
     void moveEvent(QMoveEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
 
 private slots:
     void animateHover(bool hover);
@@ -46,6 +47,8 @@ private slots:
 private:
     void setupUI();
     void applyModernStyle();
+    void prepareNativeWindow();
+    void startCapture();
 
     QPushButton *screenshotBtn;
     QPushButton *settingsBtn;
@@ -78,6 +81,8 @@ private:
 
     bool screenshotInProgress = false;
     bool wasVisibleBeforeScreenshot = false;
+    bool waitingForUnmap = false;
+    bool excludedFromCapture = false;
 
     // Single instance support
     QLocalServer *localServer = nullptr;
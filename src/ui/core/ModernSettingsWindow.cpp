@@ -9,6 +9,9 @@
 #include "ThemeColors.h"
 #include "FloatingWidget.h"
 #include "LanguageManager.h"
+#include "TranslationEngine.h"
+#include "OfflineTranslator.h"
+#include "CapabilityRegistry.h"
 #include <QApplication>
 #include <QScreen>
 #include <QGroupBox>
@@ -227,6 +230,24 @@ QWidget* ModernSettingsWindow::createGeneralPage()
             this, &ModernSettingsWindow::onSettingChanged);
     shortcutsLayout->addRow("Toggle Widget:", toggleShortcutEdit);
 
+    // Regions saved with Ctrl+drag in the screenshot overlay, each on its own hotkey
+    QWidget *savedRegionsWidget = new QWidget();
+    QHBoxLayout *savedRegionsLayout = new QHBoxLayout(savedRegionsWidget);
+    savedRegionsLayout->setContentsMargins(0, 0, 0, 0);
+    savedRegionsLabel = new QLabel();
+    savedRegionsLabel->setWordWrap(true);
+    QPushButton *forgetRegionsBtn = new QPushButton("Forget All");
+    forgetRegionsBtn->setToolTip("Remove every saved region and release its hotkey");
+    connect(forgetRegionsBtn, &QPushButton::clicked, this, []() {
+        AppSettings::instance().setSavedRegions({});
+    });
+    connect(&AppSettings::instance(), &AppSettings::savedRegionsChanged,
+            this, &ModernSettingsWindow::updateSavedRegionsLabel);
+    savedRegionsLayout->addWidget(savedRegionsLabel, 1);
+    savedRegionsLayout->addWidget(forgetRegionsBtn);
+    shortcutsLayout->addRow("Saved Regions:", savedRegionsWidget);
+    updateSavedRegionsLabel();
+
 #ifdef Q_OS_LINUX
     // Add button to update GNOME shortcuts
     QPushButton *updateGnomeBtn = new QPushButton("Update GNOME Shortcuts");
@@ -305,6 +326,46 @@ QWidget* ModernSettingsWindow::createOCRPage()
     engineLayout->addRow("Engine:", ocrEngineCombo);
 
     layout->addWidget(engineGroup);
+
+    // Layout group
+    QGroupBox *layoutGroup = new QGroupBox("Layout");
+    layoutGroup->setObjectName("settingsGroup");
+    QVBoxLayout *layoutOptions = new QVBoxLayout(layoutGroup);
+
+    ocrTableModeCheck = new QCheckBox("Table mode (recognise cells, copy as TSV/CSV)");
+    ocrTableModeCheck->setToolTip("Detects table grids and recognises each cell separately (Tesseract only)");
+    ocrTableModeCheck->setStyleSheet("padding: 4px 0px;");
+    connect(ocrTableModeCheck, &QCheckBox::toggled,
+            this, &ModernSettingsWindow::onSettingChanged);
+    layoutOptions->addWidget(ocrTableModeCheck);
+
+    layout->addWidget(layoutGroup);
+
+    // Performance group
+    QGroupBox *performanceGroup = new QGroupBox("Performance");
+    performanceGroup->setObjectName("settingsGroup");
+    QFormLayout *performanceLayout = new QFormLayout(performanceGroup);
+    performanceLayout->setSpacing(12);
+    performanceLayout->setContentsMargins(0, 0, 0, 0);
+
+    ocrWorkerCountSpin = new QSpinBox();
+    ocrWorkerCountSpin->setRange(0, 64);
+    ocrWorkerCountSpin->setSpecialValueText("Off (in-process)");
+    ocrWorkerCountSpin->setToolTip("Background OCR processes kept warm between captures (Tesseract only)");
+    connect(ocrWorkerCountSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &ModernSettingsWindow::onSettingChanged);
+    performanceLayout->addRow("Worker processes:", ocrWorkerCountSpin);
+
+    ocrLiveIntervalSpin = new QSpinBox();
+    ocrLiveIntervalSpin->setRange(100, 5000);
+    ocrLiveIntervalSpin->setSingleStep(100);
+    ocrLiveIntervalSpin->setSuffix(" ms");
+    ocrLiveIntervalSpin->setToolTip("How often a live region (Shift+drag) is checked for new text");
+    connect(ocrLiveIntervalSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &ModernSettingsWindow::onSettingChanged);
+    performanceLayout->addRow("Live region refresh:", ocrLiveIntervalSpin);
+
+    layout->addWidget(performanceGroup);
     layout->addStretch();
     return page;
 }
@@ -335,7 +396,7 @@ QWidget* ModernSettingsWindow::createTranslationPage()
 
     layout->addWidget(optionsGroup);
 
-    // Engine group - Only Google Translate (free)
+    // Engine group - Google Translate (free), or on-device models when built with CTranslate2
     QGroupBox *engineGroup = new QGroupBox("Translation Engine");
     engineGroup->setObjectName("settingsGroup");
     QFormLayout *engineLayout = new QFormLayout(engineGroup);
@@ -343,8 +404,11 @@ QWidget* ModernSettingsWindow::createTranslationPage()
     engineLayout->setContentsMargins(0, 0, 0, 0);
 
     translationEngineCombo = new QComboBox();
-    translationEngineCombo->addItems({"Google Translate (Free)"});
-    translationEngineCombo->setEnabled(false); // Only one option, disable selection
+    translationEngineCombo->addItem(TranslationEngine::engineName(TranslationEngine::GoogleTranslate));
+    if (OfflineTranslator::isAvailable()) {
+        translationEngineCombo->addItem(TranslationEngine::engineName(TranslationEngine::Offline));
+    }
+    translationEngineCombo->setEnabled(translationEngineCombo->count() > 1);
     connect(translationEngineCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
         if (!isInitializing) {
             saveSettings();
@@ -352,6 +416,35 @@ QWidget* ModernSettingsWindow::createTranslationPage()
     });
     engineLayout->addRow("Engine:", translationEngineCombo);
 
+    translationCacheSpin = new QSpinBox();
+    translationCacheSpin->setRange(0, 1024);
+    translationCacheSpin->setSuffix(" MB");
+    translationCacheSpin->setSpecialValueText("Off (this session only)");
+    translationCacheSpin->setToolTip("Translations kept on disk, so text seen before is translated instantly and offline");
+    connect(translationCacheSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &ModernSettingsWindow::onSettingChanged);
+    engineLayout->addRow("Cache size:", translationCacheSpin);
+
+    if (OfflineTranslator::isAvailable()) {
+        offlineThreadsSpin = new QSpinBox();
+        offlineThreadsSpin->setRange(1, 64);
+        offlineThreadsSpin->setToolTip("CPU threads each offline translation uses");
+        connect(offlineThreadsSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+                this, &ModernSettingsWindow::onSettingChanged);
+        engineLayout->addRow("Offline threads:", offlineThreadsSpin);
+
+        offlineMemorySpin = new QSpinBox();
+        offlineMemorySpin->setRange(0, 16384);
+        offlineMemorySpin->setSingleStep(128);
+        offlineMemorySpin->setSuffix(" MB");
+        offlineMemorySpin->setSpecialValueText("No limit");
+        offlineMemorySpin->setToolTip(QString("Offline models kept loaded; the least recently used are unloaded first.\n"
+                                              "Models go in %1/<source>-<target>").arg(OfflineTranslator::modelsDirectory()));
+        connect(offlineMemorySpin, QOverload<int>::of(&QSpinBox::valueChanged),
+                this, &ModernSettingsWindow::onSettingChanged);
+        engineLayout->addRow("Offline models memory:", offlineMemorySpin);
+    }
+
     // API fields removed - Google Translate doesn't need API key or custom URL
     apiUrlEdit = nullptr;
     apiKeyEdit = nullptr;
@@ -894,6 +987,15 @@ void ModernSettingsWindow::loadSettings()
 #endif
         ocrEngineCombo->setCurrentText(display);
     }
+    if (ocrTableModeCheck) {
+        ocrTableModeCheck->setChecked(AppSettings::instance().getOCRConfig().tableMode);
+    }
+    if (ocrWorkerCountSpin) {
+        ocrWorkerCountSpin->setValue(AppSettings::instance().getOCRConfig().workerCount);
+    }
+    if (ocrLiveIntervalSpin) {
+        ocrLiveIntervalSpin->setValue(AppSettings::instance().getOCRConfig().liveIntervalMs);
+    }
 
     // Translation
     if (autoTranslateCheck) {
@@ -902,6 +1004,15 @@ void ModernSettingsWindow::loadSettings()
     if (translationEngineCombo) {
         translationEngineCombo->setCurrentText(settings.value("translation/engine", "Google Translate (Free)").toString());
     }
+    if (translationCacheSpin) {
+        translationCacheSpin->setValue(AppSettings::instance().getTranslationConfig().cacheMaxMB);
+    }
+    if (offlineThreadsSpin) {
+        offlineThreadsSpin->setValue(AppSettings::instance().getTranslationConfig().offlineThreads);
+    }
+    if (offlineMemorySpin) {
+        offlineMemorySpin->setValue(AppSettings::instance().getTranslationConfig().offlineMemoryMB);
+    }
     if (apiUrlEdit) {
         apiUrlEdit->setText(settings.value("translation/apiUrl", "").toString());
     }
@@ -997,7 +1108,14 @@ void ModernSettingsWindow::saveSettings()
         if (systemTray) systemTray->updateShortcutLabels();
     }
 
-    // OCR
+    // OCR (AppSettings first - it rewrites the whole cached OCR config, engine included)
+    if (ocrTableModeCheck || ocrWorkerCountSpin || ocrLiveIntervalSpin) {
+        auto ocrConfig = AppSettings::instance().getOCRConfig();
+        if (ocrTableModeCheck) ocrConfig.tableMode = ocrTableModeCheck->isChecked();
+        if (ocrWorkerCountSpin) ocrConfig.workerCount = ocrWorkerCountSpin->value();
+        if (ocrLiveIntervalSpin) ocrConfig.liveIntervalMs = ocrLiveIntervalSpin->value();
+        AppSettings::instance().setOCRConfig(ocrConfig);
+    }
     if (ocrEngineCombo) {
         QString text = ocrEngineCombo->currentText();
         QString internalName;
@@ -1006,7 +1124,16 @@ void ModernSettingsWindow::saveSettings()
         settings.setValue("ocr/engine", internalName);
     }
 
-    // Translation
+    // Translation (AppSettings first - it rewrites the whole cached translation config)
+    if (translationCacheSpin) {
+        auto translationConfig = AppSettings::instance().getTranslationConfig();
+        if (autoTranslateCheck) translationConfig.autoTranslate = autoTranslateCheck->isChecked();
+        if (translationEngineCombo) translationConfig.engine = translationEngineCombo->currentText();
+        translationConfig.cacheMaxMB = translationCacheSpin->value();
+        if (offlineThreadsSpin) translationConfig.offlineThreads = offlineThreadsSpin->value();
+        if (offlineMemorySpin) translationConfig.offlineMemoryMB = offlineMemorySpin->value();
+        AppSettings::instance().setTranslationConfig(translationConfig);
+    }
     if (autoTranslateCheck) {
         settings.setValue("translation/autoTranslate", autoTranslateCheck->isChecked());
     }
@@ -1087,6 +1214,22 @@ void ModernSettingsWindow::showEvent(QShowEvent *event)
 {
     QDialog::showEvent(event);
     qDebug() << "ModernSettingsWindow: Window shown";
+    // Tools installed while the app was running (tesseract, edge-tts) are picked up from here on
+    CapabilityRegistry::instance().refresh();
+}
+
+void ModernSettingsWindow::updateSavedRegionsLabel()
+{
+    if (!savedRegionsLabel) {
+        return;
+    }
+    QStringList shortcuts;
+    for (const AppSettings::SavedRegion &region : AppSettings::instance().getSavedRegions()) {
+        shortcuts << QKeySequence(region.shortcut).toString(QKeySequence::NativeText);
+    }
+    savedRegionsLabel->setText(shortcuts.isEmpty()
+        ? QString("None - Ctrl+drag in the screenshot overlay saves one")
+        : shortcuts.join(", "));
 }
 
 void ModernSettingsWindow::updateGnomeShortcuts()
@@ -10,6 +10,7 @@
 #include <QComboBox>
 #include <QCheckBox>
 #include <QSlider>
+#include <QSpinBox>
 #include <QLabel>
 #include <QLineEdit>
 #include <QKeySequenceEdit>
@@ -56,6 +57,7 @@ private:
     void loadSettings();
     void saveSettings();
     void updateGnomeShortcuts();
+    void updateSavedRegionsLabel();
     void updateVoiceList();
 
     // Page creators
@@ -77,13 +79,20 @@ private:
     QLabel *dimmingValueLabel = nullptr;
     QKeySequenceEdit *screenshotShortcutEdit = nullptr;
     QKeySequenceEdit *toggleShortcutEdit = nullptr;
+    QLabel *savedRegionsLabel = nullptr;
 
     // OCR Page widgets
     QComboBox *ocrEngineCombo = nullptr;
+    QCheckBox *ocrTableModeCheck = nullptr;
+    QSpinBox *ocrWorkerCountSpin = nullptr;
+    QSpinBox *ocrLiveIntervalSpin = nullptr;
 
     // Translation Page widgets
     QCheckBox *autoTranslateCheck = nullptr;
     QComboBox *translationEngineCombo = nullptr;
+    QSpinBox *translationCacheSpin = nullptr;
+    QSpinBox *offlineThreadsSpin = nullptr;
+    QSpinBox *offlineMemorySpin = nullptr;
     QLineEdit *apiUrlEdit = nullptr;
     QLineEdit *apiKeyEdit = nullptr;
 
@@ -0,0 +1,495 @@
+#include "LiveRegionTranslator.h"
+#include "QuickTranslationOverlay.h"
+#include "ImageFrame.h"
+#include "TranslationEngine.h"
+#include "../core/AppSettings.h"
+#include "../../ocr/engines/tesseract/TesseractEngine.h"
+#include "../../ocr/preprocessing/Binarize.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <QThread>
+#include <QEvent>
+#include <QDebug>
+#include <algorithm>
+
+#ifdef Q_OS_MACOS
+#include "../../ocr/AppleVisionOCR.h"
+#endif
+
+namespace {
+
+constexpr int TILE_SIZE = 32;
+constexpr int MIN_INTERVAL_MS = 100;
+constexpr int IDLE_TICKS_BEFORE_BACKOFF = 10;  // Quiet polls before the interval starts doubling
+constexpr int MAX_BACKOFF = 4;                 // Longest interval, as a multiple of the configured one
+constexpr int MAX_UNSETTLED_TICKS = 2;         // Moving content (video) is read every this many polls and fused
+constexpr int MAX_FAILED_GRABS = 10;
+constexpr int MERGE_GAP = 2;                   // Blank rows bridged inside one text line (i-dots, accents)
+constexpr int MIN_LINE_HEIGHT = 4;             // Shorter ink bands are noise
+constexpr int LINE_PADDING = 4;                // Quiet margin kept above and below each line
+constexpr int MAX_LINE_HEIGHT = 160;           // Taller bands are OCR'd as a block
+constexpr int MIN_OCR_HEIGHT = 30;             // Shorter strips are upscaled 2x before recognition
+constexpr int SINGLE_LINE_PSM = 7;
+constexpr int MAX_CACHED_LINES = 512;
+constexpr int MAX_CACHED_TRANSLATIONS = 512;
+
+QPointer<LiveRegionTranslator> s_active;
+
+struct Band {
+    int top = 0;
+    int bottom = 0; // exclusive
+};
+
+// Text lines from the row ink profile; ink is whichever Otsu side is rarer, so light-on-dark works too
+QVector<Band> inkBands(const QImage &frame)
+{
+    QVector<Band> bands;
+    const Binarize::BinaryImage bin = Binarize::otsu(frame);
+    if (bin.isEmpty()) {
+        return bands;
+    }
+
+    for (int y = 0; y < bin.height; ++y) {
+        const quint8 *row = bin.row(y);
+        if (std::none_of(row, row + bin.width, [](quint8 bit) { return bit != 0; })) {
+            continue;
+        }
+        if (!bands.isEmpty() && y - bands.last().bottom <= MERGE_GAP) {
+            bands.last().bottom = y + 1;
+        } else {
+            bands.append({ y, y + 1 });
+        }
+    }
+
+    bands.erase(std::remove_if(bands.begin(), bands.end(),
+                               [](const Band &band) { return band.bottom - band.top < MIN_LINE_HEIGHT; }),
+                bands.end());
+    return bands;
+}
+
+QImage prepareLine(const QImage &strip)
+{
+    QImage image = ImageFrame::normalised(strip);
+    if (image.height() < MIN_OCR_HEIGHT) {
+        image = image.scaled(image.size() * 2, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+} // namespace
+
+void LiveRegionTranslator::start(QScreen *screen, const QRect &rect)
+{
+    stopActive();
+    if (!screen || rect.isEmpty()) {
+        return;
+    }
+
+    s_active = new LiveRegionTranslator(screen, rect);
+    s_active->m_timer.start();
+    qDebug() << "LiveRegionTranslator: Live translation of" << rect << "on" << screen->name()
+             << "every" << s_active->m_baseInterval << "ms";
+}
+
+void LiveRegionTranslator::startWindow(quintptr window)
+{
+    stopActive();
+
+    LiveRegionTranslator *translator = new LiveRegionTranslator(nullptr, QRect());
+    if (!translator->m_capture.selectWindow(window) || !translator->followWindow()) {
+        qWarning() << "LiveRegionTranslator: Window" << window << "can't be followed";
+        delete translator;
+        return;
+    }
+    translator->m_window = window;
+
+    s_active = translator;
+    s_active->m_timer.start();
+    qDebug() << "LiveRegionTranslator: Live translation of window" << window << "at" << translator->m_rect
+             << "every" << translator->m_baseInterval << "ms";
+}
+
+void LiveRegionTranslator::stopActive()
+{
+    if (s_active) {
+        s_active->stop();
+    }
+}
+
+LiveRegionTranslator::LiveRegionTranslator(QScreen *screen, const QRect &rect)
+    : QObject(nullptr)
+    , m_screen(screen)
+    , m_rect(rect)
+{
+    m_baseInterval = qMax(MIN_INTERVAL_MS, AppSettings::instance().getOCRConfig().liveIntervalMs);
+    m_pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount()));
+
+    m_overlay = new QuickTranslationOverlay(nullptr);
+    m_overlay->setAttribute(Qt::WA_DeleteOnClose, false);
+    // The game or video keeps keyboard focus while the overlay updates
+    m_overlay->setAttribute(Qt::WA_ShowWithoutActivating, true);
+    m_overlay->installEventFilter(this);
+    connect(&AppSettings::instance(), &AppSettings::uiSettingsChanged,
+            m_overlay, &QuickTranslationOverlay::updateThemeColors);
+
+    connect(qGuiApp, &QGuiApplication::screenRemoved, this, [this](QScreen *screen) {
+        // A followed window is placed on whatever screen it is on at the next poll
+        if (screen == m_screen && !m_window) {
+            stop();
+        }
+    });
+
+    m_timer.setInterval(m_baseInterval);
+    connect(&m_timer, &QTimer::timeout, this, &LiveRegionTranslator::tick);
+}
+
+LiveRegionTranslator::~LiveRegionTranslator()
+{
+    // Line jobs post back to this object; let them drain before it goes away
+    m_pool.clear();
+    m_pool.waitForDone();
+    delete m_overlay;
+}
+
+void LiveRegionTranslator::stop()
+{
+    if (m_stopped) {
+        return;
+    }
+    m_stopped = true;
+    m_timer.stop();
+    m_translationQueue.clear();
+
+    m_updatingOverlay = true;
+    m_overlay->hide();
+    m_updatingOverlay = false;
+
+    if (s_active == this) {
+        s_active = nullptr;
+    }
+    qDebug() << "LiveRegionTranslator: Live translation stopped";
+    deleteLater();
+}
+
+bool LiveRegionTranslator::eventFilter(QObject *watched, QEvent *event)
+{
+    // Clicking the overlay (or Esc while it has focus) hides it - that ends live mode
+    if (watched == m_overlay && event->type() == QEvent::Hide && !m_updatingOverlay) {
+        stop();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void LiveRegionTranslator::tick()
+{
+    if (m_busy || m_stopped || (!m_screen && !m_window)) {
+        return;
+    }
+    m_busy = true;
+
+    const QImage frame = m_window ? m_capture.captureWindow() : m_capture.captureRegion(m_screen, m_rect);
+    if (frame.isNull() || (m_window && !followWindow())) {
+        m_busy = false;
+        if (++m_failedGrabs == MAX_FAILED_GRABS) {
+            qWarning() << "LiveRegionTranslator: Region capture keeps failing, stopping";
+            stop();
+        }
+        return;
+    }
+    m_failedGrabs = 0;
+
+    const TileHash::Grid grid = TileHash::compute(frame, TILE_SIZE);
+    if (grid == m_recognisedGrid) {
+        // Nothing new on screen; once it has been quiet for a while, poll less often
+        m_previousGrid = grid;
+        m_unsettledTicks = 0;
+        if (++m_idleTicks >= IDLE_TICKS_BEFORE_BACKOFF && m_timer.interval() < m_baseInterval * MAX_BACKOFF) {
+            m_timer.setInterval(qMin(m_timer.interval() * 2, m_baseInterval * MAX_BACKOFF));
+        }
+        m_busy = false;
+        return;
+    }
+
+    m_idleTicks = 0;
+    if (m_timer.interval() != m_baseInterval) {
+        m_timer.setInterval(m_baseInterval);
+    }
+
+    // Wait a poll for typing, fades and scrolling to settle; content that never settles (video) is read anyway
+    const bool settled = grid == m_previousGrid || m_recognisedGrid.isEmpty();
+    m_previousGrid = grid;
+    if (!settled && ++m_unsettledTicks < MAX_UNSETTLED_TICKS) {
+        m_busy = false;
+        return;
+    }
+    m_unsettledTicks = 0;
+
+    recognise(frame, grid, settled);
+}
+
+bool LiveRegionTranslator::followWindow()
+{
+    // The overlay stays beside the window as it moves
+    const QRect geometry = m_capture.selectedWindowGeometry();
+    if (geometry.isEmpty()) {
+        return false;
+    }
+    QScreen *screen = QGuiApplication::screenAt(geometry.center());
+    if (!screen) {
+        screen = m_screen ? m_screen.data() : QGuiApplication::primaryScreen();
+    }
+    m_screen = screen;
+    m_rect = geometry.translated(-screen->geometry().topLeft());
+    return true;
+}
+
+void LiveRegionTranslator::recognise(const QImage &frame, const TileHash::Grid &grid, bool settled)
+{
+    // frame may alias the capture buffer: it is only read here, and the strips queued for OCR are copies
+    const QVector<bool> changedRows = TileHash::changedRows(m_recognisedGrid, grid);
+
+    QVector<Band> bands = inkBands(frame);
+    QVector<int> heights;
+    for (const Band &band : bands) {
+        heights.append(band.bottom - band.top);
+    }
+    int medianHeight = 0;
+    if (!heights.isEmpty()) {
+        std::nth_element(heights.begin(), heights.begin() + heights.size() / 2, heights.end());
+        medianHeight = heights[heights.size() / 2];
+    }
+
+    QVector<Line> lines;
+    QVector<int> pending;
+    for (const Band &band : bands) {
+        Line line;
+        line.top = qMax(0, band.top - LINE_PADDING);
+        line.bottom = qMin(frame.height(), band.bottom + LINE_PADDING);
+        const int height = band.bottom - band.top;
+        line.block = height > MAX_LINE_HEIGHT || (bands.size() > 1 && height > 2 * medianHeight);
+
+        // Lines entirely inside unchanged tile rows keep their text without looking at their pixels
+        bool untouched = true;
+        for (int row = line.top / grid.tileSize; row <= (line.bottom - 1) / grid.tileSize && untouched; ++row) {
+            untouched = !changedRows[row];
+        }
+        if (untouched) {
+            const auto previous = std::find_if(m_lines.cbegin(), m_lines.cend(), [&line](const Line &old) {
+                return old.top == line.top && old.bottom == line.bottom;
+            });
+            if (previous != m_lines.cend()) {
+                lines.append(*previous);
+                continue;
+            }
+        }
+
+        // Same place as a line from the last round: keep showing its text and extend its fusion window
+        const int center = (line.top + line.bottom) / 2;
+        const auto previous = std::find_if(m_lines.cbegin(), m_lines.cend(), [center](const Line &old) {
+            return center >= old.top && center < old.bottom;
+        });
+        if (previous != m_lines.cend()) {
+            line.text = previous->text;
+            line.fusion = previous->fusion;
+        }
+
+        // Changed rows: a line seen before (scrolled chat, repeated subtitle) comes from the cache
+        line.hash = TileHash::hashRows(frame, line.top, line.bottom);
+        const auto cached = m_textByHash.constFind(line.hash);
+        if (cached != m_textByHash.cend()) {
+            line.text = cached.value();
+        } else {
+            pending.append(lines.size());
+        }
+        lines.append(line);
+    }
+
+    m_recognisedGrid = grid;
+    m_lines = lines;
+    m_settledRound = settled;
+
+    if (pending.isEmpty()) {
+        finishRecognition();
+        return;
+    }
+
+    const AppSettings::OCRConfig config = AppSettings::instance().getOCRConfig();
+    m_pendingLines = pending.size();
+    for (int index : pending) {
+        const Line &line = m_lines[index];
+        const QImage image = prepareLine(frame.copy(0, line.top, frame.width(), line.bottom - line.top));
+
+#ifdef Q_OS_MACOS
+        if (config.engine == "AppleVision") {
+            const AppleVisionOCR::RecognitionLevel level = config.qualityLevel >= 4
+                ? AppleVisionOCR::Accurate : AppleVisionOCR::Fast;
+            const QString language = config.language == "Auto-Detect" ? QString() : config.language;
+            const OCRResult result = AppleVisionOCR::performOCR(image, language, level);
+            const QString text = result.success ? result.text.simplified() : QString();
+            onLineRecognised(index, text, TemporalOCRFusion::characterWeights(text, result.tokens, 1.f));
+            continue;
+        }
+#endif
+
+        const int psm = line.block ? 0 : SINGLE_LINE_PSM;
+        m_pool.start([this, index, image, config, psm]() {
+            const OCRResult result = TesseractEngine::performOCR(image, config.language, config.qualityLevel,
+                                                                 config.preprocessing, false, psm);
+            const QString text = result.success ? result.text.simplified() : QString();
+            const QVector<float> weights = TemporalOCRFusion::characterWeights(text, result.tokens);
+            QMetaObject::invokeMethod(this, [this, index, text, weights]() {
+                onLineRecognised(index, text, weights);
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
+void LiveRegionTranslator::onLineRecognised(int index, const QString &text, const QVector<float> &weights)
+{
+    if (index < m_lines.size()) {
+        Line &line = m_lines[index];
+        const QString fused = line.fusion.add(text, weights);
+
+        // Moving content is read again shortly: hold the old text until a second reading agrees,
+        // so one bad frame neither flickers the overlay nor costs a translation
+        if (fused.isEmpty() || m_settledRound || line.fusion.isConfirmed()) {
+            line.text = fused;
+            if (m_textByHash.size() >= MAX_CACHED_LINES) {
+                m_textByHash.clear();
+            }
+            m_textByHash.insert(line.hash, fused);
+        }
+    }
+
+    if (--m_pendingLines == 0) {
+        finishRecognition();
+    }
+}
+
+void LiveRegionTranslator::finishRecognition()
+{
+    const AppSettings::TranslationConfig config = AppSettings::instance().getTranslationConfig();
+
+    m_translationQueue.clear();
+    if (config.autoTranslate) {
+        for (const Line &line : std::as_const(m_lines)) {
+            if (!line.text.isEmpty() && !m_translations.contains(line.text)
+                && !m_translationQueue.contains(line.text)) {
+                m_translationQueue << line.text;
+            }
+        }
+    }
+
+    // New text shows straight away; its translation fills in when it arrives
+    updateOverlay();
+    if (m_translationQueue.isEmpty()) {
+        m_busy = false;
+        return;
+    }
+
+    if (!m_translator) {
+        m_translator = new TranslationEngine(this);
+        connect(m_translator, &TranslationEngine::translationFinished,
+                this, &LiveRegionTranslator::onTranslationFinished);
+    }
+    m_translator->setEngine(TranslationEngine::engineForName(config.engine));
+    m_translator->setSourceLanguage("Auto-Detect");
+    m_translator->setTargetLanguage(config.targetLanguage);
+
+    m_batchTranslation = true;
+    translateNext();
+}
+
+void LiveRegionTranslator::translateNext()
+{
+    if (m_translationQueue.isEmpty() || m_stopped) {
+        updateOverlay();
+        m_busy = false;
+        return;
+    }
+
+    // One request for every new line; line breaks map the reply back onto the lines
+    m_inFlight = m_batchTranslation ? m_translationQueue : QStringList { m_translationQueue.first() };
+    m_translator->translate(m_inFlight.join('\n'));
+}
+
+void LiveRegionTranslator::onTranslationFinished(const TranslationResult &result)
+{
+    if (m_inFlight.isEmpty()) {
+        return;
+    }
+    const QStringList sent = m_inFlight;
+    m_inFlight.clear();
+
+    if (!result.success) {
+        qDebug() << "LiveRegionTranslator: Translation failed:" << result.errorMessage;
+        m_translationQueue.clear();
+        updateOverlay();
+        m_busy = false;
+        return;
+    }
+
+    const QStringList parts = result.translatedText.split('\n');
+    if (sent.size() > 1 && parts.size() != sent.size()) {
+        qDebug() << "LiveRegionTranslator: Translation returned" << parts.size() << "lines for"
+                 << sent.size() << "- translating line by line";
+        m_batchTranslation = false;
+        translateNext();
+        return;
+    }
+
+    if (m_translations.size() + sent.size() > MAX_CACHED_TRANSLATIONS) {
+        m_translations.clear();
+    }
+    for (int i = 0; i < sent.size(); ++i) {
+        const QString translated = sent.size() == 1 ? result.translatedText.simplified() : parts[i].trimmed();
+        m_translations.insert(sent[i], translated);
+        m_translationQueue.removeOne(sent[i]);
+    }
+    translateNext();
+}
+
+void LiveRegionTranslator::updateOverlay()
+{
+    if (m_stopped) {
+        return;
+    }
+
+    QStringList originals;
+    QStringList translations;
+    bool translated = false;
+    for (const Line &line : std::as_const(m_lines)) {
+        if (line.text.isEmpty()) {
+            continue;
+        }
+        originals << line.text;
+        const auto translation = m_translations.constFind(line.text);
+        if (translation != m_translations.cend()) {
+            translations << translation.value();
+            translated = true;
+        } else {
+            translations << line.text;
+        }
+    }
+
+    const QString original = originals.join('\n');
+    const QString translatedText = translated ? translations.join('\n') : QString();
+    if (original == m_shownOriginal && translatedText == m_shownTranslated) {
+        return;
+    }
+    m_shownOriginal = original;
+    m_shownTranslated = translatedText;
+
+    m_updatingOverlay = true;
+    if (original.isEmpty() || !m_screen) {
+        m_overlay->hide();
+    } else {
+        m_overlay->setContent(original, translatedText);
+        m_overlay->setMode(translated ? QuickTranslationOverlay::ShowBoth : QuickTranslationOverlay::ShowOriginal);
+        // Never over the region itself, or the overlay would be captured and "change" every frame
+        m_overlay->setPositionNearRect(m_rect, m_screen->geometry().size(), { m_rect }, m_screen->geometry().topLeft());
+        m_overlay->show();
+        m_overlay->raise();
+    }
+    m_updatingOverlay = false;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QPointer>
+#include <QRect>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+#include "ScreenCapture.h"
+#include "TileHash.h"
+#include "../../ocr/fusion/TemporalOCRFusion.h"
+
+class QScreen;
+class QuickTranslationOverlay;
+class TranslationEngine;
+struct TranslationResult;
+
+/**
+ * Live region translation (games, video subtitles, chat windows)
+ * A region picked once in ScreenshotWidget is re-captured every
+ * ocr/liveIntervalMs. Each frame is tile-hashed; while the hashes match the
+ * last recognised frame nothing else runs, and the poll slows down after a
+ * while, so a static screen costs next to nothing. When tiles change, the
+ * frame is split into text lines and only lines touching changed tile rows
+ * are OCR'd - and lines whose pixels were seen before (a scrolled chat) come
+ * from a cache. Moving content (video) is read every other poll and each
+ * line's readings are fused (TemporalOCRFusion), so OCR noise neither
+ * flickers the overlay nor triggers new translations. Only new line text is
+ * sent for translation. Results go to a
+ * persistent QuickTranslationOverlay beside the region; clicking it stops
+ * live mode. A picked window can be followed instead of a region: only that
+ * window's own buffer is captured, so it is read correctly while covered.
+ */
+class LiveRegionTranslator : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Starts translating rect (screen-local, logical) on screen; replaces any running live region
+    static void start(QScreen *screen, const QRect &rect);
+    // Translates a whole window (ScreenCapture::windows()) wherever it is, even when covered
+    static void startWindow(quintptr window);
+    static void stopActive();
+
+    // Hides the overlay and deletes this translator
+    void stop();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct Line {
+        int top = 0;
+        int bottom = 0;        // exclusive, device pixels within the region frame
+        bool block = false;    // Too tall for one text line (busy background); OCR'd as a block
+        quint64 hash = 0;
+        QString text;          // What the overlay shows for this line
+        TemporalOCRFusion fusion;
+    };
+
+    LiveRegionTranslator(QScreen *screen, const QRect &rect);
+    ~LiveRegionTranslator();
+
+    void tick();
+    bool followWindow();
+    void recognise(const QImage &frame, const TileHash::Grid &grid, bool settled);
+    void onLineRecognised(int index, const QString &text, const QVector<float> &weights);
+    void finishRecognition();
+    void translateNext();
+    void onTranslationFinished(const TranslationResult &result);
+    void updateOverlay();
+
+    QPointer<QScreen> m_screen;
+    QRect m_rect;
+    ScreenCapture m_capture;
+    quintptr m_window = 0;     // Followed window, or 0 for a fixed screen region
+    QTimer m_timer;
+    int m_baseInterval = 500;
+    int m_idleTicks = 0;
+    int m_unsettledTicks = 0;
+    int m_failedGrabs = 0;
+    bool m_busy = false;       // Capture, OCR or translation in flight; ticks are skipped
+    bool m_stopped = false;
+
+    TileHash::Grid m_previousGrid;     // Last polled frame
+    TileHash::Grid m_recognisedGrid;   // Frame the current lines were read from
+    QVector<Line> m_lines;
+    QHash<quint64, QString> m_textByHash;     // Line pixels -> OCR text
+    QHash<QString, QString> m_translations;   // Line text -> translation
+
+    QThreadPool m_pool;
+    int m_pendingLines = 0;
+    bool m_settledRound = false;   // Frame matched the previous poll; it won't be read again
+
+    TranslationEngine *m_translator = nullptr;
+    QStringList m_translationQueue;
+    QStringList m_inFlight;
+    bool m_batchTranslation = true;
+
+    QuickTranslationOverlay *m_overlay = nullptr;
+    bool m_updatingOverlay = false;
+    QString m_shownOriginal;
+    QString m_shownTranslated;
+};
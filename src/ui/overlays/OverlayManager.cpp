@@ -5,6 +5,7 @@
 #include "../tts/TTSManager.h"
 #include "../core/LanguageManager.h"
 #include "../core/AppSettings.h"
+#include "../../ocr/worker/OCRWorkerPool.h"
 #include <QDebug>
 
 OverlayManager::OverlayManager(ScreenshotWidget* parent)
@@ -51,16 +52,26 @@ void OverlayManager::initializeOCR()
     connect(m_ocrEngine, &OCREngine::ocrProgress, this, &OverlayManager::onOCRProgress);
     connect(m_ocrEngine, &OCREngine::ocrError, this, &OverlayManager::onOCRError);
 
+    // Spawn the first OCR worker while the user is still selecting
+    OCRWorkerPool::instance().setWorkerCount(AppSettings::instance().getOCRConfig().workerCount);
+    OCRWorkerPool::instance().prewarm();
+
     qDebug() << "OCR engine initialized";
 }
 
-void OverlayManager::performOCR(const QPixmap& image, const QRect& selectionRect, const QPixmap& fullScreenshot, const QList<QRect>& existingSelections)
+void OverlayManager::performOCR(const QImage& image, const QRect& selectionRect, const QList<QRect>& existingSelections, const OCRResult& recognised)
+{
+    prepareOCR(selectionRect, existingSelections);
+    finishOCR(image, recognised);
+}
+
+void OverlayManager::prepareOCR(const QRect& selectionRect, const QList<QRect>& existingSelections)
 {
     qDebug() << "OverlayManager starting OCR for selection:" << selectionRect;
 
-    // Store selection rect and source image for later use
+    // Store selection rect for later use; the screenshot itself stays with the overlay, so a
+    // finished session doesn't keep it alive here
     m_currentSelectionRect = selectionRect;
-    m_currentSourceImage = fullScreenshot;
     m_existingSelections = existingSelections;
 
     // Configure OCR engine using centralized settings
@@ -81,6 +92,8 @@ void OverlayManager::performOCR(const QPixmap& image, const QRect& selectionRect
     m_ocrEngine->setQualityLevel(ocrConfig.qualityLevel);
     m_ocrEngine->setPreprocessing(ocrConfig.preprocessing);
     m_ocrEngine->setAutoDetectOrientation(ocrConfig.autoDetectOrientation);
+    m_ocrEngine->setTableMode(ocrConfig.tableMode);
+    OCRWorkerPool::instance().setWorkerCount(ocrConfig.workerCount);
 
     // Configure translation settings
     m_ocrEngine->setAutoTranslate(translationConfig.autoTranslate);
@@ -98,12 +111,21 @@ void OverlayManager::performOCR(const QPixmap& image, const QRect& selectionRect
 
     // Show immediate preview overlay while OCR processes
     showImmediatePreview(selectionRect);
+}
+
+void OverlayManager::finishOCR(const QImage& image, const OCRResult& recognised, const QString& candidate)
+{
+    m_ocrEngine->setCandidateText(candidate);
 
-    // Start OCR processing
-    m_ocrEngine->performOCR(image);
+    // Start OCR processing, unless the selection was already read while it was being made
+    if (recognised.success) {
+        m_ocrEngine->useRecognised(recognised);
+    } else {
+        m_ocrEngine->performOCR(image);
+    }
 }
 
-void OverlayManager::showOCRResults(const OCRResult& result, const QRect& selectionRect, const QPixmap& sourceImage)
+void OverlayManager::showOCRResults(const OCRResult& result, const QRect& selectionRect)
 {
     qDebug() << "OverlayManager showing OCR results";
 
@@ -139,7 +161,7 @@ void OverlayManager::showOCRResults(const OCRResult& result, const QRect& select
 
     // Position the overlay elegantly near the selection, avoiding existing OCR areas
     QSize screenSize = m_parent->size(); // Screenshot widget covers the full screen
-    m_quickOverlay->setPositionNearRect(globalSelRect, screenSize, m_existingSelections);
+    m_quickOverlay->setPositionNearRect(globalSelRect, screenSize, m_existingSelections, m_parent->geometry().topLeft());
 
     // Show the overlay
     m_quickOverlay->show();
@@ -171,12 +193,12 @@ void OverlayManager::showError(const QString& error)
         QSize screenSize = m_parent->size();
         if (!m_currentSelectionRect.isEmpty()) {
             // Position near selection like normal results
-            m_quickOverlay->setPositionNearRect(m_currentSelectionRect, screenSize, m_existingSelections);
+            m_quickOverlay->setPositionNearRect(m_currentSelectionRect, screenSize, m_existingSelections, m_parent->geometry().topLeft());
         } else {
             // Fallback to center
             int x = (screenSize.width() - 300) / 2;
             int y = (screenSize.height() - 150) / 2;
-            m_quickOverlay->setGeometry(x, y, 300, 150);
+            m_quickOverlay->setGeometry(m_parent->geometry().x() + x, m_parent->geometry().y() + y, 300, 150);
         }
         
         m_quickOverlay->show();
@@ -197,6 +219,13 @@ void OverlayManager::hideAllOverlays()
     qDebug() << "All overlays hidden";
 }
 
+void OverlayManager::cancel()
+{
+    if (m_ocrEngine) {
+        m_ocrEngine->abort();
+    }
+}
+
 bool OverlayManager::areOverlaysVisible() const
 {
     return (m_quickOverlay && m_quickOverlay->isVisible());
@@ -261,7 +290,7 @@ void OverlayManager::onOCRFinished(const OCRResult& result)
 
     if (result.success && !result.text.isEmpty()) {
         // Show results with current selection rect and stored source image
-        showOCRResults(result, m_currentSelectionRect, m_currentSourceImage);
+        showOCRResults(result, m_currentSelectionRect);
     } else {
         // Show error with appropriate message
         QString errorMsg = result.errorMessage;
@@ -296,7 +325,7 @@ void OverlayManager::showImmediatePreview(const QRect& selectionRect)
 
     // Position the overlay (use existing selections to avoid overlaps)
     QSize screenSize = m_parent->size();
-    m_quickOverlay->setPositionNearRect(selectionRect, screenSize, m_existingSelections);
+    m_quickOverlay->setPositionNearRect(selectionRect, screenSize, m_existingSelections, m_parent->geometry().topLeft());
 
     // Show the preview
     m_quickOverlay->show();
@@ -2,7 +2,7 @@
 
 #include <QObject>
 #include <QRect>
-#include <QPixmap>
+#include <QImage>
 #include "../ocr/OCREngine.h"
 
 class ScreenshotWidget;
@@ -20,11 +20,21 @@ public:
     ~OverlayManager();
 
     // Main interface
-    void performOCR(const QPixmap& image, const QRect& selectionRect, const QPixmap& fullScreenshot = QPixmap(), const QList<QRect>& existingSelections = QList<QRect>());
-    void showOCRResults(const OCRResult& result, const QRect& selectionRect, const QPixmap& sourceImage);
+    // image is a frame (or a view into one) and is only held while its OCR runs; only the
+    // overlays paint pixmaps. A successful recognised result (read ahead of time) stands in
+    // for running OCR on image
+    void performOCR(const QImage& image, const QRect& selectionRect, const QList<QRect>& existingSelections = QList<QRect>(), const OCRResult& recognised = OCRResult());
+    // performOCR in two steps, for a selection whose recognition is still finishing elsewhere:
+    // prepareOCR shows the preview now, finishOCR starts (or stands in for) the OCR later.
+    // candidate is text the selection may hold (PRIMARY), used only if the OCR text agrees
+    void prepareOCR(const QRect& selectionRect, const QList<QRect>& existingSelections = QList<QRect>());
+    void finishOCR(const QImage& image, const OCRResult& recognised = OCRResult(), const QString& candidate = QString());
+    void showOCRResults(const OCRResult& result, const QRect& selectionRect);
     void showProgress(const QString& message);
     void showError(const QString& error);
     void hideAllOverlays();
+    // Drops the OCR and translation in flight, so nothing shows up after the overlay was dismissed
+    void cancel();
 
     // State queries
     bool areOverlaysVisible() const;
@@ -49,6 +59,5 @@ private:
     // OCR management
     OCREngine* m_ocrEngine;
     QRect m_currentSelectionRect;
-    QPixmap m_currentSourceImage;
     QList<QRect> m_existingSelections;
 };
\ No newline at end of file
@@ -60,7 +60,8 @@ void QuickTranslationOverlay::setMode(Mode mode)
     update();
 }
 
-void QuickTranslationOverlay::setPositionNearRect(const QRect &selectionRect, const QSize &screenSize, const QList<QRect> &avoidRects)
+void QuickTranslationOverlay::setPositionNearRect(const QRect &selectionRect, const QSize &screenSize, const QList<QRect> &avoidRects,
+                                                   const QPoint &screenOrigin)
 {
     calculateOptimalPosition(selectionRect, screenSize, avoidRects);
     
@@ -68,7 +69,7 @@ void QuickTranslationOverlay::setPositionNearRect(const QRect &selectionRect, co
     int x = qBound(0, m_panelPosition.x(), screenSize.width() - m_panelSize.width());
     int y = qBound(0, m_panelPosition.y(), screenSize.height() - m_panelSize.height());
     
-    setGeometry(x, y, m_panelSize.width(), m_panelSize.height());
+    setGeometry(screenOrigin.x() + x, screenOrigin.y() + y, m_panelSize.width(), m_panelSize.height());
 }
 
 void QuickTranslationOverlay::setFontScaling(float factor)
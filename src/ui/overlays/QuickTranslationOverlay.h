@@ -19,7 +19,9 @@ public:
     explicit QuickTranslationOverlay(QWidget *parent = nullptr);
     void setContent(const QString &originalText, const QString &translatedText);
     void setMode(Mode mode);
-    void setPositionNearRect(const QRect &selectionRect, const QSize &screenSize, const QList<QRect> &avoidRects = QList<QRect>());
+    // selectionRect/avoidRects are relative to the screen; screenOrigin is that screen's global top-left
+    void setPositionNearRect(const QRect &selectionRect, const QSize &screenSize, const QList<QRect> &avoidRects = QList<QRect>(),
+                             const QPoint &screenOrigin = QPoint());
     void setFontScaling(float factor);
 
 public slots:
@@ -0,0 +1,320 @@
+#include "SavedRegionReader.h"
+#include "QuickTranslationOverlay.h"
+#include "ImageFrame.h"
+#include "TranslationEngine.h"
+#include "../../ocr/engines/tesseract/TesseractEngine.h"
+#include "../../ocr/layout/TextLayout.h"
+#include "../../ocr/preprocessing/Deskew.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <QDebug>
+#include <algorithm>
+
+#ifdef Q_OS_MACOS
+#include "../../ocr/AppleVisionOCR.h"
+#endif
+
+namespace {
+
+constexpr int MAX_SAVED_REGIONS = 9;       // One per digit hotkey
+constexpr int MIN_TEXT_HEIGHT = 20;        // Lines shorter than this (device pixels) are read upscaled 2x
+constexpr int SINGLE_LINE_PSM = 7;
+constexpr int SINGLE_BLOCK_PSM = 6;
+
+QPointer<SavedRegionReader> s_reader;
+
+// Default hotkey of the slot-th saved region (1-based)
+QString defaultShortcut(int slot)
+{
+#ifdef Q_OS_MACOS
+    return QString("Meta+Alt+%1").arg(slot); // Stored as Meta for the Carbon API, like shortcuts/screenshot
+#else
+    return QString("Ctrl+Alt+%1").arg(slot);
+#endif
+}
+
+QScreen *screenNamed(const QString &name)
+{
+    for (QScreen *screen : QGuiApplication::screens()) {
+        if (screen->name() == name) {
+            return screen;
+        }
+    }
+    return QGuiApplication::primaryScreen();
+}
+
+QImage scaled(const QImage &frame, int scale)
+{
+    return scale > 1 ? frame.scaled(frame.size() * scale, Qt::IgnoreAspectRatio, Qt::SmoothTransformation) : frame;
+}
+
+// Mean word confidence where the engine reports one, else the amount of text read
+bool readsBetter(const OCRResult &candidate, const OCRResult &best)
+{
+    if (!candidate.success || candidate.text.trimmed().isEmpty()) {
+        return false;
+    }
+    if (!best.success) {
+        return true;
+    }
+    bool candidateNumeric = false;
+    bool bestNumeric = false;
+    const double candidateConfidence = candidate.confidence.toDouble(&candidateNumeric);
+    const double bestConfidence = best.confidence.toDouble(&bestNumeric);
+    if (candidateNumeric && bestNumeric) {
+        return candidateConfidence > bestConfidence;
+    }
+    const auto letters = [](const QString &text) {
+        return std::count_if(text.cbegin(), text.cend(), [](QChar c) { return c.isLetterOrNumber(); });
+    };
+    return letters(candidate.text) > letters(best.text);
+}
+
+// First read of region: settles its pipeline choices and returns the better reading
+OCRResult calibrate(const QImage &frame, AppSettings::SavedRegion &region, const AppSettings::OCRConfig &config)
+{
+    region.language = config.language;
+
+    // Small text is upscaled; one line or one block gets the matching PSM
+    const QVector<TextLayout::Block> blocks = TextLayout::analyse(frame);
+    QVector<int> heights;
+    for (const TextLayout::Block &block : blocks) {
+        for (const QRect &line : block.lines) {
+            heights.append(line.height());
+        }
+    }
+    int medianHeight = 0;
+    if (!heights.isEmpty()) {
+        std::nth_element(heights.begin(), heights.begin() + heights.size() / 2, heights.end());
+        medianHeight = heights[heights.size() / 2];
+    }
+    region.scale = medianHeight > 0 && medianHeight < MIN_TEXT_HEIGHT ? 2 : 1;
+    region.psm = heights.size() == 1 ? SINGLE_LINE_PSM : blocks.size() == 1 ? SINGLE_BLOCK_PSM : 0;
+    const QImage image = scaled(frame, region.scale);
+
+    // Later reads keep orientation detection only if this region needs turning, or Deskew
+    // couldn't tell and Tesseract OSD has to
+    region.autoDetectOrientation = false;
+    if (config.autoDetectOrientation) {
+        const Deskew::Estimate estimate = Deskew::estimate(image.convertToFormat(QImage::Format_Grayscale8));
+        region.autoDetectOrientation = !estimate.confident || estimate.needsCorrection();
+    }
+
+    // Both preprocessing paths, the configured one first; the better reading wins
+    OCRResult best;
+    for (bool preprocessing : { config.preprocessing, !config.preprocessing }) {
+        const OCRResult result = TesseractEngine::performOCR(image, region.language, config.qualityLevel,
+                                                             preprocessing, region.autoDetectOrientation, region.psm);
+        if (readsBetter(result, best)) {
+            best = result;
+            region.preprocessing = preprocessing;
+        }
+    }
+    region.calibrated = true;
+
+    qDebug() << "SavedRegionReader: Calibrated" << region.rect << "scale" << region.scale << "psm" << region.psm
+             << "preprocessing" << region.preprocessing << "orientation" << region.autoDetectOrientation;
+    return best;
+}
+
+} // namespace
+
+QString SavedRegionReader::save(QScreen *screen, const QRect &rect, const QImage &pixels)
+{
+    if (!screen || rect.isEmpty()) {
+        return QString();
+    }
+
+    // The oldest region gives up its hotkey once every slot is taken
+    QVector<AppSettings::SavedRegion> regions = AppSettings::instance().getSavedRegions();
+    QString shortcut;
+    for (int slot = 1; slot <= MAX_SAVED_REGIONS && shortcut.isEmpty(); ++slot) {
+        const QString candidate = defaultShortcut(slot);
+        const bool taken = std::any_of(regions.cbegin(), regions.cend(), [&candidate](const AppSettings::SavedRegion &region) {
+            return region.shortcut == candidate;
+        });
+        if (!taken) {
+            shortcut = candidate;
+        }
+    }
+    if (shortcut.isEmpty()) {
+        shortcut = regions.takeFirst().shortcut;
+    }
+
+    AppSettings::SavedRegion region;
+    region.screen = screen->name();
+    region.rect = rect;
+    region.shortcut = shortcut;
+    regions.append(region);
+    AppSettings::instance().setSavedRegions(regions);
+    qInfo() << "SavedRegionReader: Saved" << rect << "on" << screen->name() << "as" << shortcut;
+
+    // The region is on screen right now: calibrate on those pixels instead of capturing again
+    SavedRegionReader *saved = reader();
+    if (!saved->m_busy && !pixels.isNull()) {
+        saved->m_busy = true;
+        saved->recognise(region, screen, ImageFrame::normalised(pixels));
+    }
+    return shortcut;
+}
+
+void SavedRegionReader::read(int index)
+{
+    const QVector<AppSettings::SavedRegion> regions = AppSettings::instance().getSavedRegions();
+    if (index < 0 || index >= regions.size()) {
+        qWarning() << "SavedRegionReader: No saved region" << index + 1;
+        return;
+    }
+
+    SavedRegionReader *saved = reader();
+    if (saved->m_busy) {
+        qDebug() << "SavedRegionReader: Still reading, hotkey ignored";
+        return;
+    }
+
+    const AppSettings::SavedRegion &region = regions[index];
+    QScreen *screen = screenNamed(region.screen);
+    if (!screen) {
+        return;
+    }
+    saved->m_busy = true;
+
+    // Only the region itself; the frame may alias the capture buffer, so the OCR gets a copy
+    const QImage frame = saved->m_capture.captureRegion(screen, region.rect);
+    if (frame.isNull()) {
+        qWarning() << "SavedRegionReader: Capture of" << region.rect << "failed";
+        saved->m_busy = false;
+        return;
+    }
+    saved->recognise(region, screen, frame.copy());
+}
+
+void SavedRegionReader::shutdown()
+{
+    delete s_reader.data();
+}
+
+SavedRegionReader *SavedRegionReader::reader()
+{
+    if (!s_reader) {
+        s_reader = new SavedRegionReader();
+    }
+    return s_reader;
+}
+
+SavedRegionReader::SavedRegionReader()
+    : QObject(nullptr)
+{
+    m_pool.setMaxThreadCount(1);
+
+    m_overlay = new QuickTranslationOverlay(nullptr);
+    m_overlay->setAttribute(Qt::WA_DeleteOnClose, false);
+    // Whatever the user was reading keeps keyboard focus
+    m_overlay->setAttribute(Qt::WA_ShowWithoutActivating, true);
+    connect(&AppSettings::instance(), &AppSettings::uiSettingsChanged,
+            m_overlay, &QuickTranslationOverlay::updateThemeColors);
+}
+
+SavedRegionReader::~SavedRegionReader()
+{
+    // The job posts back to this object; let it drain before it goes away
+    m_pool.clear();
+    m_pool.waitForDone();
+    delete m_overlay;
+}
+
+void SavedRegionReader::recognise(const AppSettings::SavedRegion &region, QScreen *screen, const QImage &frame)
+{
+    m_screen = screen;
+    m_rect = region.rect;
+    const AppSettings::OCRConfig config = AppSettings::instance().getOCRConfig();
+
+#ifdef Q_OS_MACOS
+    if (config.engine == "AppleVision") {
+        // Vision makes no per-region choices; it reads the frame as it is
+        const AppleVisionOCR::RecognitionLevel level = config.qualityLevel >= 4
+            ? AppleVisionOCR::Accurate : AppleVisionOCR::Fast;
+        const QString language = config.language == "Auto-Detect" ? QString() : config.language;
+        onRecognised(region, AppleVisionOCR::performOCR(frame, language, level));
+        return;
+    }
+#endif
+
+    m_pool.start([this, region, frame, config]() {
+        AppSettings::SavedRegion read = region;
+        OCRResult result;
+        if (!read.calibrated || read.language != config.language) {
+            result = calibrate(frame, read, config);
+        } else {
+            result = TesseractEngine::performOCR(scaled(frame, read.scale), read.language, config.qualityLevel,
+                                                 read.preprocessing, read.autoDetectOrientation, read.psm);
+        }
+        QMetaObject::invokeMethod(this, [this, region, read, result]() {
+            // Keep what calibration decided, unless the region was changed or removed meanwhile
+            if (read.calibrated && !region.calibrated) {
+                QVector<AppSettings::SavedRegion> regions = AppSettings::instance().getSavedRegions();
+                for (AppSettings::SavedRegion &saved : regions) {
+                    if (saved.screen == region.screen && saved.rect == region.rect && saved.shortcut == region.shortcut) {
+                        saved = read;
+                        AppSettings::instance().setSavedRegions(regions);
+                        break;
+                    }
+                }
+            }
+            onRecognised(read, result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void SavedRegionReader::onRecognised(const AppSettings::SavedRegion &region, const OCRResult &result)
+{
+    m_original = result.success ? result.text.trimmed() : QString();
+    if (m_original.isEmpty()) {
+        qDebug() << "SavedRegionReader: No text in" << region.rect;
+        showText(QString(), QString());
+        m_busy = false;
+        return;
+    }
+
+    // The text shows straight away; its translation fills in when it arrives
+    showText(m_original, QString());
+    const AppSettings::TranslationConfig config = AppSettings::instance().getTranslationConfig();
+    if (!config.autoTranslate) {
+        m_busy = false;
+        return;
+    }
+
+    if (!m_translator) {
+        m_translator = new TranslationEngine(this);
+        connect(m_translator, &TranslationEngine::translationFinished,
+                this, &SavedRegionReader::onTranslationFinished);
+    }
+    m_translator->setEngine(TranslationEngine::engineForName(config.engine));
+    m_translator->setSourceLanguage("Auto-Detect");
+    m_translator->setTargetLanguage(config.targetLanguage);
+    m_translator->translate(m_original);
+}
+
+void SavedRegionReader::onTranslationFinished(const TranslationResult &result)
+{
+    if (result.success) {
+        showText(m_original, result.translatedText.trimmed());
+    } else {
+        qDebug() << "SavedRegionReader: Translation failed:" << result.errorMessage;
+    }
+    m_busy = false;
+}
+
+void SavedRegionReader::showText(const QString &original, const QString &translated)
+{
+    if (original.isEmpty() || !m_screen) {
+        m_overlay->hide();
+        return;
+    }
+    m_overlay->setContent(original, translated);
+    m_overlay->setMode(translated.isEmpty() ? QuickTranslationOverlay::ShowOriginal : QuickTranslationOverlay::ShowBoth);
+    // Beside the region, never over it: it may be read again straight away
+    m_overlay->setPositionNearRect(m_rect, m_screen->geometry().size(), { m_rect }, m_screen->geometry().topLeft());
+    m_overlay->show();
+    m_overlay->raise();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QObject>
+#include <QImage>
+#include <QPointer>
+#include <QRect>
+#include <QThreadPool>
+#include "ScreenCapture.h"
+#include "../core/AppSettings.h"
+
+class QScreen;
+class QuickTranslationOverlay;
+class TranslationEngine;
+struct OCRResult;
+struct TranslationResult;
+
+/**
+ * Saved regions (chat boxes, status panels) re-read on their own hotkey
+ * A region is saved from ScreenshotWidget with Ctrl+drag and gets the next
+ * free global hotkey (GlobalShortcutManager). Its hotkey captures only that
+ * rectangle - no overlay, no full-screen grab - and shows the text (and
+ * translation) in a QuickTranslationOverlay beside it.
+ *
+ * The first read calibrates the pipeline for the region: scale factor and PSM
+ * from its text layout, whether orientation needs estimating at all, and
+ * which preprocessing reads it better. The choices are stored with the region
+ * (AppSettings::SavedRegion), so every later read is one recognition with no
+ * decisions left to make. Changing the OCR language recalibrates.
+ */
+class SavedRegionReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Saves rect (screen-local, logical) on screen with the next free hotkey and reads it from
+    // pixels (the region as already captured). Returns the hotkey
+    static QString save(QScreen *screen, const QRect &rect, const QImage &pixels);
+    // Captures saved region index and shows its text beside it
+    static void read(int index);
+    // Finishes a read in progress; before the OCR worker pool shuts down
+    static void shutdown();
+
+private:
+    SavedRegionReader();
+    ~SavedRegionReader();
+    static SavedRegionReader *reader();
+
+    void recognise(const AppSettings::SavedRegion &region, QScreen *screen, const QImage &frame);
+    void onRecognised(const AppSettings::SavedRegion &region, const OCRResult &result);
+    void onTranslationFinished(const TranslationResult &result);
+    void showText(const QString &original, const QString &translated);
+
+    ScreenCapture m_capture;
+    QThreadPool m_pool;
+    bool m_busy = false;            // Capture, OCR or translation in flight; hotkeys are ignored
+
+    QPointer<QScreen> m_screen;     // Where the region being read is
+    QRect m_rect;
+    QString m_original;
+
+    TranslationEngine *m_translator = nullptr;
+    QuickTranslationOverlay *m_overlay = nullptr;
+};
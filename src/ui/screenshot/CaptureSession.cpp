@@ -0,0 +1,205 @@
+#include "CaptureSession.h"
+#include "ScreenshotWidget.h"
+#include <QGuiApplication>
+#include <QCursor>
+#include <QScreen>
+#include <QDebug>
+
+namespace {
+constexpr int CURSOR_POLL_MS = 50;
+constexpr qint64 MB = 1024 * 1024;
+
+// Hidden, fully built overlay handed to the next session
+QPointer<ScreenshotWidget> s_spare;
+}
+
+CaptureSession::CaptureSession(QObject *parent)
+    : QObject(parent)
+{
+    // Overlays don't see the cursor once it leaves their screen, so watch it from here
+    m_cursorTimer.setInterval(CURSOR_POLL_MS);
+    connect(&m_cursorTimer, &QTimer::timeout, this, &CaptureSession::followCursor);
+
+    // One grab at a time; they share one X connection anyway
+    m_pool.setMaxThreadCount(1);
+
+    connect(qGuiApp, &QGuiApplication::screenRemoved, this, [this](QScreen *screen) {
+        m_grabbing.remove(screen);
+        QPointer<ScreenshotWidget> overlay = m_overlays.take(screen);
+        if (overlay) {
+            overlay->close();
+            overlay->deleteLater();
+        }
+        if (m_overlays.isEmpty()) {
+            finish();
+        }
+    });
+}
+
+CaptureSession::~CaptureSession()
+{
+    m_pool.waitForDone();
+    for (const QPointer<ScreenshotWidget> &overlay : std::as_const(m_overlays)) {
+        if (overlay) {
+            overlay->deleteLater();
+        }
+    }
+}
+
+void CaptureSession::prewarm()
+{
+    if (s_spare) {
+        return;
+    }
+
+    s_spare = new ScreenshotWidget(QImage());
+    QObject::connect(qGuiApp, &QGuiApplication::aboutToQuit, s_spare, &QObject::deleteLater);
+}
+
+bool CaptureSession::start()
+{
+    QScreen *screen = ScreenCapture::screenUnderCursor();
+    if (!openScreen(screen)) {
+        return false;
+    }
+
+    // Nothing else to lazily grab on a single monitor
+    if (QGuiApplication::screens().size() > 1) {
+        m_cursorTimer.start();
+    }
+    return true;
+}
+
+void CaptureSession::finish()
+{
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    m_cursorTimer.stop();
+    m_grabbing.clear();
+    logMemoryUse();
+
+    for (const QPointer<ScreenshotWidget> &overlay : std::as_const(m_overlays)) {
+        if (!overlay) {
+            continue;
+        }
+        // One overlay goes back to being the spare; the others (extra monitors) are rebuilt when needed
+        if (!s_spare) {
+            overlay->reset();
+            s_spare = overlay;
+        } else {
+            overlay->close();
+            overlay->deleteLater();
+        }
+    }
+    m_overlays.clear();
+    qDebug() << "CaptureSession: Session memory released";
+
+    emit finished();
+}
+
+ScreenshotWidget *CaptureSession::openScreen(QScreen *screen, const QImage &grabbed)
+{
+    if (!screen) {
+        return nullptr;
+    }
+
+    QImage screenshot = grabbed;
+    if (screenshot.isNull()) {
+        screenshot = m_capture.captureScreen(screen);
+    }
+    if (screenshot.isNull()) {
+        qWarning() << "CaptureSession: Failed to capture" << screen->name();
+        // Remember the failure so the cursor poll doesn't retry every tick
+        m_overlays.insert(screen, nullptr);
+        return nullptr;
+    }
+    qDebug() << "CaptureSession: Captured" << screen->name() << screenshot.size()
+             << "DPR:" << screenshot.devicePixelRatio();
+
+    ScreenshotWidget *overlay = s_spare;
+    s_spare = nullptr;
+    if (overlay) {
+        overlay->begin(screenshot, screen);
+    } else {
+        overlay = new ScreenshotWidget(screenshot, screen);
+    }
+    m_overlays.insert(screen, overlay);
+
+    // Any overlay finishing (Esc, copy, save, cancel) ends the session on every screen
+    connect(overlay, &ScreenshotWidget::screenshotFinished, this, &CaptureSession::finish);
+    logMemoryUse();
+
+    overlay->show();
+    overlay->raise();
+    // Don't steal focus from an overlay that is mid-drag
+    if (QGuiApplication::mouseButtons() == Qt::NoButton) {
+        overlay->activateWindow();
+    }
+    return overlay;
+}
+
+bool CaptureSession::grabInBackground(QScreen *screen)
+{
+    const std::function<QImage()> grab = ScreenCapture::backgroundGrab(screen);
+    if (!grab) {
+        return false;
+    }
+    m_grabbing.insert(screen);
+    m_pool.start([this, screen, grab]() {
+        const QImage screenshot = grab();
+        QMetaObject::invokeMethod(this, [this, screen, screenshot]() {
+            onBackgroundGrab(screen, screenshot);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void CaptureSession::onBackgroundGrab(QScreen *screen, const QImage &screenshot)
+{
+    // Session over, or the screen went away while it was being grabbed (don't touch it then)
+    if (!m_grabbing.remove(screen)) {
+        return;
+    }
+    // A failed grab falls back to the GUI-thread capture
+    openScreen(screen, screenshot);
+    stopWhenAllVisited();
+}
+
+void CaptureSession::followCursor()
+{
+    QScreen *screen = QGuiApplication::screenAt(QCursor::pos());
+    if (!screen || m_overlays.contains(screen) || m_grabbing.contains(screen)) {
+        return;
+    }
+
+    if (grabInBackground(screen)) {
+        qDebug() << "CaptureSession: Cursor entered" << screen->name() << "- grabbing it in the background";
+        return;
+    }
+    qDebug() << "CaptureSession: Cursor entered" << screen->name() << "- capturing it now";
+    openScreen(screen);
+    stopWhenAllVisited();
+}
+
+void CaptureSession::stopWhenAllVisited()
+{
+    // Every screen has been visited; stop polling
+    if (m_overlays.size() >= QGuiApplication::screens().size()) {
+        m_cursorTimer.stop();
+    }
+}
+
+void CaptureSession::logMemoryUse() const
+{
+    qint64 total = 0;
+    for (auto it = m_overlays.cbegin(); it != m_overlays.cend(); ++it) {
+        if (it.value()) {
+            const qint64 bytes = it.value()->memoryUse();
+            qDebug() << "CaptureSession:" << it.key()->name() << bytes / MB << "MB";
+            total += bytes;
+        }
+    }
+    qDebug() << "CaptureSession: Session memory" << total / MB << "MB across" << m_overlays.size() << "screens";
+}
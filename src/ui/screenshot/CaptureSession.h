@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QPointer>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
+#include "ScreenCapture.h"
+
+class QScreen;
+class ScreenshotWidget;
+
+/**
+ * One screenshot session across every monitor
+ * Only the screen under the cursor is grabbed up front, so selection can
+ * start right away. Another screen is grabbed when the cursor first moves onto
+ * it, on a worker thread where the platform allows (X11), so the overlay in
+ * use keeps responding; it then gets its own overlay with its own DPR. Escape
+ * or a finished action on any overlay ends the whole session.
+ *
+ * One overlay is kept alive between sessions, hidden and fully set up (theme,
+ * OverlayManager, OCR engine, translation overlay), so the first screen of a
+ * session only needs its screenshot.
+ */
+class CaptureSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CaptureSession(QObject *parent = nullptr);
+    ~CaptureSession();
+
+    // Captures the cursor's screen and shows its overlay; false if that capture failed
+    bool start();
+
+    // Builds the spare overlay ahead of the first screenshot
+    static void prewarm();
+
+    // Close every overlay (emits finished once)
+    void finish();
+
+signals:
+    void finished();
+
+private:
+    // grabbed: the screen's image if it was grabbed already (in the background); otherwise it is captured here
+    ScreenshotWidget *openScreen(QScreen *screen, const QImage &grabbed = QImage());
+    bool grabInBackground(QScreen *screen);
+    void onBackgroundGrab(QScreen *screen, const QImage &screenshot);
+    void followCursor();
+    void stopWhenAllVisited();
+    // Debug readout of what every overlay in the session holds
+    void logMemoryUse() const;
+
+    ScreenCapture m_capture;
+    QHash<QScreen*, QPointer<ScreenshotWidget>> m_overlays;
+    QTimer m_cursorTimer;
+    bool m_finished = false;
+
+    // Screens entered whose grab is in flight on m_pool
+    QThreadPool m_pool;
+    QSet<QScreen*> m_grabbing;
+};
@@ -1,5 +1,9 @@
 #include "ScreenshotWidget.h"
 #include "../overlays/OverlayManager.h"
+#include "../overlays/LiveRegionTranslator.h"
+#include "../overlays/SavedRegionReader.h"
+#include "../../ocr/table/TableRecognizer.h"
+#include "ImageFrame.h"
 #include "TTSManager.h"
 #include "TTSEngine.h"
 #include "../core/ThemeManager.h"
@@ -11,6 +15,8 @@
 #include <QPen>
 #include <QDebug>
 #include <QClipboard>
+#include <QCursor>
+#include <QMimeData>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QDir>
@@ -19,10 +25,44 @@
 #include <QStyleHints>
 #include <QGuiApplication>
 #include <iostream>
+#include <utility>
+
+namespace {
+
+constexpr int HANDLE_SIZE = 8;
+constexpr int DWELL_MS = 250;   // A drag resting this long is read before it is released
+constexpr int MAX_OCR_SELECTIONS = 32;  // Earlier OCR'd areas kept framed; older ones fade back into the dim
+
+// Bytes a pixmap of this size and depth holds (QPixmap doesn't say)
+qint64 pixmapBytes(const QPixmap &pixmap)
+{
+    return pixmap.isNull() ? 0 : qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+}
+
+// Logical widget rect to the screenshot's device pixels
+QRect devicePixels(const QRect &rect, qreal dpr)
+{
+    return QRect(QPoint(static_cast<int>(rect.x() * dpr), static_cast<int>(rect.y() * dpr)),
+                 QSize(static_cast<int>(rect.width() * dpr), static_cast<int>(rect.height() * dpr)));
+}
+
+// Logical widget point to the screenshot's device pixels
+QPoint devicePoint(const QPoint &point, qreal dpr)
+{
+    return QPoint(static_cast<int>(point.x() * dpr), static_cast<int>(point.y() * dpr));
+}
+
+// Device pixel rect back to the smallest logical widget rect covering it
+QRect logicalRect(const QRect &rect, qreal dpr)
+{
+    return QRectF(rect.x() / dpr, rect.y() / dpr, rect.width() / dpr, rect.height() / dpr).toAlignedRect();
+}
+
+} // namespace
 
 ScreenshotWidget::ScreenshotWidget(QWidget *parent)
     : QWidget(parent), selecting(false), hasSelection(false), showingToolbar(false)
-    , showingResults(false), m_isFirstSelection(true)
+    , showingResults(false), m_awaitingText(false), m_awaitingOCR(false), m_isFirstSelection(true)
 {
     // Make fullscreen and frameless
     // On macOS, add BypassWindowManagerHint to cover the menu bar completely
@@ -43,6 +83,13 @@ ScreenshotWidget::ScreenshotWidget(QWidget *parent)
 
     // Initialize overlay manager
     m_overlayManager = new OverlayManager(this);
+    m_analyzer = new SpeculativeAnalyzer(this);
+    m_dwellTimer.setSingleShot(true);
+    m_dwellTimer.setInterval(DWELL_MS);
+    connect(&m_dwellTimer, &QTimer::timeout, this, &ScreenshotWidget::recogniseHeldSelection);
+    connect(m_analyzer, &SpeculativeAnalyzer::selectionRecognised, this, &ScreenshotWidget::finishPendingOCR);
+    m_textAcquisition = new TextAcquisition(this);
+    connect(m_textAcquisition, &TextAcquisition::acquired, this, &ScreenshotWidget::onTextAcquired);
     // Note: ESC is now handled by ScreenshotWidget::keyPressEvent to exit screenshot mode
     // Overlay ESC events will be ignored to keep screenshot mode active
 
@@ -53,13 +100,14 @@ ScreenshotWidget::ScreenshotWidget(QWidget *parent)
 
     // Connect to theme changes for runtime updates
     connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, [this]() {
+        m_background = QPixmap(); // OCR frames use the accent colour; rebuilt on the next paint
         update(); // Redraw the widget with new theme colors
     });
 }
 
-ScreenshotWidget::ScreenshotWidget(const QPixmap &screenshot, QWidget *parent)
+ScreenshotWidget::ScreenshotWidget(const QImage &frame, QScreen *screen, QWidget *parent)
     : QWidget(parent), selecting(false), hasSelection(false), showingToolbar(false)
-    , showingResults(false), m_isFirstSelection(true)
+    , showingResults(false), m_awaitingText(false), m_awaitingOCR(false), m_isFirstSelection(true)
 {
     // Make fullscreen and frameless
     // On macOS, add BypassWindowManagerHint to cover the menu bar completely
@@ -70,6 +118,32 @@ ScreenshotWidget::ScreenshotWidget(const QPixmap &screenshot, QWidget *parent)
     #endif
     setAttribute(Qt::WA_TranslucentBackground);
 
+    // Initialize overlay manager
+    m_overlayManager = new OverlayManager(this);
+    m_analyzer = new SpeculativeAnalyzer(this);
+    m_dwellTimer.setSingleShot(true);
+    m_dwellTimer.setInterval(DWELL_MS);
+    connect(&m_dwellTimer, &QTimer::timeout, this, &ScreenshotWidget::recogniseHeldSelection);
+    connect(m_analyzer, &SpeculativeAnalyzer::selectionRecognised, this, &ScreenshotWidget::finishPendingOCR);
+    m_textAcquisition = new TextAcquisition(this);
+    connect(m_textAcquisition, &TextAcquisition::acquired, this, &ScreenshotWidget::onTextAcquired);
+    // Note: ESC is now handled by ScreenshotWidget::keyPressEvent to exit screenshot mode
+    // Overlay ESC events will be ignored to keep screenshot mode active
+
+    // Connect to theme changes for runtime updates
+    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, [this]() {
+        m_background = QPixmap(); // OCR frames use the accent colour; rebuilt on the next paint
+        update(); // Redraw the widget with new theme colors
+    });
+
+    // Without a frame the overlay stays hidden until begin() (pre-warmed by CaptureSession)
+    if (!frame.isNull()) {
+        begin(frame, screen);
+    }
+}
+
+void ScreenshotWidget::begin(const QImage &frame, QScreen *screen)
+{
     // Ensure this widget uses the application's theme palette
     setPalette(QApplication::palette());
     qDebug() << "ScreenshotWidget palette set. Window color:" << palette().color(QPalette::Window).name();
@@ -78,21 +152,48 @@ ScreenshotWidget::ScreenshotWidget(const QPixmap &screenshot, QWidget *parent)
     QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
     m_dimmingOpacity = settings.value("screenshot/dimmingOpacity", 120).toInt();
 
-    // Initialize overlay manager
-    m_overlayManager = new OverlayManager(this);
-    // Note: ESC is now handled by ScreenshotWidget::keyPressEvent to exit screenshot mode
-    // Overlay ESC events will be ignored to keep screenshot mode active
-
-    // Use the provided screenshot
-    this->screenshot = screenshot;
-    qDebug() << "Screenshot widget initialized with image:" << screenshot.size();
+    // One frame for painting, OCR, copy and save; only the dimmed background is a pixmap
+    m_frame = frame;
+    m_screen = screen;
+    m_isFirstSelection = true;
+    rebuildBackground();
+    qDebug() << "Screenshot widget initialized with image:" << frame.size();
 
     setupWidget();
 
-    // Connect to theme changes for runtime updates
-    connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, [this]() {
-        update(); // Redraw the widget with new theme colors
-    });
+    // Lay the frame out (and read the text near the cursor) while the user is still selecting
+    m_analyzer->start(m_frame);
+    m_analyzer->setCursor(devicePoint(mapFromGlobal(QCursor::pos()), m_frame.devicePixelRatio()));
+    m_textAcquisition->begin();
+}
+
+void ScreenshotWidget::reset()
+{
+    // Back to the pre-warmed state: hidden, no selection, and the screenshot memory released
+    if (m_overlayManager) {
+        m_overlayManager->cancel();
+        m_overlayManager->hideAllOverlays();
+    }
+    m_analyzer->cancel();
+    m_textAcquisition->cancel();
+    m_dwellTimer.stop();
+    m_awaitingText = false;
+    m_awaitingOCR = false;
+    m_pendingOCRImage = QImage();
+    m_primaryCandidate.clear();
+    hide();
+    selecting = false;
+    hasSelection = false;
+    showingToolbar = false;
+    showingResults = false;
+    startPoint = QPoint();
+    endPoint = QPoint();
+    m_currentResult = OCRResult();
+    m_progressText.clear();
+    m_ocrSelections.clear();
+    m_frame = QImage();
+    m_background = QPixmap();
+    m_screen = nullptr;
 }
 
 void ScreenshotWidget::setupWidget()
@@ -101,20 +202,15 @@ void ScreenshotWidget::setupWidget()
     // Use showMaximized() or manual geometry setting instead of showFullScreen()
     // to avoid macOS creating a new desktop/space
     
+    // One overlay per monitor: it covers exactly the screen its screenshot came from
+    QScreen *targetScreen = m_screen ? m_screen.data() : QApplication::primaryScreen();
+
 #ifdef Q_OS_MACOS
-    // On macOS, manually set geometry to cover all screens and show normal
+    // On macOS, manually set geometry to cover the screen and show normal
     // This prevents the system from creating a new fullscreen space
-    QScreen *primaryScreen = QApplication::primaryScreen();
-    if (primaryScreen) {
-        QRect screenGeometry = primaryScreen->geometry();
-        
-        // If multiple screens, expand to cover all of them
-        const auto screens = QApplication::screens();
-        for (QScreen *screen : screens) {
-            screenGeometry = screenGeometry.united(screen->geometry());
-        }
-        
-        setGeometry(screenGeometry);
+    if (targetScreen) {
+        setScreen(targetScreen);
+        setGeometry(targetScreen->geometry());
         show();
         raise();
         activateWindow();
@@ -122,7 +218,11 @@ void ScreenshotWidget::setupWidget()
         show();
     }
 #else
-    // On other platforms, showFullScreen() works fine
+    // On other platforms, showFullScreen() works fine once the window sits on the right screen
+    if (targetScreen) {
+        setScreen(targetScreen);
+        setGeometry(targetScreen->geometry());
+    }
     showFullScreen();
 #endif
 
@@ -147,8 +247,9 @@ void ScreenshotWidget::captureScreen()
     qDebug() << "Capturing screen for backward compatibility...";
 
     // Use central ScreenCapture so Wayland/X11/Win/Mac paths are consistent
+    m_screen = ScreenCapture::screenUnderCursor();
     ScreenCapture capture;
-    QPixmap captured = capture.captureScreen();
+    const QImage captured = capture.captureScreen(m_screen);
 
     if (captured.isNull()) {
         qCritical() << "All screenshot methods failed!";
@@ -157,70 +258,46 @@ void ScreenshotWidget::captureScreen()
     }
 
     // Keep DPR tagging for correct on-screen mapping during selection
-    screenshot = captured;
-    qDebug() << "Screenshot captured successfully:" << screenshot.size() << " DPR:" << screenshot.devicePixelRatio();
+    m_frame = captured;
+    rebuildBackground();
+    m_analyzer->start(m_frame);
+    qDebug() << "Screenshot captured successfully:" << m_frame.size() << " DPR:" << m_frame.devicePixelRatio();
 
-    // Match widget size to logical size (QPixmap::size is already logical when DPR>1)
-    resize(screenshot.size());
+    // Match widget size to logical size
+    resize(m_frame.deviceIndependentSize().toSize());
 }
 
 void ScreenshotWidget::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
-
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
 
-    if (screenshot.isNull()) {
+    if (m_frame.isNull()) {
         qWarning() << "Screenshot is null!";
         return;
     }
+    if (m_background.isNull()) {
+        rebuildBackground();
+    }
 
-    // Draw the screenshot
-    painter.drawPixmap(0, 0, screenshot);
+    // Only the dirty area is redrawn; the pre-dimmed background already holds the earlier OCR selections
+    const qreal dpr = m_frame.devicePixelRatio();
+    for (const QRect &dirty : event->region()) {
+        painter.drawPixmap(dirty, m_background, devicePixels(dirty, dpr));
+    }
+    painter.setRenderHint(QPainter::Antialiasing);
 
-    // Draw darkened overlay
     QRect currentSelection = QRect(startPoint, endPoint).normalized();
     bool hasCurrentSelection = (hasSelection || selecting) && currentSelection.width() > 0 && currentSelection.height() > 0;
-    
-    // Draw dark overlay everywhere except selections (use configurable opacity)
-    painter.fillRect(rect(), QColor(0, 0, 0, m_dimmingOpacity));
 
     QPalette themePalette = ThemeManager::instance().getCurrentPalette();
     QColor accentColor = themePalette.color(QPalette::Highlight);
-    
-    // Draw all previous OCR selections (keep them visible with frames)
-    for (const QRect &ocrRect : m_ocrSelections) {
-        // Show the original screenshot in this area
-        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-        painter.fillRect(ocrRect, Qt::transparent);
-        qreal dpr = screenshot.devicePixelRatio();
-        QRect srcRect(
-            QPoint(static_cast<int>(ocrRect.x() * dpr), static_cast<int>(ocrRect.y() * dpr)),
-            QSize(static_cast<int>(ocrRect.width() * dpr), static_cast<int>(ocrRect.height() * dpr))
-        );
-        painter.drawPixmap(ocrRect, screenshot, srcRect);
-        
-        // Draw frame for OCR'd area (slightly dimmed to differentiate from current selection)
-        QPen ocrPen(accentColor.lighter(130), 2, Qt::DashLine);
-        painter.setPen(ocrPen);
-        painter.setBrush(Qt::NoBrush);
-        painter.drawRect(ocrRect);
-    }
-    
+
     // If we have a current selection, draw it with full highlight
     if (hasCurrentSelection) {
-        // Clear the selection area to show original screenshot
-        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-        painter.fillRect(currentSelection, Qt::transparent);
-        // Map logical selection to pixmap device pixels for the source rect
-        {
-            qreal dpr = screenshot.devicePixelRatio();
-            QRect srcRect(
-                QPoint(static_cast<int>(currentSelection.x() * dpr), static_cast<int>(currentSelection.y() * dpr)),
-                QSize(static_cast<int>(currentSelection.width() * dpr), static_cast<int>(currentSelection.height() * dpr))
-            );
-            painter.drawPixmap(currentSelection, screenshot, srcRect);
+        // Undimmed screenshot inside the selection, blitted only where it needs repainting
+        const QRect visible = currentSelection.intersected(event->rect());
+        if (!visible.isEmpty()) {
+            painter.drawImage(visible, m_frame, devicePixels(visible, dpr));
         }
 
         // Draw modern selection border with theme accent color
@@ -229,42 +306,22 @@ void ScreenshotWidget::paintEvent(QPaintEvent *event)
         painter.drawRect(currentSelection);
 
         // Draw corner handles for visual feedback
-        int handleSize = 8;
         QBrush handleBrush(accentColor);
         painter.setBrush(handleBrush);
         painter.setPen(Qt::NoPen);
 
         // Draw corner handles
-        painter.drawEllipse(currentSelection.topLeft() - QPoint(handleSize/2, handleSize/2), handleSize, handleSize);
-        painter.drawEllipse(currentSelection.topRight() - QPoint(handleSize/2, handleSize/2), handleSize, handleSize);
-        painter.drawEllipse(currentSelection.bottomLeft() - QPoint(handleSize/2, handleSize/2), handleSize, handleSize);
-        painter.drawEllipse(currentSelection.bottomRight() - QPoint(handleSize/2, handleSize/2), handleSize, handleSize);
+        const QPoint handleOffset(HANDLE_SIZE / 2, HANDLE_SIZE / 2);
+        painter.drawEllipse(currentSelection.topLeft() - handleOffset, HANDLE_SIZE, HANDLE_SIZE);
+        painter.drawEllipse(currentSelection.topRight() - handleOffset, HANDLE_SIZE, HANDLE_SIZE);
+        painter.drawEllipse(currentSelection.bottomLeft() - handleOffset, HANDLE_SIZE, HANDLE_SIZE);
+        painter.drawEllipse(currentSelection.bottomRight() - handleOffset, HANDLE_SIZE, HANDLE_SIZE);
 
         // Show dimensions with modern styling - but only during selection, not when showing results
-        if (currentSelection.width() > 30 && currentSelection.height() > 20 && !showingResults) {
-            qreal dpr = screenshot.devicePixelRatio();
-            int physW = static_cast<int>(currentSelection.width() * dpr);
-            int physH = static_cast<int>(currentSelection.height() * dpr);
-            QString dimensions = QString("%1 × %2 px").arg(physW).arg(physH);
-            QFont font = painter.font();
-            font.setPointSize(11);
-            font.setWeight(QFont::Bold);
-            painter.setFont(font);
-
-            QFontMetrics fm(font);
-            QRect textRect = fm.boundingRect(dimensions);
-
-            // Position above selection if space, otherwise below
-            QPoint textPos;
-            if (currentSelection.top() > textRect.height() + 10) {
-                textPos = QPoint(currentSelection.left() + (currentSelection.width() - textRect.width()) / 2,
-                               currentSelection.top() - 8);
-            } else {
-                textPos = QPoint(currentSelection.left() + (currentSelection.width() - textRect.width()) / 2,
-                               currentSelection.bottom() + textRect.height() + 8);
-            }
-
-            textRect.moveTopLeft(textPos);
+        if (showsDimensions(currentSelection)) {
+            const QString dimensions = dimensionText(currentSelection);
+            const QRect textRect = dimensionLabelRect(currentSelection, dimensions);
+            painter.setFont(dimensionFont());
 
             // Draw background with rounded corners
             QPainterPath bgPath;
@@ -277,10 +334,10 @@ void ScreenshotWidget::paintEvent(QPaintEvent *event)
         }
     } else {
         // Draw full overlay when no selection (use configurable opacity)
-        painter.fillRect(rect(), QColor(0, 0, 0, m_dimmingOpacity));
+        painter.fillRect(event->rect(), QColor(0, 0, 0, m_dimmingOpacity));
 
         // Show instruction text
-        QString instruction = "Click and drag to select area • Press ESC to cancel";
+        QString instruction = "Click and drag to select area • Shift+drag for live translation • Ctrl+drag to save with a hotkey • Press ESC to cancel";
         QFont font = painter.font();
         font.setPointSize(14);
         painter.setFont(font);
@@ -307,15 +364,91 @@ void ScreenshotWidget::paintEvent(QPaintEvent *event)
     // Results overlays are now handled by OverlayManager - no drawing needed here!
 }
 
+void ScreenshotWidget::rebuildBackground()
+{
+    m_background = QPixmap();
+    if (m_frame.isNull()) {
+        return;
+    }
+
+    // Screenshot, dimmed once, with every OCR'd area left bright and framed
+    m_background = QPixmap::fromImage(m_frame);
+    m_background.setDevicePixelRatio(m_frame.devicePixelRatio());
+    const qreal dpr = m_frame.devicePixelRatio();
+    const QRect logical(QPoint(0, 0), m_frame.deviceIndependentSize().toSize());
+
+    QPainter painter(&m_background);
+    painter.fillRect(logical, QColor(0, 0, 0, m_dimmingOpacity));
+
+    QPalette themePalette = ThemeManager::instance().getCurrentPalette();
+    QColor accentColor = themePalette.color(QPalette::Highlight);
+    painter.setRenderHint(QPainter::Antialiasing);
+    for (const QRect &ocrRect : std::as_const(m_ocrSelections)) {
+        painter.drawImage(ocrRect, m_frame, devicePixels(ocrRect, dpr));
+
+        // Draw frame for OCR'd area (slightly dimmed to differentiate from current selection)
+        QPen ocrPen(accentColor.lighter(130), 2, Qt::DashLine);
+        painter.setPen(ocrPen);
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(ocrRect);
+    }
+}
+
+bool ScreenshotWidget::showsDimensions(const QRect &selection) const
+{
+    return selection.width() > 30 && selection.height() > 20 && !showingResults;
+}
+
+QString ScreenshotWidget::dimensionText(const QRect &selection) const
+{
+    qreal dpr = m_frame.devicePixelRatio();
+    int physW = static_cast<int>(selection.width() * dpr);
+    int physH = static_cast<int>(selection.height() * dpr);
+    return QString("%1 × %2 px").arg(physW).arg(physH);
+}
+
+QFont ScreenshotWidget::dimensionFont() const
+{
+    QFont dimensionFont = font();
+    dimensionFont.setPointSize(11);
+    dimensionFont.setWeight(QFont::Bold);
+    return dimensionFont;
+}
+
+QRect ScreenshotWidget::dimensionLabelRect(const QRect &selection, const QString &text) const
+{
+    QRect textRect = QFontMetrics(dimensionFont()).boundingRect(text);
+
+    // Position above selection if space, otherwise below
+    QPoint textPos;
+    if (selection.top() > textRect.height() + 10) {
+        textPos = QPoint(selection.left() + (selection.width() - textRect.width()) / 2,
+                         selection.top() - 8);
+    } else {
+        textPos = QPoint(selection.left() + (selection.width() - textRect.width()) / 2,
+                         selection.bottom() + textRect.height() + 8);
+    }
+    textRect.moveTopLeft(textPos);
+    return textRect;
+}
+
+QRegion ScreenshotWidget::selectionPaintRegion(const QRect &selection) const
+{
+    // Border, corner handles (drawn around each corner) and the size label
+    const int margin = HANDLE_SIZE + HANDLE_SIZE / 2 + 2;
+    QRegion region(selection.adjusted(-margin, -margin, margin, margin));
+    if (showsDimensions(selection)) {
+        region += dimensionLabelRect(selection, dimensionText(selection)).adjusted(-10, -6, 10, 6);
+    }
+    return region;
+}
+
 void ScreenshotWidget::drawToolbar(QPainter &painter)
 {
     QRect selection = QRect(startPoint, endPoint).normalized();
 
-    // Calculate toolbar position (same logic as before)
-    QScreen *screen = QApplication::primaryScreen();
-    if (!screen) return;
-
-    QRect screenGeometry = screen->geometry();
+    // Calculate toolbar position in widget coordinates (the widget covers exactly one screen)
+    QRect screenGeometry = rect();
     const int margin = 8;
     const int buttonSize = 38;
     const int spacing = 4;
@@ -441,8 +574,18 @@ void ScreenshotWidget::mousePressEvent(QMouseEvent *event)
 void ScreenshotWidget::mouseMoveEvent(QMouseEvent *event)
 {
     if (selecting) {
+        // Only the old and the new selection need repainting, not the whole screen - except on the
+        // first move, when the darker no-selection overlay and its instructions go away
+        const QRect previous = QRect(startPoint, endPoint).normalized();
         endPoint = event->pos();
-        update();
+        if (previous.width() > 0 && previous.height() > 0) {
+            update(selectionPaintRegion(previous) + selectionPaintRegion(QRect(startPoint, endPoint).normalized()));
+        } else {
+            update();
+        }
+
+        // Each move restarts the dwell; the selection is read once the drag rests
+        m_dwellTimer.start();
 
         // Change cursor to indicate active selection
         setCursor(Qt::CrossCursor);
@@ -450,6 +593,9 @@ void ScreenshotWidget::mouseMoveEvent(QMouseEvent *event)
         // Show crosshair when hovering
         setCursor(Qt::CrossCursor);
     }
+
+    // Text nearest the pointer is read first
+    m_analyzer->setCursor(devicePoint(event->pos(), m_frame.devicePixelRatio()));
 }
 
 void ScreenshotWidget::mouseReleaseEvent(QMouseEvent *event)
@@ -457,15 +603,36 @@ void ScreenshotWidget::mouseReleaseEvent(QMouseEvent *event)
     if (event->button() == Qt::LeftButton && selecting) {
         selecting = false;
         hasSelection = true;
+        m_dwellTimer.stop();
 
         QRect selection = QRect(startPoint, endPoint).normalized();
         std::cout << "*** Mouse released, selection: " << selection.x() << "," << selection.y()
                   << " " << selection.width() << "x" << selection.height() << std::endl;
 
+        if (selection.width() <= 10 || selection.height() <= 10) {
+            // A click on text selects the whole block it belongs to
+            const qreal dpr = m_frame.devicePixelRatio();
+            const QRect block = m_analyzer->blockAt(devicePoint(event->pos(), dpr));
+            if (!block.isEmpty()) {
+                selection = logicalRect(block, dpr);
+                startPoint = selection.topLeft();
+                endPoint = selection.bottomRight();
+                qDebug() << "Click snapped to text block" << selection;
+            }
+        }
+
         if (selection.width() > 10 && selection.height() > 10) {
-            // Always start OCR automatically - no manual mode needed
-            qDebug() << "Starting OCR automatically on selection";
-            handleOCR();
+            if (event->modifiers() & Qt::ShiftModifier) {
+                // Shift+drag pins the region for live translation instead of a one-off OCR
+                handleLiveRegion();
+            } else if (event->modifiers() & Qt::ControlModifier) {
+                // Ctrl+drag saves the region under a hotkey that re-reads it without this overlay
+                handleSaveRegion();
+            } else {
+                // Always start OCR automatically - no manual mode needed
+                qDebug() << "Starting OCR automatically on selection";
+                handleOCR();
+            }
         } else {
             std::cout << "*** Selection too small, ignoring and staying active" << std::endl;
             // Reset selection state and keep the overlay active
@@ -499,7 +666,15 @@ void ScreenshotWidget::keyPressEvent(QKeyEvent *event)
             OCRResult lastResult = m_overlayManager->getLastOCRResult();
             if (lastResult.success && !lastResult.text.isEmpty()) {
                 QClipboard *clipboard = QApplication::clipboard();
-                clipboard->setText(lastResult.text);
+                if (!lastResult.table.isEmpty()) {
+                    // Tables: TSV as plain text (pastes into spreadsheet cells) plus text/csv
+                    QMimeData *mimeData = new QMimeData();
+                    mimeData->setText(TableRecognizer::toTsv(lastResult.table));
+                    mimeData->setData("text/csv", TableRecognizer::toCsv(lastResult.table).toUtf8());
+                    clipboard->setMimeData(mimeData);
+                } else {
+                    clipboard->setText(lastResult.text);
+                }
                 
                 qDebug() << "Ctrl+C: Copied original OCR text to clipboard";
                 
@@ -552,15 +727,15 @@ void ScreenshotWidget::handleToolbarClick(ToolbarButton button)
 void ScreenshotWidget::handleCopy()
 {
     QRect selection = QRect(startPoint, endPoint).normalized();
-    QPixmap selectedArea = screenshot.copy(QRect(
-        QPoint(static_cast<int>(selection.x() * screenshot.devicePixelRatio()),
-               static_cast<int>(selection.y() * screenshot.devicePixelRatio())),
-        QSize(static_cast<int>(selection.width() * screenshot.devicePixelRatio()),
-              static_cast<int>(selection.height() * screenshot.devicePixelRatio()))
+    const QImage selectedArea = m_frame.copy(QRect(
+        QPoint(static_cast<int>(selection.x() * m_frame.devicePixelRatio()),
+               static_cast<int>(selection.y() * m_frame.devicePixelRatio())),
+        QSize(static_cast<int>(selection.width() * m_frame.devicePixelRatio()),
+              static_cast<int>(selection.height() * m_frame.devicePixelRatio()))
     ));
 
     QClipboard *clipboard = QApplication::clipboard();
-    clipboard->setPixmap(selectedArea);
+    clipboard->setImage(selectedArea);
 
     qDebug() << "Copied selection to clipboard";
     emit screenshotFinished();
@@ -570,11 +745,11 @@ void ScreenshotWidget::handleCopy()
 void ScreenshotWidget::handleSave()
 {
     QRect selection = QRect(startPoint, endPoint).normalized();
-    QPixmap selectedArea = screenshot.copy(QRect(
-        QPoint(static_cast<int>(selection.x() * screenshot.devicePixelRatio()),
-               static_cast<int>(selection.y() * screenshot.devicePixelRatio())),
-        QSize(static_cast<int>(selection.width() * screenshot.devicePixelRatio()),
-              static_cast<int>(selection.height() * screenshot.devicePixelRatio()))
+    const QImage selectedArea = m_frame.copy(QRect(
+        QPoint(static_cast<int>(selection.x() * m_frame.devicePixelRatio()),
+               static_cast<int>(selection.y() * m_frame.devicePixelRatio())),
+        QSize(static_cast<int>(selection.width() * m_frame.devicePixelRatio()),
+              static_cast<int>(selection.height() * m_frame.devicePixelRatio()))
     ));
 
     QString fileName = QFileDialog::getSaveFileName(this, "Save Screenshot",
@@ -626,13 +801,14 @@ void ScreenshotWidget::handleOCR()
     
     // Calculate physical coordinates
     QRect physicalRect(
-        static_cast<int>(selection.x() * screenshot.devicePixelRatio()),
-        static_cast<int>(selection.y() * screenshot.devicePixelRatio()),
-        static_cast<int>(selection.width() * screenshot.devicePixelRatio()),
-        static_cast<int>(selection.height() * screenshot.devicePixelRatio())
+        static_cast<int>(selection.x() * m_frame.devicePixelRatio()),
+        static_cast<int>(selection.y() * m_frame.devicePixelRatio()),
+        static_cast<int>(selection.width() * m_frame.devicePixelRatio()),
+        static_cast<int>(selection.height() * m_frame.devicePixelRatio())
     );
     
-    QPixmap selectedArea = screenshot.copy(physicalRect);
+    // A view into the frame: OCR reads the selection in place, nothing is copied here
+    const QImage selectedArea = ImageFrame::view(m_frame, physicalRect);
 
     if (selectedArea.isNull() || selectedArea.size().isEmpty()) {
         QMessageBox::warning(this, "OCR Error", "Please select a valid area for OCR processing.");
@@ -644,14 +820,46 @@ void ScreenshotWidget::handleOCR()
     showingResults = true;
     m_currentResult = OCRResult(); // Reset result
 
-    // Store the selected area for potential retry
-    m_lastOCRImage = selectedArea;
-
     // Store this selection in the list of OCR'd areas to keep it visible
     m_ocrSelections.append(selection);
-    
-    // Delegate all OCR processing to OverlayManager, pass full screenshot and existing selections
-    m_overlayManager->performOCR(selectedArea, selection, screenshot, m_ocrSelections);
+    if (m_ocrSelections.size() > MAX_OCR_SELECTIONS) {
+        m_ocrSelections.removeFirst();
+    }
+    rebuildBackground();
+
+    // Text read while the user was selecting comes back at once; either way the speculation
+    // stops here so this OCR has the workers to itself
+    const QRect frameRect = physicalRect.intersected(m_frame.rect());
+    OCRResult recognised;
+    const bool ready = m_analyzer->takeResult(frameRect, &recognised);
+    m_analyzer->settle(frameRect);
+    m_textAcquisition->cancel();
+    m_awaitingText = false;
+    m_awaitingOCR = false;
+    m_pendingOCRImage = QImage();
+    m_primaryCandidate.clear();
+
+    if (!ready && (TextAcquisition::isSupported() || m_analyzer->isRecognising(frameRect))) {
+        // Show the preview now; the result is real text, the early read, or OCR, in that order
+        m_overlayManager->prepareOCR(selection, m_ocrSelections);
+        m_pendingOCRImage = selectedArea;
+        m_pendingOCRRect = frameRect;
+        if (TextAcquisition::isSupported()) {
+            // AT-SPI needs desktop coordinates, known only when logical and native pixels agree
+            QRect nativeRect;
+            const qreal dpr = m_frame.devicePixelRatio();
+            if (m_screen && (qFuzzyCompare(dpr, 1.0) || QGuiApplication::screens().size() == 1)) {
+                nativeRect = frameRect.translated(devicePoint(m_screen->geometry().topLeft(), dpr));
+            }
+            m_awaitingText = true;
+            m_textAcquisition->request(nativeRect, m_analyzer->linesIn(frameRect));
+        } else {
+            recognisePendingSelection();
+        }
+    } else {
+        // Delegate all OCR processing to OverlayManager, pass full screenshot and existing selections
+        m_overlayManager->performOCR(selectedArea, selection, m_ocrSelections, recognised);
+    }
     
     // Reset selection state so user can make a new selection
     hasSelection = false;
@@ -662,6 +870,111 @@ void ScreenshotWidget::handleOCR()
     update();
 }
 
+qint64 ScreenshotWidget::memoryUse() const
+{
+    // Views (pending OCR, the analyzer's frame) share m_frame's pixels and aren't counted again
+    return m_frame.sizeInBytes() + pixmapBytes(m_background) + m_analyzer->memoryUse();
+}
+
+void ScreenshotWidget::recogniseHeldSelection()
+{
+    const QRect selection = QRect(startPoint, endPoint).normalized();
+    if (!selecting || selection.width() <= 10 || selection.height() <= 10) {
+        return;
+    }
+    // Same device rect handleOCR would read on release
+    m_analyzer->recogniseSelection(devicePixels(selection, m_frame.devicePixelRatio()).intersected(m_frame.rect()));
+}
+
+void ScreenshotWidget::finishPendingOCR()
+{
+    if (!m_awaitingOCR) {
+        return;
+    }
+    m_awaitingOCR = false;
+    const QImage image = m_pendingOCRImage;
+    m_pendingOCRImage = QImage();
+
+    // A failed read leaves recognised empty and the OCR runs as usual
+    OCRResult recognised;
+    m_analyzer->takeResult(m_pendingOCRRect, &recognised);
+    m_overlayManager->finishOCR(image, recognised, std::exchange(m_primaryCandidate, QString()));
+}
+
+void ScreenshotWidget::onTextAcquired(const QString &text, const QString &primary)
+{
+    if (!m_awaitingText) {
+        return;
+    }
+    m_awaitingText = false;
+    if (text.isEmpty()) {
+        // PRIMARY can't be placed on screen: it rides along and the OCR decides
+        m_primaryCandidate = primary;
+        recognisePendingSelection();
+        return;
+    }
+
+    // The application's own characters: no OCR, straight on to translation
+    OCRResult result;
+    result.text = text;
+    result.success = true;
+    const QImage image = m_pendingOCRImage;
+    m_pendingOCRImage = QImage();
+    m_overlayManager->finishOCR(image, result);
+}
+
+void ScreenshotWidget::recognisePendingSelection()
+{
+    OCRResult recognised;
+    if (!m_analyzer->takeResult(m_pendingOCRRect, &recognised) && m_analyzer->isRecognising(m_pendingOCRRect)) {
+        // The drag rested here and its OCR is nearly done: finish on its result
+        m_awaitingOCR = true;
+        return;
+    }
+    const QImage image = m_pendingOCRImage;
+    m_pendingOCRImage = QImage();
+    m_overlayManager->finishOCR(image, recognised, std::exchange(m_primaryCandidate, QString()));
+}
+
+void ScreenshotWidget::handleLiveRegion()
+{
+    // Selection is in widget coordinates, and the widget covers exactly its screen
+    QRect selection = QRect(startPoint, endPoint).normalized();
+    QScreen *target = m_screen ? m_screen.data() : screen();
+    m_analyzer->cancel();
+    m_dwellTimer.stop();
+    qDebug() << "Starting live translation for" << selection << "on" << (target ? target->name() : QString());
+
+    // The region is first captured one interval from now, after this overlay has closed
+    LiveRegionTranslator::start(target, selection);
+
+    if (m_overlayManager) {
+        m_overlayManager->hideAllOverlays();
+    }
+    emit screenshotFinished();
+    close();
+}
+
+void ScreenshotWidget::handleSaveRegion()
+{
+    // Selection is in widget coordinates, and the widget covers exactly its screen
+    QRect selection = QRect(startPoint, endPoint).normalized();
+    QScreen *target = m_screen ? m_screen.data() : screen();
+    m_analyzer->cancel();
+    m_dwellTimer.stop();
+
+    // The first read calibrates on the pixels already captured, so it needs no second grab
+    const QRect physicalRect = devicePixels(selection, m_frame.devicePixelRatio()).intersected(m_frame.rect());
+    const QString shortcut = SavedRegionReader::save(target, selection, m_frame.copy(physicalRect));
+    qDebug() << "Saved region" << selection << "as" << shortcut;
+
+    if (m_overlayManager) {
+        m_overlayManager->hideAllOverlays();
+    }
+    emit screenshotFinished();
+    close();
+}
+
 void ScreenshotWidget::handleCancel()
 {
     emit screenshotFinished();
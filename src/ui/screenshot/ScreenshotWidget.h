@@ -1,16 +1,23 @@
 #pragma once
 
 #include <QWidget>
+#include <QImage>
 #include <QPixmap>
 #include <QPoint>
 #include <QRect>
+#include <QRegion>
 #include <QPainter>
 #include <QMouseEvent>
 #include <QKeyEvent>
+#include <QPointer>
+#include <QScreen>
+#include <QTimer>
 
 #include "OCREngine.h"
 #include "ScreenCapture.h"
 #include "../overlays/OverlayManager.h"
+#include "SpeculativeAnalyzer.h"
+#include "TextAcquisition.h"
 
 
 enum class ToolbarButton {
@@ -30,9 +37,20 @@ signals:
 
 public:
     ScreenshotWidget(QWidget *parent = nullptr);
-    ScreenshotWidget(const QPixmap &screenshot, QWidget *parent = nullptr);
+    // screen: the monitor this overlay covers (its own DPR); nullptr keeps the legacy primary-screen layout.
+    // A null frame builds the overlay (OCR engine, result overlay) hidden, for begin() later
+    ScreenshotWidget(const QImage &frame, QScreen *screen = nullptr, QWidget *parent = nullptr);
     ~ScreenshotWidget();
 
+    // Shows the overlay over screen with a freshly captured frame (ScreenCapture::captureScreen)
+    void begin(const QImage &frame, QScreen *screen);
+
+    // Hides the overlay and clears selections and results so it can be begun again
+    void reset();
+
+    // Bytes this overlay holds for its session: frame, dimmed background, layout and results
+    qint64 memoryUse() const;
+
 protected:
     void paintEvent(QPaintEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
@@ -44,17 +62,33 @@ private slots:
     void handleCopy();
     void handleSave();
     void handleOCR();
+    void handleLiveRegion();
+    void handleSaveRegion();
     void handleCancel();
+    void recogniseHeldSelection();
+    void finishPendingOCR();
+    void onTextAcquired(const QString &text, const QString &primary);
 
 private:
     void captureScreen();
     void setupWidget();
     void drawToolbar(QPainter &painter);
+    void rebuildBackground();
+    bool showsDimensions(const QRect &selection) const;
+    QString dimensionText(const QRect &selection) const;
+    QFont dimensionFont() const;
+    QRect dimensionLabelRect(const QRect &selection, const QString &text) const;
+    // Everything a selection paints: border, handles and size label
+    QRegion selectionPaintRegion(const QRect &selection) const;
+    // The pending selection had no real text: OCR it (or wait for its early read)
+    void recognisePendingSelection();
     QRect getToolbarRect();
     ToolbarButton getButtonAt(QPoint pos);
     void handleToolbarClick(ToolbarButton button);
 
-    QPixmap screenshot;
+    QImage m_frame;         // Captured frame; painting, OCR, copy and save all read it in place
+    QPixmap m_background;   // m_frame, dimmed, with earlier OCR selections; painted from on every update
+    QPointer<QScreen> m_screen;
     QPoint startPoint;
     QPoint endPoint;
     bool selecting;
@@ -66,16 +100,22 @@ private:
     QRect ocrButtonRect;
     QRect cancelButtonRect;
 
-    QPixmap m_lastOCRImage;
-
     // Results overlay - now managed by OverlayManager
     bool showingResults;
     OCRResult m_currentResult;
     QString m_progressText;
     QRect m_resultAreaRect;
     OverlayManager *m_overlayManager;
+    SpeculativeAnalyzer *m_analyzer;   // Text layout and OCR of the frame while the user selects
+    QTimer m_dwellTimer;               // Fires when a drag has rested; its selection is read early
+    TextAcquisition *m_textAcquisition; // Real text (AT-SPI) that makes OCR unnecessary; PRIMARY for OCR to confirm
+    bool m_awaitingText;               // Released; asking for the selection's real text first
+    bool m_awaitingOCR;                // Released on a selection still being read early
+    QImage m_pendingOCRImage;
+    QRect m_pendingOCRRect;            // m_pendingOCRImage's place in m_frame
+    QString m_primaryCandidate;        // PRIMARY text the pending OCR has to confirm
     
-    // Track all OCR selections to keep them visible
+    // Track the latest OCR selections to keep them visible
     QList<QRect> m_ocrSelections;
     
     // Dimming opacity (loaded from settings)
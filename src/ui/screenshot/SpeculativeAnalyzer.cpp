@@ -0,0 +1,393 @@
+#include "SpeculativeAnalyzer.h"
+#include "ImageFrame.h"
+#include "../core/AppSettings.h"
+#include "../../ocr/engines/tesseract/TesseractEngine.h"
+#include "../../ocr/table/TableRecognizer.h"
+#include <QThread>
+#include <QDebug>
+#include <limits>
+
+namespace {
+
+constexpr int BLOCK_PADDING = 6;                       // Quiet margin recognised around a block
+constexpr int MAX_SPECULATIVE_BLOCKS = 6;              // Recognitions ahead of time per screenshot
+constexpr qint64 MAX_SPECULATIVE_PIXELS = 1500 * 1000; // Bigger blocks would hold a worker too long
+
+// Squared distance from point to rect, 0 inside
+qint64 distanceSquared(const QPoint &point, const QRect &rect)
+{
+    const qint64 dx = point.x() < rect.left() ? rect.left() - point.x()
+                    : point.x() > rect.right() ? point.x() - rect.right() : 0;
+    const qint64 dy = point.y() < rect.top() ? rect.top() - point.y()
+                    : point.y() > rect.bottom() ? point.y() - rect.bottom() : 0;
+    return dx * dx + dy * dy;
+}
+
+// What OCREngine::performTesseractOCR would produce for image
+OCRResult recognise(const QImage &image, const AppSettings::OCRConfig &config, const std::atomic_bool *cancelled)
+{
+    if (config.tableMode) {
+        const OCRResult table = TableRecognizer::recognize(image, config.language, config.qualityLevel,
+                                                           config.preprocessing, config.autoDetectOrientation,
+                                                           cancelled);
+        if (table.success) {
+            return table;
+        }
+    }
+    return TesseractEngine::performOCR(image, config.language, config.qualityLevel,
+                                       config.preprocessing, config.autoDetectOrientation, 0, cancelled);
+}
+
+} // namespace
+
+SpeculativeAnalyzer::SpeculativeAnalyzer(QObject *parent)
+    : QObject(parent)
+    , m_cancelled(std::make_shared<std::atomic_bool>(false))
+    , m_selectionCancelled(std::make_shared<std::atomic_bool>(false))
+{
+    // One thread each: this only fills time the user spends selecting
+    m_pool.setMaxThreadCount(1);
+    m_selectionPool.setMaxThreadCount(1);
+}
+
+SpeculativeAnalyzer::~SpeculativeAnalyzer()
+{
+    // Jobs post back to this object; let the running ones drain before it goes away
+    cancel();
+    m_pool.waitForDone();
+    m_selectionPool.waitForDone();
+}
+
+void SpeculativeAnalyzer::start(const QImage &frame)
+{
+    cancel();
+    if (frame.isNull()) {
+        return;
+    }
+    m_frame = frame;
+
+    // Only what OverlayManager would run itself can be recognised ahead of time
+    m_speculate = AppSettings::instance().getOCRConfig().engine != "AppleVision";
+
+    const int generation = m_generation;
+    const std::shared_ptr<std::atomic_bool> cancelled = m_cancelled;
+    m_pool.start([this, frame, generation, cancelled]() {
+        QThread::currentThread()->setPriority(QThread::LowestPriority);
+        const QVector<TextLayout::Block> blocks = TextLayout::analyse(frame, cancelled.get());
+        if (cancelled->load()) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this, generation, blocks]() {
+            onAnalysed(generation, blocks);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void SpeculativeAnalyzer::settle(const QRect &rect)
+{
+    m_settled = true;
+    m_pool.clear();
+
+    // A held selection still being read keeps going only if it is what was released;
+    // otherwise its worker is freed for the real OCR
+    if (!m_selection.rect.isEmpty() && !m_selection.done && !isRecognising(rect)) {
+        qDebug() << "SpeculativeAnalyzer: Abandoning held selection" << m_selection.rect << "for" << rect;
+        abandonSelection();
+    }
+}
+
+void SpeculativeAnalyzer::cancel()
+{
+    // Running jobs see their own flag; anything they post back carries a stale generation
+    m_cancelled->store(true);
+    m_cancelled = std::make_shared<std::atomic_bool>(false);
+    ++m_generation;
+    m_pool.clear();
+    abandonSelection();
+
+    m_frame = QImage();
+    m_blocks.clear();
+    m_results.clear();
+    m_recognising = -1;
+    m_attempts = 0;
+    m_settled = false;
+}
+
+void SpeculativeAnalyzer::abandonSelection()
+{
+    // The job polls its own flag, so a superseded read stops without touching the block reads
+    m_selectionCancelled->store(true);
+    m_selectionCancelled = std::make_shared<std::atomic_bool>(false);
+    m_selectionPool.clear();
+    m_selection = Speculation();
+    ++m_selectionRequest;
+}
+
+void SpeculativeAnalyzer::setCursor(const QPoint &point)
+{
+    m_cursor = point;
+    recogniseNext();
+}
+
+void SpeculativeAnalyzer::recogniseSelection(const QRect &rect)
+{
+    const QRect area = rect.intersected(m_frame.rect());
+    if (!m_speculate || area.isEmpty() || area == m_selection.rect) {
+        return;
+    }
+    // Already read, or being read, under another rect with the same text
+    if (!m_selection.rect.isEmpty() && sameText(m_selection.rect, area)) {
+        return;
+    }
+
+    // Only the newest held selection matters; the previous one is dropped, queued or running
+    abandonSelection();
+    m_selection.rect = area;
+    const int request = m_selectionRequest;
+
+    const QImage image = ImageFrame::view(m_frame, area);
+    const AppSettings::OCRConfig config = AppSettings::instance().getOCRConfig();
+    const int generation = m_generation;
+    const std::shared_ptr<std::atomic_bool> cancelled = m_selectionCancelled;
+    m_selectionPool.start([this, generation, request, image, config, cancelled]() {
+        if (cancelled->load()) {
+            return;
+        }
+        const OCRResult result = recognise(image, config, cancelled.get());
+        QMetaObject::invokeMethod(this, [this, generation, request, result]() {
+            onSelectionRecognised(generation, request, result);
+        }, Qt::QueuedConnection);
+    });
+    qDebug() << "SpeculativeAnalyzer: Reading held selection" << area;
+}
+
+QRect SpeculativeAnalyzer::blockAt(const QPoint &point) const
+{
+    for (int i = 0; i < m_blocks.size(); ++i) {
+        const QRect block = paddedBlock(i);
+        if (block.contains(point)) {
+            return block;
+        }
+    }
+    return QRect();
+}
+
+QVector<QRect> SpeculativeAnalyzer::linesIn(const QRect &rect) const
+{
+    QVector<QRect> lines;
+    for (const TextLayout::Block &block : m_blocks) {
+        for (const QRect &line : block.lines) {
+            if (line.intersects(rect)) {
+                lines.append(line.intersected(rect));
+            }
+        }
+    }
+    return lines;
+}
+
+bool SpeculativeAnalyzer::takeResult(const QRect &rect, OCRResult *result) const
+{
+    // The held selection first: it is what the user meant most recently
+    QVector<const Speculation *> candidates { &m_selection };
+    for (const Speculation &speculation : m_results) {
+        candidates.append(&speculation);
+    }
+
+    for (const Speculation *speculation : std::as_const(candidates)) {
+        if (!finished(*speculation)) {
+            continue;
+        }
+        if (speculation->rect == rect || sameText(speculation->rect, rect)) {
+            *result = speculation->result;
+            const QPoint offset = speculation->rect.topLeft() - rect.topLeft();
+            for (OCRResult::OCRToken &token : result->tokens) {
+                token.box.translate(offset);
+            }
+            qDebug() << "SpeculativeAnalyzer: Selection" << rect << "was recognised ahead of time as" << speculation->rect;
+            return true;
+        }
+        if (speculation->rect.contains(rect) && cropResult(*speculation, rect, result)) {
+            qDebug() << "SpeculativeAnalyzer: Selection" << rect << "was recognised ahead of time inside" << speculation->rect;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SpeculativeAnalyzer::isRecognising(const QRect &rect) const
+{
+    // A rect inside the held selection may be cut out of its result once it is done
+    return !m_selection.rect.isEmpty() && !m_selection.done
+        && (m_selection.rect.contains(rect) || sameText(m_selection.rect, rect));
+}
+
+qint64 SpeculativeAnalyzer::memoryUse() const
+{
+    const auto resultBytes = [](const OCRResult &result) {
+        qint64 bytes = (result.text.size() + result.translatedText.size()) * qint64(sizeof(QChar));
+        for (const OCRResult::OCRToken &token : result.tokens) {
+            bytes += qint64(sizeof(token)) + token.text.size() * qint64(sizeof(QChar));
+        }
+        return bytes;
+    };
+
+    qint64 bytes = resultBytes(m_selection.result);
+    for (const TextLayout::Block &block : m_blocks) {
+        bytes += qint64(sizeof(block)) + block.lines.size() * qint64(sizeof(QRect));
+    }
+    for (const Speculation &speculation : m_results) {
+        bytes += resultBytes(speculation.result);
+    }
+    return bytes;
+}
+
+void SpeculativeAnalyzer::onAnalysed(int generation, const QVector<TextLayout::Block> &blocks)
+{
+    if (generation != m_generation) {
+        return;
+    }
+    m_blocks = blocks;
+    emit analysed();
+    recogniseNext();
+}
+
+void SpeculativeAnalyzer::recogniseNext()
+{
+    if (!m_speculate || m_settled || m_recognising >= 0 || m_attempts >= MAX_SPECULATIVE_BLOCKS) {
+        return;
+    }
+
+    // Nearest block to the cursor that isn't read yet
+    int next = -1;
+    qint64 nearest = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < m_blocks.size(); ++i) {
+        const QRect block = paddedBlock(i);
+        if (m_results.contains(i) || qint64(block.width()) * block.height() > MAX_SPECULATIVE_PIXELS) {
+            continue;
+        }
+        const qint64 distance = distanceSquared(m_cursor, block);
+        if (distance < nearest) {
+            nearest = distance;
+            next = i;
+        }
+    }
+    if (next < 0) {
+        return;
+    }
+
+    m_recognising = next;
+    ++m_attempts;
+    const QImage image = ImageFrame::view(m_frame, paddedBlock(next));
+    const AppSettings::OCRConfig config = AppSettings::instance().getOCRConfig();
+    const int generation = m_generation;
+    const std::shared_ptr<std::atomic_bool> cancelled = m_cancelled;
+    m_pool.start([this, generation, next, image, config, cancelled]() {
+        if (cancelled->load()) {
+            return;
+        }
+        const OCRResult result = recognise(image, config, cancelled.get());
+        QMetaObject::invokeMethod(this, [this, generation, next, result]() {
+            onRecognised(generation, next, result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void SpeculativeAnalyzer::onRecognised(int generation, int index, const OCRResult &result)
+{
+    if (generation != m_generation) {
+        return;
+    }
+    m_recognising = -1;
+    Speculation &speculation = m_results[index];
+    speculation.rect = paddedBlock(index);
+    speculation.done = true;
+    speculation.result = result;
+    recogniseNext();
+}
+
+void SpeculativeAnalyzer::onSelectionRecognised(int generation, int request, const OCRResult &result)
+{
+    if (generation != m_generation || request != m_selectionRequest) {
+        return;
+    }
+    m_selection.done = true;
+    m_selection.result = result;
+    emit selectionRecognised();
+}
+
+QRect SpeculativeAnalyzer::paddedBlock(int index) const
+{
+    return m_blocks[index].rect.adjusted(-BLOCK_PADDING, -BLOCK_PADDING, BLOCK_PADDING, BLOCK_PADDING)
+        .intersected(m_frame.rect());
+}
+
+bool SpeculativeAnalyzer::wholeLines(const QRect &rect, QVector<int> *lines) const
+{
+    int index = 0;
+    for (const TextLayout::Block &block : m_blocks) {
+        for (const QRect &line : block.lines) {
+            if (line.intersects(rect)) {
+                if (!rect.contains(line)) {
+                    return false;
+                }
+                lines->append(index);
+            }
+            ++index;
+        }
+    }
+    return true;
+}
+
+bool SpeculativeAnalyzer::sameText(const QRect &recognised, const QRect &rect) const
+{
+    // Rects holding the same whole lines differ only in blank margin
+    QVector<int> recognisedLines;
+    QVector<int> lines;
+    return wholeLines(recognised, &recognisedLines) && wholeLines(rect, &lines)
+        && !lines.isEmpty() && recognisedLines == lines;
+}
+
+bool SpeculativeAnalyzer::finished(const Speculation &speculation) const
+{
+    return speculation.done && speculation.result.success && !speculation.result.text.isEmpty();
+}
+
+bool SpeculativeAnalyzer::cropResult(const Speculation &speculation, const QRect &rect, OCRResult *result) const
+{
+    // A table grid or plain CLI text (no word boxes) can't be cut down to part of its rect
+    if (!speculation.result.table.isEmpty() || speculation.result.tokens.isEmpty()) {
+        return false;
+    }
+
+    const QRect local = rect.translated(-speculation.rect.topLeft());
+    QVector<OCRResult::OCRToken> tokens;
+    for (const OCRResult::OCRToken &token : speculation.result.tokens) {
+        if (local.contains(token.box)) {
+            tokens.append(token);
+        } else if (local.intersects(token.box)) {
+            return false;  // Half a word reads differently on its own
+        }
+    }
+    if (tokens.isEmpty()) {
+        return false;
+    }
+
+    // Words keep their recognised order; a new line id starts a new text line
+    *result = speculation.result;
+    result->tokens.clear();
+    QStringList lines;
+    int lineId = 0;
+    const QPoint offset = speculation.rect.topLeft() - rect.topLeft();
+    for (OCRResult::OCRToken token : std::as_const(tokens)) {
+        if (lines.isEmpty() || token.lineId != lineId) {
+            lines.append(token.text);
+            lineId = token.lineId;
+        } else {
+            lines.last() += ' ' + token.text;
+        }
+        token.box.translate(offset);
+        result->tokens.append(token);
+    }
+    result->text = lines.join('\n');
+    return true;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QPoint>
+#include <QRect>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include "OCREngine.h"
+#include "../../ocr/layout/TextLayout.h"
+
+/**
+ * Speculative text analysis of a screenshot while the user is still selecting
+ * As soon as an overlay opens, its frozen frame is laid out (TextLayout) on a
+ * single low-priority thread. Once the blocks are known, the ones nearest the
+ * cursor are recognised ahead of time, one at a time. While the user drags,
+ * a selection held still for a moment is recognised as well (on a thread of
+ * its own), so by the time the mouse is released its OCR is usually done.
+ * Recognition is the same Tesseract path OverlayManager would run (table
+ * mode included); nothing is speculated for Apple Vision.
+ *
+ * The overlay uses the layout to snap a click to the text block under it, and
+ * takes a finished recognition instead of running OCR when the released
+ * selection holds the same text: the held selection itself, or any rect with
+ * exactly the same whole lines, or every line of one recognised block. A
+ * selection inside a recognised rect gets the words it contains, provided it
+ * cuts through none of them.
+ * Blocks stop being read the moment a selection is made (settle) so the real
+ * OCR has the workers to itself, and a held selection that can't stand for it
+ * is abandoned. Everything is dropped when the overlay closes (cancel); OCR
+ * already running on a worker is abandoned too, in-process OCR finishes and
+ * is ignored.
+ *
+ * All rects and points are in the frame's device pixels. GUI thread only.
+ */
+class SpeculativeAnalyzer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SpeculativeAnalyzer(QObject *parent = nullptr);
+    ~SpeculativeAnalyzer();
+
+    // Starts over on frame; replaces any earlier analysis
+    void start(const QImage &frame);
+    // The selection rect is made: no more blocks are recognised ahead of time, but the layout and
+    // finished results stay for later selections on the same frame. The held selection's OCR
+    // is abandoned unless it would stand for rect
+    void settle(const QRect &rect);
+    // Drops the frame, layout and results
+    void cancel();
+
+    // Recognition ahead of time starts with the block nearest this point
+    void setCursor(const QPoint &point);
+
+    // The drag has rested on rect: read it now in case it is released there. Supersedes
+    // the previous held selection
+    void recogniseSelection(const QRect &rect);
+
+    // Block under point, padded the way it is recognised; empty if none (or not analysed yet)
+    QRect blockAt(const QPoint &point) const;
+    // Text lines rect touches, clipped to it; empty if none (or not analysed yet)
+    QVector<QRect> linesIn(const QRect &rect) const;
+
+    // A finished recognition that stands for OCR of rect, token boxes moved into rect
+    bool takeResult(const QRect &rect, OCRResult *result) const;
+
+    // The held selection's recognition would stand for rect but hasn't finished yet;
+    // selectionRecognised() follows
+    bool isRecognising(const QRect &rect) const;
+
+    // Bytes held besides the frame (which is shared with the overlay): layout and results
+    qint64 memoryUse() const;
+
+signals:
+    void analysed();
+    void selectionRecognised();
+
+private:
+    struct Speculation {
+        QRect rect;
+        bool done = false;
+        OCRResult result;
+    };
+
+    void onAnalysed(int generation, const QVector<TextLayout::Block> &blocks);
+    void recogniseNext();
+    void onRecognised(int generation, int index, const OCRResult &result);
+    void onSelectionRecognised(int generation, int request, const OCRResult &result);
+    QRect paddedBlock(int index) const;
+    // Indices (into all lines, block by block) of the lines rect touches; false if it cuts one
+    bool wholeLines(const QRect &rect, QVector<int> *lines) const;
+    bool sameText(const QRect &recognised, const QRect &rect) const;
+    bool finished(const Speculation &speculation) const;
+    // The words of speculation inside rect, as OCR of rect; false if rect cuts one or holds none
+    bool cropResult(const Speculation &speculation, const QRect &rect, OCRResult *result) const;
+    // Drops the held selection; its OCR on a worker is abandoned
+    void abandonSelection();
+
+    QThreadPool m_pool;
+    QThreadPool m_selectionPool;
+    std::shared_ptr<std::atomic_bool> m_cancelled;
+    int m_generation = 0;
+
+    QImage m_frame;
+    QVector<TextLayout::Block> m_blocks;
+    QHash<int, Speculation> m_results;  // Block index -> recognition of paddedBlock(index)
+    int m_recognising = -1;
+    int m_attempts = 0;
+    bool m_speculate = false;           // Settings allow recognising ahead of time
+    bool m_settled = false;             // A selection was made; blocks are no longer read
+    QPoint m_cursor;
+
+    Speculation m_selection;            // Latest held selection
+    int m_selectionRequest = 0;
+    std::shared_ptr<std::atomic_bool> m_selectionCancelled;  // Set to abandon m_selection's OCR
+};